@@ -0,0 +1,188 @@
+// CompareBaseline.mjs
+// Compares a benchmark report (Fixed64Benchmark or InteropBenchmark JSON)
+// against a checked-in baseline, prints a diff table and exits with 1 when a
+// case got slower than the threshold allows.
+//
+//   node benchmark/CompareBaseline.mjs --baseline <json> --current <json>[,<json>...]
+//        [--threshold <percent>] [--min-delta-ns <ns>] [--groups a,b]
+//        [--stat min|median|p90] [--update]
+//
+// A case regresses when its ns/op statistic (default min, the least noisy
+// one on a shared machine) grew by more than --threshold percent (default
+// 25) and by more than --min-delta-ns (default 0.5), which keeps
+// nanosecond-scale cases from failing on timer noise. Cases missing from the
+// baseline are listed as skipped and never fail the check. Several current
+// reports of the same build are compared by the fastest run of each case, so
+// a case has to be slow in every run to count as a regression.
+//
+// --update copies the current report over the baseline instead of comparing.
+// Given several Fixed64Benchmark reports, it keeps the slowest run of each
+// case, so a run that happened to get a quiet machine does not end up in the
+// baseline and fail every later check.
+import { copyFile, readFile, writeFile } from 'fs/promises';
+
+function parseOptions(argv) {
+    const options = { baseline: '', current: [], threshold: 25, minDeltaNs: 0.5, groups: null, stat: 'min', update: false };
+    for (let i = 0; i < argv.length; i++) {
+        const value = argv[i + 1];
+        switch (argv[i]) {
+            case '--baseline': options.baseline = value; i++; break;
+            case '--current': options.current = value.split(','); i++; break;
+            case '--threshold': options.threshold = parseFloat(value); i++; break;
+            case '--min-delta-ns': options.minDeltaNs = parseFloat(value); i++; break;
+            case '--groups': options.groups = new Set(value.split(',')); i++; break;
+            case '--stat': options.stat = value; i++; break;
+            case '--update': options.update = true; break;
+            default:
+                console.error(`unknown option ${argv[i]}`);
+                process.exit(2);
+        }
+    }
+    if (!['min', 'median', 'p90'].includes(options.stat)) {
+        console.error(`unknown statistic ${options.stat}`);
+        process.exit(2);
+    }
+    if (!options.baseline || options.current.length === 0) {
+        console.error('--baseline and --current are required');
+        process.exit(2);
+    }
+    return options;
+}
+
+// Flattens one report or an array of reports (InteropBenchmark with
+// --build all) into a map keyed by platform/group/name.
+function indexReport(json) {
+    const reports = Array.isArray(json) ? json : [json];
+    const cases = new Map();
+    for (const report of reports) {
+        for (const result of report.results) {
+            cases.set(`${report.platform}/${result.group}/${result.name}`, result);
+        }
+    }
+    return { reports, cases };
+}
+
+// Fixed64Benchmark writes one result per line. Merging works on those lines,
+// so everything else (e.g. the 64-bit checksum) is kept byte for byte.
+function resultLines(text) {
+    const lines = new Map();
+    for (const line of text.split('\n')) {
+        const trimmed = line.trim().replace(/,$/, '');
+        if (trimmed.startsWith('{"group"')) {
+            const result = JSON.parse(trimmed);
+            lines.set(`${result.group}/${result.name}`, { text: trimmed, result });
+        }
+    }
+    return lines;
+}
+
+async function mergeRuns(paths, stat) {
+    const texts = await Promise.all(paths.map(path => readFile(path, 'utf8')));
+    const runs = texts.map(resultLines);
+    if (runs.some(run => run.size === 0)) {
+        console.error('several reports can only be merged for Fixed64Benchmark');
+        process.exit(2);
+    }
+    return texts[0].split('\n').map(line => {
+        const trimmed = line.trim();
+        if (!trimmed.startsWith('{"group"')) {
+            return line;
+        }
+        const result = JSON.parse(trimmed.replace(/,$/, ''));
+        const key = `${result.group}/${result.name}`;
+        const slowest = runs.map(run => run.get(key)).filter(Boolean)
+            .reduce((a, b) => b.result.nsPerOp[stat] > a.result.nsPerOp[stat] ? b : a);
+        return line.slice(0, line.indexOf('{')) + slowest.text + (trimmed.endsWith(',') ? ',' : '');
+    }).join('\n');
+}
+
+async function readReport(path) {
+    try {
+        return indexReport(JSON.parse(await readFile(path, 'utf8')));
+    } catch (error) {
+        console.error(`cannot read ${path}: ${error.message}`);
+        process.exit(2);
+    }
+}
+
+// ops/sec derived from the compared statistic.
+function formatOps(nsPerOp) {
+    const ops = 1e9 / nsPerOp;
+    return ops >= 1e6 ? `${(ops / 1e6).toFixed(2)}M` : `${(ops / 1e3).toFixed(1)}k`;
+}
+
+async function main() {
+    const options = parseOptions(process.argv.slice(2));
+    if (options.update) {
+        if (options.current.length === 1) {
+            await copyFile(options.current[0], options.baseline);
+        } else {
+            await writeFile(options.baseline, await mergeRuns(options.current, options.stat));
+        }
+        console.log(`baseline ${options.baseline} updated from ${options.current.join(', ')}`);
+        return;
+    }
+    const baseline = await readReport(options.baseline);
+    const current = await readReport(options.current[0]);
+    for (const path of options.current.slice(1)) {
+        for (const [key, result] of (await readReport(path)).cases) {
+            const fastest = current.cases.get(key);
+            if (!fastest || result.nsPerOp[options.stat] < fastest.nsPerOp[options.stat]) {
+                current.cases.set(key, result);
+            }
+        }
+    }
+    const baselineVersions = baseline.reports.map(report => report.mathVersion).join();
+    const currentVersions = current.reports.map(report => report.mathVersion).join();
+    if (baselineVersions !== currentVersions) {
+        console.warn(`warning: FIXED64_MATH_VERSION differs (baseline ${baselineVersions}, current ${currentVersions})`);
+    }
+
+    const rows = [];
+    let regressions = 0;
+    let skipped = 0;
+    for (const [key, result] of current.cases) {
+        if (options.groups && !options.groups.has(result.group)) continue;
+        const reference = baseline.cases.get(key);
+        if (!reference) {
+            rows.push([key, '-', formatOps(result.nsPerOp[options.stat]), '-', 'skipped']);
+            skipped++;
+            continue;
+        }
+        const before = reference.nsPerOp[options.stat];
+        const after = result.nsPerOp[options.stat];
+        const change = (after - before) / before * 100;
+        let status = 'ok';
+        if (change > options.threshold && after - before > options.minDeltaNs) {
+            status = 'REGRESSION';
+            regressions++;
+        } else if (-change > options.threshold && before - after > options.minDeltaNs) {
+            status = 'faster';
+        }
+        rows.push([key, formatOps(reference.nsPerOp[options.stat]), formatOps(result.nsPerOp[options.stat]),
+            `${change >= 0 ? '+' : ''}${change.toFixed(1)}%`, status]);
+    }
+    for (const key of baseline.cases.keys()) {
+        const group = key.split('/')[1];
+        if (!current.cases.has(key) && (!options.groups || options.groups.has(group))) {
+            rows.push([key, formatOps(baseline.cases.get(key).nsPerOp[options.stat]), '-', '-', 'missing']);
+        }
+    }
+
+    const header = ['case', 'baseline ops/s', 'current ops/s', `${options.stat} ns/op`, 'status'];
+    const widths = header.map((title, column) => Math.max(title.length, ...rows.map(row => row[column].length)));
+    const format = row => row.map((cell, column) => column === 0 ? cell.padEnd(widths[column]) : cell.padStart(widths[column])).join('  ');
+    console.log(format(header));
+    console.log(widths.map(width => '-'.repeat(width)).join('  '));
+    for (const row of rows) {
+        console.log(format(row));
+    }
+
+    console.log(`\n${regressions} regression(s) over ${options.threshold}% in ${rows.length - skipped} case(s)`);
+    if (skipped > 0) {
+        console.log(`${skipped} case(s) not in the baseline skipped; run perf-baseline to record them`);
+    }
+    process.exit(regressions > 0 ? 1 : 0);
+}
+
+main();
@@ -0,0 +1,256 @@
+// InteropBenchmark.mjs
+// Cost of crossing between JS and the wasm module for the esm and cjs builds
+// in dist/: empty embind calls, interop parameter writes, Fixed64Param
+// marshaling, return reads and a few complete wrapped operations. The
+// exports.* cases call the same entry points through Fixed64Exports, which
+// are plain wasm functions in FIXED64_C_EXPORTS builds (see CExports.h) and
+// the embind ones otherwise. `--build native` runs the esm build on the
+// Node-API addon (FIXED64_BUILD_NODE_ADDON); it is not part of `all`, since
+// the esm build can only be bound to one backend per process.
+//
+//   node benchmark/InteropBenchmark.mjs [--build esm|cjs|native|all] [--filter <s>]
+//        [--repetitions <n>] [--min-sample-ms <ms>] [--json <path|->]
+import { readFile, writeFile } from 'fs/promises';
+import { createRequire } from 'module';
+
+function parseOptions(argv) {
+    const options = { build: 'all', filter: '', repetitions: 20, warmup: 3, minSampleMs: 5, json: '' };
+    for (let i = 0; i < argv.length; i += 2) {
+        const value = argv[i + 1];
+        switch (argv[i]) {
+            case '--build': options.build = value; break;
+            case '--filter': options.filter = value; break;
+            case '--repetitions': options.repetitions = Math.max(1, parseInt(value, 10)); break;
+            case '--warmup': options.warmup = Math.max(0, parseInt(value, 10)); break;
+            case '--min-sample-ms': options.minSampleMs = parseFloat(value); break;
+            case '--json': options.json = value; break;
+            default:
+                console.error(`unknown option ${argv[i]}`);
+                process.exit(1);
+        }
+    }
+    return options;
+}
+
+async function loadEsm() {
+    const loader = await import(new URL('../dist/esm/Fixed64WasmLoader.esm.mjs', import.meta.url));
+    const { Fixed64 } = await import(new URL('../dist/esm/Fixed64.esm.mjs', import.meta.url));
+    await loader.loadFixed64Wasm(() => readFile(new URL('../dist/esm/Fixed64Native.wasm', import.meta.url)));
+    return { Fixed64, Module: loader.Fixed64Module, Exports: loader.Fixed64Exports };
+}
+
+async function loadCjs() {
+    const require = createRequire(import.meta.url);
+    const loader = require('../dist/cjs/Fixed64WasmLoader.cjs.js');
+    const { Fixed64 } = require('../dist/cjs/Fixed64.cjs.js');
+    await loader.loadFixed64Wasm(() => readFile(new URL('../dist/cjs/Fixed64Native.wasm', import.meta.url)));
+    return { Fixed64, Module: loader.Fixed64Module, Exports: loader.Fixed64Exports };
+}
+
+async function loadNative() {
+    const native = await import(new URL('../dist/esm/NodeNativeLoader.mjs', import.meta.url));
+    const loader = await import(new URL('../dist/esm/Fixed64WasmLoader.esm.mjs', import.meta.url));
+    const { Fixed64 } = await import(new URL('../dist/esm/Fixed64.esm.mjs', import.meta.url));
+    await native.loadFixed64Node('Fixed64Native.wasm');
+    return { Fixed64, Module: loader.Fixed64Module, Exports: loader.Fixed64Exports, backend: loader.fixed64Backend };
+}
+
+// Each case returns a function running `count` operations; the value it
+// returns is kept in a sink so the JIT cannot drop the work. Fixed64.add is
+// implemented in JS and listed as a reference for the wrapped ops.
+function defineCases({ Fixed64, Module, Exports }) {
+    const a = new Fixed64(1.25).add(0);
+    const b = new Fixed64(-3.5).add(0);
+    const out = new Fixed64(0);
+    const numberParam = { isRaw: true, raw: 1.25, high: 0, low: 0 };
+    const v1 = [1, 2, 3].map(x => new Fixed64(x).add(0));
+    const v2 = [4, 5, 6].map(x => new Fixed64(x).add(0));
+    const vOut = [0, 0, 0].map(() => new Fixed64(0));
+    const noop = () => 0;
+
+    // dist/ builds from before Fixed64Exports lack the exports.* cases
+    const cases = [
+        ['baseline', 'js.emptyFunction', count => {
+            let sink = 0;
+            for (let i = 0; i < count; i++) sink += noop();
+            return sink;
+        }],
+        ['crossing', 'Fixed64Native.emptyCall', count => {
+            for (let i = 0; i < count; i++) Module.Fixed64Native.emptyCall();
+            return 0;
+        }],
+        ['crossing', 'Vector3.emptyCall', count => {
+            for (let i = 0; i < count; i++) Module.Vector3.emptyCall();
+            return 0;
+        }],
+        ['crossing', 'exports.Fixed64Native.emptyCall', count => {
+            for (let i = 0; i < count; i++) Exports.Fixed64Native.emptyCall();
+            return 0;
+        }],
+        ['crossing', 'exports.Vector3.emptyCall', count => {
+            for (let i = 0; i < count; i++) Exports.Vector3.emptyCall();
+            return 0;
+        }],
+        ['params', 'write.fixed64', count => {
+            for (let i = 0; i < count; i++) Fixed64.prepareInteropParamArray(a);
+            return 0;
+        }],
+        ['params', 'write.fixed64x2', count => {
+            for (let i = 0; i < count; i++) Fixed64.prepareInteropParamArray(a, b);
+            return 0;
+        }],
+        ['params', 'write.number', count => {
+            for (let i = 0; i < count; i++) Fixed64.prepareInteropParamArray(numberParam);
+            return 0;
+        }],
+        ['params', 'marshal.number', count => {
+            let sink = 0;
+            for (let i = 0; i < count; i++) sink += Fixed64.toFixed64Param(i).raw;
+            return sink;
+        }],
+        ['return', 'read.out', count => {
+            let sink = 0;
+            for (let i = 0; i < count; i++) sink += Fixed64.getInteropReturn(0, out).low;
+            return sink;
+        }],
+        ['return', 'read.alloc', count => {
+            let sink = 0;
+            for (let i = 0; i < count; i++) sink += Fixed64.getInteropReturn(0).low;
+            return sink;
+        }],
+        ['op', 'Fixed64Native.add', count => {
+            Fixed64.prepareInteropParamArray(a, b);
+            for (let i = 0; i < count; i++) Module.Fixed64Native.add();
+            return 0;
+        }],
+        ['op', 'exports.Fixed64Native.add', count => {
+            Fixed64.prepareInteropParamArray(a, b);
+            for (let i = 0; i < count; i++) Exports.Fixed64Native.add();
+            return 0;
+        }],
+        ['op', 'exports.Fixed64Native.isNaN', count => {
+            let sink = 0;
+            Fixed64.prepareInteropParamArray(a);
+            for (let i = 0; i < count; i++) sink += Exports.Fixed64Native.isNaN() ? 1 : 0;
+            return sink;
+        }],
+        ['js', 'Fixed64.add.out', count => {
+            let sink = 0;
+            for (let i = 0; i < count; i++) sink += a.add(b, out).low;
+            return sink;
+        }],
+        ['js', 'Fixed64.add.alloc', count => {
+            let sink = 0;
+            for (let i = 0; i < count; i++) sink += a.add(b).low;
+            return sink;
+        }],
+        ['js', 'Fixed64.add.number', count => {
+            let sink = 0;
+            for (let i = 0; i < count; i++) sink += a.add(2.5, out).low;
+            return sink;
+        }],
+        ['op', 'Fixed64.mul.out', count => {
+            let sink = 0;
+            for (let i = 0; i < count; i++) sink += a.mul(b, out).low;
+            return sink;
+        }],
+        ['op', 'Fixed64.sqrt.out', count => {
+            let sink = 0;
+            for (let i = 0; i < count; i++) sink += a.sqrt(out).low;
+            return sink;
+        }],
+        ['op', 'Vector3.add', count => {
+            let sink = 0;
+            for (let i = 0; i < count; i++) {
+                Fixed64.prepareInteropParamArray(v1[0], v1[1], v1[2], v2[0], v2[1], v2[2]);
+                Module.Vector3.add();
+                sink += Fixed64.getInteropReturn(0, vOut[0]).low;
+                sink += Fixed64.getInteropReturn(1, vOut[1]).low;
+                sink += Fixed64.getInteropReturn(2, vOut[2]).low;
+            }
+            return sink;
+        }],
+    ];
+    return cases.filter(([, name]) => Exports || !name.startsWith('exports.'));
+}
+
+function measure(run, options) {
+    let sink = 0;
+    let count = 1;
+    for (;;) {
+        const start = process.hrtime.bigint();
+        sink += run(count);
+        const elapsedMs = Number(process.hrtime.bigint() - start) / 1e6;
+        if (elapsedMs >= options.minSampleMs || count >= 1 << 26) break;
+        count *= 2;
+    }
+
+    const samples = [];
+    for (let sample = 0; sample < options.warmup + options.repetitions; sample++) {
+        const start = process.hrtime.bigint();
+        sink += run(count);
+        const nsPerOp = Number(process.hrtime.bigint() - start) / count;
+        if (sample >= options.warmup) samples.push(nsPerOp);
+    }
+    samples.sort((x, y) => x - y);
+    const percentile = p => samples[Math.min(samples.length, Math.max(1, Math.ceil(p * samples.length))) - 1];
+    const mean = samples.reduce((sum, x) => sum + x, 0) / samples.length;
+    return {
+        sink,
+        opsPerRun: count,
+        nsPerOp: { min: samples[0], median: percentile(0.5), p90: percentile(0.9), p99: percentile(0.99), mean },
+    };
+}
+
+const round3 = x => Math.round(x * 1000) / 1000;
+
+async function main() {
+    const options = parseOptions(process.argv.slice(2));
+    // With --json - stdout carries only the report
+    const print = options.json === '-' ? console.error : console.log;
+    const loaders = { esm: loadEsm, cjs: loadCjs, native: loadNative };
+    const builds = options.build === 'all' ? ['esm', 'cjs'] : [options.build];
+
+    const reports = [];
+    let sink = 0;
+    for (const build of builds) {
+        if (!loaders[build]) {
+            console.error(`unknown build ${build}`);
+            process.exit(1);
+        }
+        const context = await loaders[build]();
+        const results = [];
+        const binding = context.backend === 'native' ? 'Node-API addon'
+            : context.Module._fixed64_export_table && context.Module.wasmTable ? 'wasm exports' : 'embind';
+        print(`\n[${build}] ns/op, Fixed64Exports: ${binding}`);
+        print(`${'group'.padEnd(10)} ${'name'.padEnd(26)} ${'min'.padStart(9)} ${'median'.padStart(9)} ${'p90'.padStart(9)}`);
+        for (const [group, name, run] of defineCases(context)) {
+            if (!`${group}/${name}`.includes(options.filter)) continue;
+            const result = measure(run, options);
+            sink += result.sink;
+            const { min, median, p90, p99, mean } = result.nsPerOp;
+            print(`${group.padEnd(10)} ${name.padEnd(26)} ${min.toFixed(2).padStart(9)} ${median.toFixed(2).padStart(9)} ${p90.toFixed(2).padStart(9)}`);
+            results.push({
+                group, name, opsPerRun: result.opsPerRun,
+                nsPerOp: { min: round3(min), median: round3(median), p90: round3(p90), p99: round3(p99), mean: round3(mean) },
+                opsPerSec: Math.round(1e9 / median),
+            });
+        }
+        reports.push({ suite: 'InteropBenchmark', platform: `node-${build}`, node: process.version, repetitions: options.repetitions, results });
+    }
+    print(`\nchecksum: ${sink}`);
+
+    if (options.json) {
+        const text = JSON.stringify(reports.length === 1 ? reports[0] : reports, null, 2) + '\n';
+        if (options.json === '-') {
+            process.stdout.write(text);
+        } else {
+            await writeFile(options.json, text);
+        }
+    }
+}
+
+main().catch(error => {
+    console.error(error);
+    process.exit(1);
+});
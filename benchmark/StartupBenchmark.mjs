@@ -0,0 +1,173 @@
+// StartupBenchmark.mjs
+// Cold start of the esm and cjs builds in dist/: every sample is a fresh
+// Node process that imports the loader, reads Fixed64Native.wasm, compiles
+// it, instantiates it through loadFixed64Wasm and makes a first call. The
+// phases are reported separately, in ms:
+//
+//   import       the loader, the emscripten glue and Fixed64
+//   read         the wasm file
+//   compile      WebAssembly.compile, or compileStreaming of a file stream
+//                with --compile streaming
+//   instantiate  loadFixed64Wasm from the compiled module: instantiation,
+//                runtime and embind setup, interop addresses, entry points
+//   firstCall    the first Fixed64 operation
+//
+// instantiate alone is what a worker thread pays when it receives the
+// compiled module (fixed64WasmModule) instead of the binary.
+//
+// --dist compares another build output, e.g. a FIXED64_LEAN build, against
+// dist/ by its wasm size and instantiate time.
+//
+//   node benchmark/StartupBenchmark.mjs [--build esm|cjs|all] [--samples <n>]
+//        [--compile bytes|streaming] [--dist <dir>] [--json <path|->]
+import { execFileSync } from 'child_process';
+import { createReadStream } from 'fs';
+import { readFile, stat, writeFile } from 'fs/promises';
+import { createRequire } from 'module';
+import { Readable } from 'stream';
+import { fileURLToPath, pathToFileURL } from 'url';
+
+const kPhases = ['import', 'read', 'compile', 'instantiate', 'firstCall'];
+
+function parseOptions(argv) {
+    const options = { build: 'all', samples: 15, compile: 'bytes', dist: '', json: '', child: '' };
+    for (let i = 0; i < argv.length; i += 2) {
+        const value = argv[i + 1];
+        switch (argv[i]) {
+            case '--build': options.build = value; break;
+            case '--samples': options.samples = Math.max(1, parseInt(value, 10)); break;
+            case '--compile': options.compile = value; break;
+            case '--dist': options.dist = value; break;
+            case '--json': options.json = value; break;
+            // Internal: run one sample of a build and print its phases
+            case '--child': options.child = value; break;
+            default:
+                console.error(`unknown option ${argv[i]}`);
+                process.exit(1);
+        }
+    }
+    return options;
+}
+
+let distUrl = new URL('../dist/', import.meta.url);
+
+const wasmUrl = build => new URL(`${build}/Fixed64Native.wasm`, distUrl);
+
+async function importBuild(build) {
+    if (build === 'esm') {
+        const loader = await import(new URL('esm/Fixed64WasmLoader.esm.mjs', distUrl));
+        const { Fixed64 } = await import(new URL('esm/Fixed64.esm.mjs', distUrl));
+        return { loader, Fixed64 };
+    }
+    const require = createRequire(distUrl);
+    return { loader: require('./cjs/Fixed64WasmLoader.cjs.js'), Fixed64: require('./cjs/Fixed64.cjs.js').Fixed64 };
+}
+
+async function compile(build, mode) {
+    if (mode === 'streaming') {
+        const body = Readable.toWeb(createReadStream(wasmUrl(build)));
+        return WebAssembly.compileStreaming(new Response(body, { headers: { 'Content-Type': 'application/wasm' } }));
+    }
+    return WebAssembly.compile(await readFile(wasmUrl(build)));
+}
+
+async function runChild(build, mode) {
+    const times = {};
+    let start = performance.now();
+    const lap = phase => {
+        const now = performance.now();
+        times[phase] = now - start;
+        start = now;
+    };
+    const { loader, Fixed64 } = await importBuild(build);
+    lap('import');
+    let module;
+    if (mode === 'streaming') {
+        times.read = 0;
+        module = await compile(build, mode);
+    } else {
+        const bytes = await readFile(wasmUrl(build));
+        lap('read');
+        module = await WebAssembly.compile(bytes);
+    }
+    lap('compile');
+    await loader.loadFixed64Wasm(async () => module);
+    lap('instantiate');
+    const value = new Fixed64(1.5).mul(new Fixed64(2));
+    lap('firstCall');
+    times.check = Number(value.toString());
+    process.stdout.write(JSON.stringify(times));
+}
+
+function summarize(samples) {
+    const result = {};
+    for (const phase of [...kPhases, 'total']) {
+        const values = samples.map(sample => phase === 'total'
+            ? kPhases.reduce((sum, name) => sum + sample[name], 0)
+            : sample[phase]).sort((a, b) => a - b);
+        const percentile = p => values[Math.min(values.length - 1, Math.floor(p * values.length))];
+        result[phase] = { min: values[0], median: percentile(0.5), p90: percentile(0.9) };
+    }
+    return result;
+}
+
+const round3 = x => Math.round(x * 1000) / 1000;
+
+async function main() {
+    const options = parseOptions(process.argv.slice(2));
+    // With --json - stdout carries only the report
+    const print = options.json === '-' ? console.error : console.log;
+    if (options.dist) {
+        distUrl = pathToFileURL(options.dist.endsWith('/') ? options.dist : `${options.dist}/`);
+    }
+    if (options.child) {
+        await runChild(options.child, options.compile);
+        return;
+    }
+    const builds = options.build === 'all' ? ['esm', 'cjs'] : [options.build];
+    const script = fileURLToPath(import.meta.url);
+    const reports = [];
+    for (const build of builds) {
+        if (build !== 'esm' && build !== 'cjs') {
+            console.error(`unknown build ${build}`);
+            process.exit(1);
+        }
+        const samples = [];
+        for (let i = 0; i < options.samples; i++) {
+            const output = execFileSync(process.execPath, [script, '--child', build, '--compile', options.compile, ...(options.dist ? ['--dist', options.dist] : [])], { encoding: 'utf8' });
+            samples.push(JSON.parse(output.slice(output.lastIndexOf('{'))));
+        }
+        if (samples.some(sample => sample.check !== 3)) {
+            console.error(`[${build}] first call returned a wrong result`);
+            process.exit(1);
+        }
+        const wasmBytes = (await stat(wasmUrl(build))).size;
+        const phases = summarize(samples);
+        print(`\n[${build}] ms per cold start, ${options.samples} processes, ${wasmBytes} byte wasm, compile: ${options.compile}`);
+        print(`${'phase'.padEnd(12)} ${'min'.padStart(9)} ${'median'.padStart(9)} ${'p90'.padStart(9)}`);
+        for (const [phase, { min, median, p90 }] of Object.entries(phases)) {
+            print(`${phase.padEnd(12)} ${min.toFixed(3).padStart(9)} ${median.toFixed(3).padStart(9)} ${p90.toFixed(3).padStart(9)}`);
+        }
+        reports.push({
+            suite: 'StartupBenchmark', platform: `node-${build}`, node: process.version, samples: options.samples,
+            compile: options.compile, dist: fileURLToPath(distUrl), wasmBytes,
+            results: Object.entries(phases).map(([phase, { min, median, p90 }]) => ({
+                group: 'startup', name: phase, msPerStart: { min: round3(min), median: round3(median), p90: round3(p90) },
+            })),
+        });
+    }
+
+    if (options.json) {
+        const text = JSON.stringify(reports.length === 1 ? reports[0] : reports, null, 2) + '\n';
+        if (options.json === '-') {
+            process.stdout.write(text);
+        } else {
+            await writeFile(options.json, text);
+        }
+    }
+}
+
+main().catch(error => {
+    console.error(error);
+    process.exit(1);
+});
@@ -1,4 +1,5 @@
 export * from "./dist/esm/Fixed64.esm"
 export * from "./dist/esm/NodeWasmLoader"
+export * from "./dist/esm/NodeNativeLoader"
 export * from "./dist/esm/WebWasmLoader"
 export * from "./dist/esm/Fixed64WasmLoader.esm"
\ No newline at end of file
@@ -0,0 +1,504 @@
+/* eslint-disable */
+// Fixed64Exports.ts
+// Generated by Fixed64ExportTypings from src/cpp/include/EntryPoints.h, do not edit;
+// regenerate with `cmake --build <native build> --target export-typings`.
+//
+// bindFixed64Exports() calls the plain wasm functions of a FIXED64_C_EXPORTS build
+// (see CExports.h), bindFixed64Embind() the embind functions of any build. Both
+// return the same shape and the same result types.
+
+export interface Fixed64NativeEntryPoints {
+    parseFloat(a0: number): void;
+    parseFloatRounded(a0: number, a1: number): void;
+    parseFloatMany(a0: number, a1: number, a2: number, a3: number): void;
+    div(): void;
+    toNumber(): number;
+    toString(): string;
+    formatDecimal(a0: number): number;
+    parseDecimal(a0: number): boolean;
+    formatDecimalMany(a0: number, a1: number, a2: number, a3: number, a4: number, a5: number): number;
+    parseDecimalMany(a0: number, a1: number, a2: number, a3: number, a4: number): number;
+    abs(): void;
+    acos(): void;
+    add(): void;
+    asin(): void;
+    atan(): void;
+    atan2(): void;
+    atan2Deg(): void;
+    atan2Heading(a0: number): number;
+    atan2Many(a0: number, a1: number, a2: number, a3: number): void;
+    atan2DegMany(a0: number, a1: number, a2: number, a3: number): void;
+    atan2HeadingMany(a0: number, a1: number, a2: number, a3: number, a4: number): void;
+    ceil(): void;
+    clamp(): void;
+    cos(): void;
+    exp(): void;
+    floor(): void;
+    mod(): void;
+    mul(): void;
+    square(): void;
+    pow2(): void;
+    log2(): void;
+    ln(): void;
+    pow(): void;
+    powInt(a0: number): void;
+    clz(): number;
+    ctz(): number;
+    popcount(): number;
+    log2Int(): number;
+    frexp(): number;
+    round(): void;
+    sign(): void;
+    sin(): void;
+    sqrt(): void;
+    sub(): void;
+    tan(): void;
+    neg(): void;
+    isNaN(): boolean;
+    isInfinity(): boolean;
+    isFinite(): boolean;
+    isInteger(): boolean;
+    isNegative(): boolean;
+    isPositive(): boolean;
+    isZero(): boolean;
+    gt(): boolean;
+    gte(): boolean;
+    lt(): boolean;
+    lte(): boolean;
+    eq(): boolean;
+    cmp(): number;
+    min(a0: number): void;
+    max(a0: number): void;
+    sum(a0: number): void;
+    emptyCall(): void;
+}
+
+export interface Vector2EntryPoints {
+    add(): void;
+    sub(): void;
+    scalar(): void;
+    normalize(): void;
+    normalizeMany(a0: number, a1: number, a2: number): void;
+    len(): void;
+    dot(): void;
+}
+
+export interface ModuleEntryPoints {
+    abs(): void;
+    absSq(): void;
+    det(): void;
+    normalize(): void;
+}
+
+export interface Vector3EntryPoints {
+    cross(): void;
+    dot(): void;
+    add(): void;
+    sub(): void;
+    mul(): void;
+    div(): void;
+    scalar(): void;
+    normalize(): void;
+    normalizeMany(a0: number, a1: number, a2: number, a3: number): void;
+    normalizedDirection(): void;
+    negative(): void;
+    distance(): void;
+    squaredDistance(): void;
+    rotateX(): void;
+    rotateY(): void;
+    rotateZ(): void;
+    lerp(): void;
+    lengthSqr(): void;
+    len(): void;
+    isCircleOverlaps(a0: boolean, a1: boolean): boolean;
+    isCircleOverlapsXY(a0: boolean): boolean;
+    isCircleOverlapsXZ(a0: boolean): boolean;
+    isLineCircleIntersect(): boolean;
+    decayKnockbackVector(): void;
+    velocityToForward(): boolean;
+    moveForward(): void;
+    emptyCall(): void;
+}
+
+export interface RectEntryPoints {
+    overlapsWithCircle(a0: boolean): boolean;
+    overlapsWithRect(): boolean;
+    containsPoint(): boolean;
+    overlapsWithCircleXY(a0: boolean): boolean;
+    overlapsWithCircleXZ(a0: boolean): boolean;
+    overlapsWithRectXY(): boolean;
+    overlapsWithRectXZ(): boolean;
+    containsPointXY(): boolean;
+    containsPointXZ(): boolean;
+    queryCircles(a0: number, a1: number, a2: number, a3: number, a4: number): boolean;
+}
+
+export interface SectorEntryPoints {
+    overlapsWithCircle(): boolean;
+    queryCircles(a0: number, a1: number, a2: number, a3: number, a4: number): boolean;
+}
+
+export interface StateHashEntryPoints {
+    reset(a0: number, a1: number): void;
+    updateParams(a0: number): void;
+    updateBytes(a0: number, a1: number): void;
+    updateColumn(a0: number, a1: number): void;
+    updateVector2Columns(a0: number, a1: number, a2: number): void;
+    updateVector3Columns(a0: number, a1: number, a2: number, a3: number): void;
+    digest(): void;
+}
+
+export interface SnapshotEntryPoints {
+    encode(a0: number, a1: number, a2: number, a3: number, a4: number, a5: number): number;
+    decode(a0: number, a1: number, a2: number, a3: number, a4: number, a5: number): number;
+    decodedCount(a0: number, a1: number): number;
+    maxEncodedSize(a0: number): number;
+}
+
+export interface JobPoolEntryPoints {
+    setWorkerCount(a0: number): void;
+    workerCount(): number;
+}
+
+export interface SimContextEntryPoints {
+    create(): number;
+    destroy(a0: number): void;
+    bind(a0: number): void;
+    current(): number;
+    setWorldType(a0: number): void;
+    worldType(): number;
+    reserveTickArena(a0: number): boolean;
+    beginTick(): void;
+    tickArena(): number;
+    tickArenaUsed(): number;
+    tickArenaPeak(): number;
+    tickArenaOverflows(): number;
+    resetTickArenaStats(): void;
+}
+
+export interface ArenaEntryPoints {
+    create(a0: number): number;
+    destroy(a0: number): void;
+    allocate(a0: number, a1: number): number;
+    reset(a0: number): void;
+    used(a0: number): number;
+    capacity(a0: number): number;
+}
+
+export interface EntityTableEntryPoints {
+    create(a0: number): number;
+    destroy(a0: number): void;
+    addColumn(a0: number, a1: number): number;
+    spawn(a0: number): number;
+    despawn(a0: number, a1: number): boolean;
+    rowOf(a0: number, a1: number): number;
+    size(a0: number): number;
+    capacity(a0: number): number;
+    ids(a0: number): number;
+    column(a0: number, a1: number, a2: number): number;
+    components(a0: number, a1: number): number;
+    set(a0: number, a1: number, a2: number): boolean;
+    get(a0: number, a1: number, a2: number): boolean;
+    normalize(a0: number, a1: number): boolean;
+    integrate(a0: number, a1: number, a2: number): boolean;
+    atan2(a0: number, a1: number, a2: number): boolean;
+    hash(a0: number): void;
+    queryRect(a0: number, a1: number, a2: number): boolean;
+    querySector(a0: number, a1: number, a2: number): boolean;
+}
+
+export interface Fixed64EntryPoints {
+    Fixed64Native: Fixed64NativeEntryPoints;
+    Vector2: Vector2EntryPoints;
+    Module: ModuleEntryPoints;
+    Vector3: Vector3EntryPoints;
+    Rect: RectEntryPoints;
+    Sector: SectorEntryPoints;
+    StateHash: StateHashEntryPoints;
+    Snapshot: SnapshotEntryPoints;
+    JobPool: JobPoolEntryPoints;
+    SimContext: SimContextEntryPoints;
+    Arena: ArenaEntryPoints;
+    EntityTable: EntityTableEntryPoints;
+}
+
+/** Length of fixed64_export_table() the bindings were generated for */
+export const fixed64ExportCount = 164;
+
+/** `table` is the wasm function table, `indices` the contents of fixed64_export_table() */
+export function bindFixed64Exports(module: any, table: WebAssembly.Table, indices: Uint32Array): Fixed64EntryPoints {
+    if (indices.length !== fixed64ExportCount) {
+        throw new Error(`Fixed64Exports.ts expects ${fixed64ExportCount} entry points, the module exports ${indices.length}`);
+    }
+    const get = (id: number): any => table.get(indices[id]);
+    const e6 = get(6);
+    const e7 = get(7);
+    const e8 = get(8);
+    const e17 = get(17);
+    const e46 = get(46);
+    const e47 = get(47);
+    const e48 = get(48);
+    const e49 = get(49);
+    const e50 = get(50);
+    const e51 = get(51);
+    const e52 = get(52);
+    const e53 = get(53);
+    const e54 = get(54);
+    const e55 = get(55);
+    const e56 = get(56);
+    const e57 = get(57);
+    const e93 = get(93);
+    const e94 = get(94);
+    const e95 = get(95);
+    const e96 = get(96);
+    const e98 = get(98);
+    const e101 = get(101);
+    const e102 = get(102);
+    const e103 = get(103);
+    const e104 = get(104);
+    const e105 = get(105);
+    const e106 = get(106);
+    const e107 = get(107);
+    const e108 = get(108);
+    const e109 = get(109);
+    const e110 = get(110);
+    const e111 = get(111);
+    const e112 = get(112);
+    const e123 = get(123);
+    const e125 = get(125);
+    const e126 = get(126);
+    const e129 = get(129);
+    const e131 = get(131);
+    const e132 = get(132);
+    const e134 = get(134);
+    const e135 = get(135);
+    const e136 = get(136);
+    const e137 = get(137);
+    const e139 = get(139);
+    const e141 = get(141);
+    const e143 = get(143);
+    const e144 = get(144);
+    const e145 = get(145);
+    const e148 = get(148);
+    const e149 = get(149);
+    const e150 = get(150);
+    const e151 = get(151);
+    const e152 = get(152);
+    const e153 = get(153);
+    const e154 = get(154);
+    const e155 = get(155);
+    const e156 = get(156);
+    const e157 = get(157);
+    const e158 = get(158);
+    const e159 = get(159);
+    const e160 = get(160);
+    const e162 = get(162);
+    const e163 = get(163);
+    return {
+        Fixed64Native: {
+            parseFloat: get(0),
+            parseFloatRounded: get(1),
+            parseFloatMany: get(2),
+            div: get(3),
+            toNumber: get(4),
+            toString: module.Fixed64Native.toString,
+            formatDecimal: (a0: number): number => e6(a0) >>> 0,
+            parseDecimal: (a0: number): boolean => e7(a0) !== 0,
+            formatDecimalMany: (a0: number, a1: number, a2: number, a3: number, a4: number, a5: number): number => e8(a0, a1, a2, a3, a4, a5) >>> 0,
+            parseDecimalMany: get(9),
+            abs: get(10),
+            acos: get(11),
+            add: get(12),
+            asin: get(13),
+            atan: get(14),
+            atan2: get(15),
+            atan2Deg: get(16),
+            atan2Heading: (a0: number): number => e17(a0) >>> 0,
+            atan2Many: get(18),
+            atan2DegMany: get(19),
+            atan2HeadingMany: get(20),
+            ceil: get(21),
+            clamp: get(22),
+            cos: get(23),
+            exp: get(24),
+            floor: get(25),
+            mod: get(26),
+            mul: get(27),
+            square: get(28),
+            pow2: get(29),
+            log2: get(30),
+            ln: get(31),
+            pow: get(32),
+            powInt: get(33),
+            clz: get(34),
+            ctz: get(35),
+            popcount: get(36),
+            log2Int: get(37),
+            frexp: get(38),
+            round: get(39),
+            sign: get(40),
+            sin: get(41),
+            sqrt: get(42),
+            sub: get(43),
+            tan: get(44),
+            neg: get(45),
+            isNaN: (): boolean => e46() !== 0,
+            isInfinity: (): boolean => e47() !== 0,
+            isFinite: (): boolean => e48() !== 0,
+            isInteger: (): boolean => e49() !== 0,
+            isNegative: (): boolean => e50() !== 0,
+            isPositive: (): boolean => e51() !== 0,
+            isZero: (): boolean => e52() !== 0,
+            gt: (): boolean => e53() !== 0,
+            gte: (): boolean => e54() !== 0,
+            lt: (): boolean => e55() !== 0,
+            lte: (): boolean => e56() !== 0,
+            eq: (): boolean => e57() !== 0,
+            cmp: get(58),
+            min: get(59),
+            max: get(60),
+            sum: get(61),
+            emptyCall: get(62),
+        },
+        Vector2: {
+            add: get(63),
+            sub: get(64),
+            scalar: get(65),
+            normalize: get(66),
+            normalizeMany: get(67),
+            len: get(68),
+            dot: get(69),
+        },
+        Module: {
+            abs: get(70),
+            absSq: get(71),
+            det: get(72),
+            normalize: get(73),
+        },
+        Vector3: {
+            cross: get(74),
+            dot: get(75),
+            add: get(76),
+            sub: get(77),
+            mul: get(78),
+            div: get(79),
+            scalar: get(80),
+            normalize: get(81),
+            normalizeMany: get(82),
+            normalizedDirection: get(83),
+            negative: get(84),
+            distance: get(85),
+            squaredDistance: get(86),
+            rotateX: get(87),
+            rotateY: get(88),
+            rotateZ: get(89),
+            lerp: get(90),
+            lengthSqr: get(91),
+            len: get(92),
+            isCircleOverlaps: (a0: boolean, a1: boolean): boolean => e93(a0, a1) !== 0,
+            isCircleOverlapsXY: (a0: boolean): boolean => e94(a0) !== 0,
+            isCircleOverlapsXZ: (a0: boolean): boolean => e95(a0) !== 0,
+            isLineCircleIntersect: (): boolean => e96() !== 0,
+            decayKnockbackVector: get(97),
+            velocityToForward: (): boolean => e98() !== 0,
+            moveForward: get(99),
+            emptyCall: get(100),
+        },
+        Rect: {
+            overlapsWithCircle: (a0: boolean): boolean => e101(a0) !== 0,
+            overlapsWithRect: (): boolean => e102() !== 0,
+            containsPoint: (): boolean => e103() !== 0,
+            overlapsWithCircleXY: (a0: boolean): boolean => e104(a0) !== 0,
+            overlapsWithCircleXZ: (a0: boolean): boolean => e105(a0) !== 0,
+            overlapsWithRectXY: (): boolean => e106() !== 0,
+            overlapsWithRectXZ: (): boolean => e107() !== 0,
+            containsPointXY: (): boolean => e108() !== 0,
+            containsPointXZ: (): boolean => e109() !== 0,
+            queryCircles: (a0: number, a1: number, a2: number, a3: number, a4: number): boolean => e110(a0, a1, a2, a3, a4) !== 0,
+        },
+        Sector: {
+            overlapsWithCircle: (): boolean => e111() !== 0,
+            queryCircles: (a0: number, a1: number, a2: number, a3: number, a4: number): boolean => e112(a0, a1, a2, a3, a4) !== 0,
+        },
+        StateHash: {
+            reset: get(113),
+            updateParams: get(114),
+            updateBytes: get(115),
+            updateColumn: get(116),
+            updateVector2Columns: get(117),
+            updateVector3Columns: get(118),
+            digest: get(119),
+        },
+        Snapshot: {
+            encode: get(120),
+            decode: get(121),
+            decodedCount: get(122),
+            maxEncodedSize: (a0: number): number => e123(a0) >>> 0,
+        },
+        JobPool: {
+            setWorkerCount: get(124),
+            workerCount: (): number => e125() >>> 0,
+        },
+        SimContext: {
+            create: (): number => e126() >>> 0,
+            destroy: get(127),
+            bind: get(128),
+            current: (): number => e129() >>> 0,
+            setWorldType: get(130),
+            worldType: (): number => e131() >>> 0,
+            reserveTickArena: (a0: number): boolean => e132(a0) !== 0,
+            beginTick: get(133),
+            tickArena: (): number => e134() >>> 0,
+            tickArenaUsed: (): number => e135() >>> 0,
+            tickArenaPeak: (): number => e136() >>> 0,
+            tickArenaOverflows: (): number => e137() >>> 0,
+            resetTickArenaStats: get(138),
+        },
+        Arena: {
+            create: (a0: number): number => e139(a0) >>> 0,
+            destroy: get(140),
+            allocate: (a0: number, a1: number): number => e141(a0, a1) >>> 0,
+            reset: get(142),
+            used: (a0: number): number => e143(a0) >>> 0,
+            capacity: (a0: number): number => e144(a0) >>> 0,
+        },
+        EntityTable: {
+            create: (a0: number): number => e145(a0) >>> 0,
+            destroy: get(146),
+            addColumn: get(147),
+            spawn: (a0: number): number => e148(a0) >>> 0,
+            despawn: (a0: number, a1: number): boolean => e149(a0, a1) !== 0,
+            rowOf: (a0: number, a1: number): number => e150(a0, a1) >>> 0,
+            size: (a0: number): number => e151(a0) >>> 0,
+            capacity: (a0: number): number => e152(a0) >>> 0,
+            ids: (a0: number): number => e153(a0) >>> 0,
+            column: (a0: number, a1: number, a2: number): number => e154(a0, a1, a2) >>> 0,
+            components: (a0: number, a1: number): number => e155(a0, a1) >>> 0,
+            set: (a0: number, a1: number, a2: number): boolean => e156(a0, a1, a2) !== 0,
+            get: (a0: number, a1: number, a2: number): boolean => e157(a0, a1, a2) !== 0,
+            normalize: (a0: number, a1: number): boolean => e158(a0, a1) !== 0,
+            integrate: (a0: number, a1: number, a2: number): boolean => e159(a0, a1, a2) !== 0,
+            atan2: (a0: number, a1: number, a2: number): boolean => e160(a0, a1, a2) !== 0,
+            hash: get(161),
+            queryRect: (a0: number, a1: number, a2: number): boolean => e162(a0, a1, a2) !== 0,
+            querySector: (a0: number, a1: number, a2: number): boolean => e163(a0, a1, a2) !== 0,
+        },
+    };
+}
+
+export function bindFixed64Embind(module: any): Fixed64EntryPoints {
+    return {
+        Fixed64Native: module.Fixed64Native,
+        Vector2: module.Vector2,
+        Module: module,
+        Vector3: module.Vector3,
+        Rect: module.Rect,
+        Sector: module.Sector,
+        StateHash: module.StateHash,
+        Snapshot: module.Snapshot,
+        JobPool: module.JobPool,
+        SimContext: module.SimContext,
+        Arena: module.Arena,
+        EntityTable: module.EntityTable,
+    };
+}
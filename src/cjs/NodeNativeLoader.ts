@@ -0,0 +1,21 @@
+// NodeNativeLoader.ts
+import { Fixed64Module, initFixed64Module, loadFixed64Wasm } from './Fixed64WasmLoader.cjs.js';
+import { loadWasmFileFromNode } from './NodeWasmLoader.js';
+
+/**
+ * Loads the Node-API addon (FIXED64_BUILD_NODE_ADDON) in place of the wasm module. The addon has the same
+ * surface and produces the same results, at a fraction of the per-call cost. Falls back to the wasm module at
+ * `wasmRelativePath` when the addon is missing, built for another platform or already loaded by another thread;
+ * `fixed64Backend` tells which one is in use.
+ */
+export async function loadFixed64Node(wasmRelativePath: string, addonPath: string = '../native/Fixed64Node.node'): Promise<any> {
+    if (Fixed64Module) {
+        return Fixed64Module;
+    }
+    try {
+        return initFixed64Module(require(addonPath), 'native');
+    } catch (error) {
+        console.log(`Fixed64Node unavailable (${(error as Error).message}), using wasm`);
+    }
+    return loadFixed64Wasm(() => loadWasmFileFromNode(wasmRelativePath));
+}
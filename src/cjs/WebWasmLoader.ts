@@ -3,4 +3,24 @@ export async function loadWasmFileFromWeb(url: string): Promise<Uint8Array> {
     console.log("Loading WASM from URL:", url);
     const response = await fetch(url);
     return new Uint8Array(await response.arrayBuffer());
+}
+
+/**
+ * Compiles the wasm module at `url` while it downloads, for `loadFixed64Wasm(() => compileWasmFromWeb(url))`.
+ * Browsers keep the compiled code of streamed modules with the HTTP cache entry, so later loads skip most of the
+ * compile. Streaming needs the server to send `application/wasm`; otherwise the module is compiled after the
+ * download, like with loadWasmFileFromWeb().
+ */
+export async function compileWasmFromWeb(url: string): Promise<WebAssembly.Module> {
+    if (typeof WebAssembly.compileStreaming === 'function') {
+        try {
+            return await WebAssembly.compileStreaming(fetch(url));
+        } catch (error) {
+            // A TypeError is a response compileStreaming does not accept, e.g. another MIME type
+            if (!(error instanceof TypeError)) {
+                throw error;
+            }
+        }
+    }
+    return WebAssembly.compile(await loadWasmFileFromWeb(url));
 }
\ No newline at end of file
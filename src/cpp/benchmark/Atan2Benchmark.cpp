@@ -0,0 +1,119 @@
+// Atan2Benchmark.cpp
+// Compares the division-based Atan2 (FIXED64_MATH_VERSION 1) with the
+// reciprocal-based one (FIXED64_MATH_VERSION 2) over (y, x) columns, and
+// times the degree and quantized heading batch variants.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "FixedMath.h"
+
+using namespace Skynet;
+
+namespace {
+struct InputRange {
+  const char *name;
+  double radius;
+};
+
+template <typename Func>
+double measureNsPerOp(size_t count, Func func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> elapsed = end - start;
+  return elapsed.count() / static_cast<double>(count);
+}
+
+template <typename Kernel>
+void atan2Column(const std::vector<int64_t> &ys, const std::vector<int64_t> &xs,
+                 std::vector<int64_t> &out, Kernel kernel) {
+  for (size_t i = 0; i < ys.size(); ++i) {
+    out[i] = kernel(Fixed64(ys[i]), Fixed64(xs[i])).value;
+  }
+}
+}  // namespace
+
+int main() {
+  constexpr size_t kSamples = 1 << 20;
+  constexpr int kRepetitions = 5;
+  const InputRange ranges[] = {
+      {"|v| < 1", 1.0},
+      {"|v| < 100", 100.0},
+      {"|v| < 30000", 30000.0},
+  };
+
+  std::mt19937_64 rng(0x5EED5EEDULL);
+  int64_t sink = 0;
+
+  std::printf("%-12s %10s %10s %10s %12s %10s %10s %10s\n", "range",
+              "v1 ns/op", "v2 ns/op", "speedup", "heading ns", "deg ns",
+              "v1 ulps", "v2 ulps");
+  for (const auto &range : ranges) {
+    std::uniform_real_distribution<double> dist(-range.radius, range.radius);
+    std::vector<int64_t> ys(kSamples);
+    std::vector<int64_t> xs(kSamples);
+    for (size_t i = 0; i < kSamples; ++i) {
+      ys[i] = Fixed64(dist(rng)).value;
+      xs[i] = Fixed64(dist(rng)).value;
+    }
+    std::vector<int64_t> out(kSamples);
+    std::vector<uint32_t> headings(kSamples);
+
+    auto v1 = [&] { atan2Column(ys, xs, out, FixedMath::Atan2V1); };
+    auto v2 = [&] { atan2Column(ys, xs, out, FixedMath::Atan2V2); };
+    auto heading = [&] {
+      FixedMath::Atan2HeadingMany(ys.data(), xs.data(), headings.data(),
+                                  kSamples, 8);
+    };
+    auto degrees = [&] {
+      FixedMath::Atan2DegMany(ys.data(), xs.data(), out.data(), kSamples);
+    };
+
+    // Warm up every kernel before timing.
+    measureNsPerOp(kSamples, v1);
+    measureNsPerOp(kSamples, v2);
+    measureNsPerOp(kSamples, heading);
+    measureNsPerOp(kSamples, degrees);
+
+    double v1Ns = 0;
+    double v2Ns = 0;
+    double headingNs = 0;
+    double degreesNs = 0;
+    for (int i = 0; i < kRepetitions; ++i) {
+      v1Ns += measureNsPerOp(kSamples, v1);
+      v2Ns += measureNsPerOp(kSamples, v2);
+      headingNs += measureNsPerOp(kSamples, heading);
+      degreesNs += measureNsPerOp(kSamples, degrees);
+      sink += out[i] + headings[i];
+    }
+    v1Ns /= kRepetitions;
+    v2Ns /= kRepetitions;
+    headingNs /= kRepetitions;
+    degreesNs /= kRepetitions;
+
+    double v1Ulps = 0;
+    double v2Ulps = 0;
+    for (size_t i = 0; i < kSamples; ++i) {
+      Fixed64 y(ys[i]);
+      Fixed64 x(xs[i]);
+      double expected =
+          std::atan2(static_cast<double>(y), static_cast<double>(x)) *
+          FixLut::ONE;
+      v1Ulps = std::max(
+          v1Ulps, std::fabs(FixedMath::Atan2V1(y, x).value - expected));
+      v2Ulps = std::max(
+          v2Ulps, std::fabs(FixedMath::Atan2V2(y, x).value - expected));
+    }
+
+    std::printf("%-12s %10.2f %10.2f %9.2fx %12.2f %10.2f %10.1f %10.1f\n",
+                range.name, v1Ns, v2Ns, v1Ns / v2Ns, headingNs, degreesNs,
+                v1Ulps, v2Ulps);
+  }
+
+  std::printf("checksum: %lld\n", static_cast<long long>(sink));
+  return 0;
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+// Minimal benchmark harness shared by the benchmark executables.
+//
+// Every case processes a fixed batch of precomputed inputs per run. The
+// harness calibrates how many runs make up one sample, discards warmup
+// samples, and reports percentiles of ns/op over the remaining ones. Inputs
+// come from a seeded std::mt19937_64 using its raw output only, so they are
+// identical across standard libraries (native and emscripten builds).
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Fixed64.h"
+
+#ifndef FIXED64_MATH_VERSION
+#define FIXED64_MATH_VERSION 1
+#endif
+
+namespace Skynet {
+namespace Benchmark {
+
+struct Options {
+  // Only cases whose "group/name" contains this substring are run.
+  std::string filter;
+  // Write the results as JSON to this path, "-" for stdout.
+  std::string jsonPath;
+  int repetitions = 30;
+  int warmup = 3;
+  double minSampleMs = 2.0;
+  uint64_t seed = 0x5EED5EEDULL;
+};
+
+inline void printUsage(const char *program) {
+  std::printf(
+      "usage: %s [--filter <substring>] [--json <path|->]\n"
+      "          [--repetitions <n>] [--warmup <n>] [--min-sample-ms <ms>]\n"
+      "          [--seed <n>]\n",
+      program);
+}
+
+inline Options parseOptions(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (std::strcmp(arg, "--help") == 0 || value == nullptr) {
+      printUsage(argv[0]);
+      std::exit(std::strcmp(arg, "--help") == 0 ? 0 : 1);
+    }
+    if (std::strcmp(arg, "--filter") == 0) {
+      options.filter = value;
+    } else if (std::strcmp(arg, "--json") == 0) {
+      options.jsonPath = value;
+    } else if (std::strcmp(arg, "--repetitions") == 0) {
+      options.repetitions = std::max(1, std::atoi(value));
+    } else if (std::strcmp(arg, "--warmup") == 0) {
+      options.warmup = std::max(0, std::atoi(value));
+    } else if (std::strcmp(arg, "--min-sample-ms") == 0) {
+      options.minSampleMs = std::atof(value);
+    } else if (std::strcmp(arg, "--seed") == 0) {
+      options.seed = std::strtoull(value, nullptr, 0);
+    } else {
+      printUsage(argv[0]);
+      std::exit(1);
+    }
+    ++i;
+  }
+  return options;
+}
+
+// Uniformly distributed raw Fixed64 values in [min, max).
+inline std::vector<Fixed64> randomColumn(std::mt19937_64 &rng, size_t count,
+                                         double min, double max) {
+  int64_t rawMin = Fixed64(min).value;
+  uint64_t span = static_cast<uint64_t>(Fixed64(max).value - rawMin);
+  std::vector<Fixed64> column(count);
+  for (auto &value : column) {
+    value = Fixed64(static_cast<int64_t>(rawMin + rng() % span));
+  }
+  return column;
+}
+
+struct Stats {
+  double min = 0;
+  double median = 0;
+  double p90 = 0;
+  double p99 = 0;
+  double mean = 0;
+  double stddev = 0;
+};
+
+// Nearest-rank percentile of sorted samples.
+inline double percentile(const std::vector<double> &sorted, double p) {
+  size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+inline Stats computeStats(std::vector<double> samples) {
+  Stats stats;
+  std::sort(samples.begin(), samples.end());
+  stats.min = samples.front();
+  stats.median = percentile(samples, 0.5);
+  stats.p90 = percentile(samples, 0.9);
+  stats.p99 = percentile(samples, 0.99);
+  for (double sample : samples) {
+    stats.mean += sample;
+  }
+  stats.mean /= samples.size();
+  for (double sample : samples) {
+    stats.stddev += (sample - stats.mean) * (sample - stats.mean);
+  }
+  stats.stddev = std::sqrt(stats.stddev / samples.size());
+  return stats;
+}
+
+class Suite {
+ public:
+  // The body processes opsPerRun operations and returns a value that is
+  // folded into the checksum so the work cannot be optimized away.
+  using Body = std::function<int64_t()>;
+
+  Suite(std::string name, Options options)
+      : _name(std::move(name)), _options(std::move(options)) {}
+
+  const Options &options() const { return _options; }
+
+  void add(const std::string &group, const std::string &name,
+           size_t opsPerRun, Body body) {
+    _cases.push_back({group, name, opsPerRun, std::move(body), {}, 0});
+  }
+
+  // Runs all selected cases, prints a table and writes the JSON report.
+  // The table goes to stderr when the report goes to stdout. Returns the
+  // process exit code.
+  int run() {
+    FILE *table = _options.jsonPath == "-" ? stderr : stdout;
+    std::fprintf(table, "%-12s %-28s %10s %10s %10s %10s %14s\n", "group",
+                 "name", "min", "median", "p90", "p99", "ops/sec");
+    int64_t checksum = 0;
+    for (auto &benchmarkCase : _cases) {
+      std::string id = benchmarkCase.group + "/" + benchmarkCase.name;
+      if (id.find(_options.filter) == std::string::npos) {
+        continue;
+      }
+      checksum += measure(benchmarkCase);
+      const Stats &stats = benchmarkCase.stats;
+      std::fprintf(table,
+                   "%-12s %-28s %10.2f %10.2f %10.2f %10.2f %14.0f\n",
+                   benchmarkCase.group.c_str(), benchmarkCase.name.c_str(),
+                   stats.min, stats.median, stats.p90, stats.p99,
+                   1e9 / stats.median);
+    }
+    std::fprintf(table, "ns/op, checksum: %lld\n",
+                 static_cast<long long>(checksum));
+
+    if (!_options.jsonPath.empty()) {
+      return writeJson(checksum) ? 0 : 1;
+    }
+    return 0;
+  }
+
+ private:
+  struct Case {
+    std::string group;
+    std::string name;
+    size_t opsPerRun;
+    Body body;
+    Stats stats;
+    int runsPerSample;
+  };
+
+  static double elapsedNs(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+  int64_t measure(Case &benchmarkCase) {
+    int64_t sink = 0;
+
+    // Double the runs per sample until a sample takes minSampleMs.
+    int runs = 1;
+    for (;;) {
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < runs; ++i) {
+        sink += benchmarkCase.body();
+      }
+      if (elapsedNs(start) >= _options.minSampleMs * 1e6 || runs >= (1 << 20)) {
+        break;
+      }
+      runs *= 2;
+    }
+    benchmarkCase.runsPerSample = runs;
+
+    std::vector<double> samples;
+    samples.reserve(_options.repetitions);
+    for (int sample = 0; sample < _options.warmup + _options.repetitions;
+         ++sample) {
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < runs; ++i) {
+        sink += benchmarkCase.body();
+      }
+      double nsPerOp = elapsedNs(start) / (static_cast<double>(runs) *
+                                           benchmarkCase.opsPerRun);
+      if (sample >= _options.warmup) {
+        samples.push_back(nsPerOp);
+      }
+    }
+    benchmarkCase.stats = computeStats(std::move(samples));
+    return sink;
+  }
+
+  bool writeJson(int64_t checksum) const {
+    bool toStdout = _options.jsonPath == "-";
+    FILE *file = toStdout ? stdout : std::fopen(_options.jsonPath.c_str(), "w");
+    if (file == nullptr) {
+      std::fprintf(stderr, "cannot open %s\n", _options.jsonPath.c_str());
+      return false;
+    }
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"suite\": \"%s\",\n", _name.c_str());
+#ifdef __EMSCRIPTEN__
+    std::fprintf(file, "  \"platform\": \"wasm\",\n");
+#else
+    std::fprintf(file, "  \"platform\": \"native\",\n");
+#endif
+    std::fprintf(file, "  \"mathVersion\": %d,\n", FIXED64_MATH_VERSION);
+    std::fprintf(file, "  \"seed\": %llu,\n",
+                 static_cast<unsigned long long>(_options.seed));
+    std::fprintf(file, "  \"repetitions\": %d,\n", _options.repetitions);
+    std::fprintf(file, "  \"checksum\": %lld,\n",
+                 static_cast<long long>(checksum));
+    std::fprintf(file, "  \"results\": [");
+    bool first = true;
+    for (const auto &benchmarkCase : _cases) {
+      if (benchmarkCase.runsPerSample == 0) {
+        continue;
+      }
+      const Stats &stats = benchmarkCase.stats;
+      std::fprintf(file,
+                   "%s\n    {\"group\": \"%s\", \"name\": \"%s\", "
+                   "\"opsPerRun\": %zu, \"runsPerSample\": %d, "
+                   "\"nsPerOp\": {\"min\": %.3f, \"median\": %.3f, "
+                   "\"p90\": %.3f, \"p99\": %.3f, \"mean\": %.3f, "
+                   "\"stddev\": %.3f}, \"opsPerSec\": %.0f}",
+                   first ? "" : ",", benchmarkCase.group.c_str(),
+                   benchmarkCase.name.c_str(), benchmarkCase.opsPerRun,
+                   benchmarkCase.runsPerSample, stats.min, stats.median,
+                   stats.p90, stats.p99, stats.mean, stats.stddev,
+                   1e9 / stats.median);
+      first = false;
+    }
+    std::fprintf(file, "\n  ]\n}\n");
+
+    if (!toStdout) {
+      std::fclose(file);
+    }
+    return true;
+  }
+
+  std::string _name;
+  Options _options;
+  std::vector<Case> _cases;
+};
+
+}  // namespace Benchmark
+}  // namespace Skynet
@@ -0,0 +1,906 @@
+// DeterminismCheck.cpp
+// Fixed64Determinism: runs seeded input corpora through every FixedMath
+// kernel, the vector and collision tests, the batch APIs and the number and
+// decimal conversions, and records their raw int64 outputs. All build flavors
+// (native, wasm, other compilers or SIMD paths) must agree bit for bit: run
+// one flavor with --out and the others with --compare.
+//
+//   Fixed64Determinism [--samples N] [--seed S] [--filter text]
+//                      [--out report] [--compare report] [--max-mismatches K]
+//                      [--workers N]
+//
+// The corpus depends only on the seed and the case name. Values are drawn
+// uniformly from each argument's domain with std::mt19937_64, whose output
+// the standard fixes, and every 16th sample is an edge value of the domain
+// (its bounds, zero, +-1 raw, +-1 and +-0.5). Each case prints the XXH64
+// digest of its outputs, so two flavors can also be compared by their logs.
+//
+// The report keeps every output so that --compare, which takes the seed and
+// sample count from the report, can print the first mismatching samples with
+// their inputs. FIXED64_MATH_VERSION 2 changes several kernels on purpose;
+// compare it against a report of the same version. Exits with 1 on a
+// mismatch and 2 on bad arguments or an unreadable report. --workers sets
+// the JobPool size of a FIXED64_THREADS build, so that reports of different
+// worker counts can be compared as well.
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Fixed64.h"
+#include "FixedConvert.h"
+#include "FixedDecimal.h"
+#include "Fixed64Native.h"
+#include "FixedMath.h"
+#include "JobPool.h"
+#include "Plane.h"
+#include "Rect.h"
+#include "Sector.h"
+#include "StateHash.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+using namespace Skynet;
+
+namespace {
+
+constexpr uint8_t kMagic[4] = {'F', '6', '4', 'D'};
+constexpr uint8_t kVersion = 1;
+constexpr size_t kChunk = 65536;
+constexpr size_t kEdgeInterval = 16;
+
+// Raw values, inclusive
+struct Domain {
+  int64_t min;
+  int64_t max;
+};
+
+Domain range(double min, double max) {
+  return {Fixed64(min).value, Fixed64(max).value};
+}
+
+Domain integers(int64_t min, int64_t max) { return {min, max}; }
+
+// One column of raw inputs per argument
+using Columns = std::vector<std::vector<int64_t>>;
+
+struct Case {
+  std::string name;
+  std::vector<Domain> domains;
+  size_t outputs;
+  // Writes `outputs` values per sample to out
+  std::function<void(const Columns &in, size_t count, int64_t *out)> run;
+};
+
+Fixed64 fx(int64_t raw) { return Fixed64(raw); }
+
+Vector2 vector2(const int64_t *in) { return Vector2(fx(in[0]), fx(in[1])); }
+
+Vector3 vector3(const int64_t *in) {
+  return Vector3(fx(in[0]), fx(in[1]), fx(in[2]));
+}
+
+int64_t toRaw(Fixed64 value) { return value.value; }
+int64_t toRaw(int64_t value) { return value; }
+int64_t toRaw(int value) { return value; }
+int64_t toRaw(uint32_t value) { return value; }
+int64_t toRaw(bool value) { return value ? 1 : 0; }
+
+void store(const Vector2 &value, int64_t *out) {
+  out[0] = value._x.value;
+  out[1] = value._y.value;
+}
+
+void store(const Vector3 &value, int64_t *out) {
+  out[0] = value._x.value;
+  out[1] = value._y.value;
+  out[2] = value._z.value;
+}
+
+// A case evaluated one sample at a time; `func(in, out)` gets the sample's
+// arguments in domain order
+template <typename Func>
+Case perSample(std::string name, std::vector<Domain> domains, size_t outputs,
+               Func func) {
+  size_t arity = domains.size();
+  return {std::move(name), std::move(domains), outputs,
+          [arity, outputs, func](const Columns &in, size_t count,
+                                 int64_t *out) {
+            int64_t args[16];
+            for (size_t i = 0; i < count; ++i) {
+              for (size_t k = 0; k < arity; ++k) {
+                args[k] = in[k][i];
+              }
+              func(args, out + i * outputs);
+            }
+          }};
+}
+
+template <typename Func>
+Case unary(std::string name, Domain domain, Func func) {
+  return perSample(std::move(name), {domain}, 1,
+                   [func](const int64_t *in, int64_t *out) {
+                     out[0] = toRaw(func(fx(in[0])));
+                   });
+}
+
+template <typename Func>
+Case binary(std::string name, Domain a, Domain b, Func func) {
+  return perSample(std::move(name), {a, b}, 1,
+                   [func](const int64_t *in, int64_t *out) {
+                     out[0] = toRaw(func(fx(in[0]), fx(in[1])));
+                   });
+}
+
+template <typename Func>
+Case ternary(std::string name, Domain a, Domain b, Domain c, Func func) {
+  return perSample(std::move(name), {a, b, c}, 1,
+                   [func](const int64_t *in, int64_t *out) {
+                     out[0] = toRaw(func(fx(in[0]), fx(in[1]), fx(in[2])));
+                   });
+}
+
+// Doubles for the conversion cases: an integer part and 40 more bits of
+// fraction, both exact in a double
+double toDouble(int64_t raw, int64_t fraction) {
+  return static_cast<double>(raw) * 0x1p-16 +
+         static_cast<double>(fraction) * 0x1p-40;
+}
+
+std::vector<Case> makeCases() {
+  // Fixed64 multiplies raw values without widening, so products of `large`
+  // values would overflow; `medium` values square safely
+  const Domain large = range(-1073741824.0, 1073741824.0);
+  const Domain medium = range(-30000.0, 30000.0);
+  const Domain small = range(-200.0, 200.0);
+  const Domain positive = range(0.001, 30000.0);
+  const Domain positiveLarge = integers(1, Fixed64(1073741824.0).value);
+  const Domain unit = range(0.0, 1.0);
+  const Domain symmetricUnit = range(-1.0, 1.0);
+  const Domain radians = range(-25.0, 25.0);
+  const Domain degrees = range(-360.0, 360.0);
+  const Domain expArgs = range(-11.9, 20.0);
+  const Domain powBases = range(0.01, 16.0);
+  const Domain powExponents = range(-8.0, 8.0);
+  const Domain pow2Args = range(-16.0, 30.0);
+  const Domain radii = range(0.5, 20.0);
+  const Domain fraction = integers(-(1LL << 24), 1LL << 24);
+  const Domain flag = integers(0, 1);
+
+  std::vector<Case> cases;
+
+  // Fixed64 arithmetic
+  cases.push_back(binary("fixed64.add", large, large,
+                         [](Fixed64 a, Fixed64 b) { return a + b; }));
+  cases.push_back(binary("fixed64.sub", large, large,
+                         [](Fixed64 a, Fixed64 b) { return a - b; }));
+  cases.push_back(binary("fixed64.mul", small, small,
+                         [](Fixed64 a, Fixed64 b) { return a * b; }));
+  cases.push_back(binary("fixed64.div", small, small,
+                         [](Fixed64 a, Fixed64 b) { return a / b; }));
+  cases.push_back(binary("fixed64.mod", small, small, [](Fixed64 a, Fixed64 b) {
+    return b.value == 0 ? b : a % b;
+  }));
+
+  // Rounding, sign and clamping
+  cases.push_back(unary("fixedmath.Abs", large, FixedMath::Abs));
+  cases.push_back(unary("fixedmath.Sign", large, FixedMath::Sign));
+  cases.push_back(unary("fixedmath.Floor", large, FixedMath::Floor));
+  cases.push_back(unary("fixedmath.Ceil", large, FixedMath::Ceil));
+  cases.push_back(unary("fixedmath.Round", large, FixedMath::Round));
+  cases.push_back(unary("fixedmath.FloorToInt", large, FixedMath::FloorToInt));
+  cases.push_back(unary("fixedmath.CeilToInt", large, FixedMath::CeilToInt));
+  cases.push_back(unary("fixedmath.RoundToInt", large, FixedMath::RoundToInt));
+  cases.push_back(unary("fixedmath.Fractions", large, FixedMath::Fractions));
+  cases.push_back(binary("fixedmath.Min", large, large, FixedMath::Min));
+  cases.push_back(binary("fixedmath.Max", large, large, FixedMath::Max));
+  cases.push_back(unary("fixedmath.Clamp", small, [](Fixed64 x) {
+    return FixedMath::Clamp(x, Fixed64(-100), Fixed64(100));
+  }));
+  cases.push_back(unary("fixedmath.Clamp01", symmetricUnit, FixedMath::Clamp01));
+  cases.push_back(binary("fixedmath.IsOppositeSign", small, small,
+                         FixedMath::IsOppositeSign));
+  cases.push_back(
+      binary("fixedmath.SetSameSign", small, small, FixedMath::SetSameSign));
+
+  // Interpolation
+  cases.push_back(
+      ternary("fixedmath.Lerp", small, small, unit, FixedMath::Lerp));
+  cases.push_back(ternary("fixedmath.LerpUnclamped", small, small, unit,
+                          FixedMath::LerpUnclamped));
+  cases.push_back(ternary("fixedmath.InverseLerp", small, small, small,
+                          FixedMath::InverseLerp));
+  cases.push_back(ternary("fixedmath.LerpAngle", degrees, degrees, unit,
+                          FixedMath::LerpAngle));
+  cases.push_back(
+      binary("fixedmath.Repeat", small, positive, FixedMath::Repeat));
+  cases.push_back(unary("fixedmath.NormalizeRadians", degrees,
+                        FixedMath::NormalizeRadians));
+
+  // Roots and reciprocals
+  cases.push_back(unary("fixedmath.Sqrt", positive, FixedMath::Sqrt));
+  cases.push_back(unary("fixedmath.Sqrt.large", positiveLarge, FixedMath::Sqrt));
+  cases.push_back(unary("fixedmath.SqrtV1", positiveLarge, FixedMath::SqrtV1));
+  cases.push_back(unary("fixedmath.SqrtV2", positiveLarge, FixedMath::SqrtV2));
+  cases.push_back(unary("fixedmath.Rsqrt", positive, FixedMath::Rsqrt));
+  cases.push_back(unary("fixedmath.Rcp", positive, FixedMath::Rcp));
+  cases.push_back(perSample("fixedmath.Normalize2", {small, small}, 2,
+                            [](const int64_t *in, int64_t *out) {
+                              Fixed64 components[2] = {fx(in[0]), fx(in[1])};
+                              FixedMath::Normalize(components);
+                              out[0] = components[0].value;
+                              out[1] = components[1].value;
+                            }));
+  cases.push_back(perSample("fixedmath.Normalize3", {small, small, small}, 3,
+                            [](const int64_t *in, int64_t *out) {
+                              Fixed64 components[3] = {fx(in[0]), fx(in[1]),
+                                                       fx(in[2])};
+                              FixedMath::Normalize(components);
+                              for (int k = 0; k < 3; ++k) {
+                                out[k] = components[k].value;
+                              }
+                            }));
+
+  // Trigonometry
+  cases.push_back(unary("fixedmath.Sin", radians, FixedMath::Sin));
+  cases.push_back(unary("fixedmath.Cos", radians, FixedMath::Cos));
+  cases.push_back(unary("fixedmath.Tan", radians, FixedMath::Tan));
+  cases.push_back(unary("fixedmath.Asin", symmetricUnit, FixedMath::Asin));
+  cases.push_back(unary("fixedmath.Acos", symmetricUnit, FixedMath::Acos));
+  cases.push_back(unary("fixedmath.Atan", small, FixedMath::Atan));
+  cases.push_back(unary("fixedmath.AtanApproximated", symmetricUnit,
+                        FixedMath::AtanApproximated));
+  cases.push_back(binary("fixedmath.Atan2", small, small, FixedMath::Atan2));
+  cases.push_back(
+      binary("fixedmath.Atan2.medium", medium, medium, FixedMath::Atan2));
+  cases.push_back(binary("fixedmath.Atan2V1", small, small, FixedMath::Atan2V1));
+  cases.push_back(binary("fixedmath.Atan2V2", small, small, FixedMath::Atan2V2));
+  cases.push_back(
+      binary("fixedmath.Atan2Deg", small, small, FixedMath::Atan2Deg));
+  cases.push_back(perSample("fixedmath.Atan2Heading",
+                            {small, small, integers(1, 16)}, 1,
+                            [](const int64_t *in, int64_t *out) {
+                              out[0] = FixedMath::Atan2Heading(
+                                  fx(in[0]), fx(in[1]), static_cast<int>(in[2]));
+                            }));
+
+  // Exponentials, logarithms and powers
+  cases.push_back(unary("fixedmath.Exp", expArgs, FixedMath::Exp));
+  cases.push_back(unary("fixedmath.ExpV1", expArgs, FixedMath::ExpV1));
+  cases.push_back(unary("fixedmath.ExpV2", expArgs, FixedMath::ExpV2));
+  cases.push_back(unary("fixedmath.ExpApproximated", expArgs,
+                        FixedMath::ExpApproximated));
+  cases.push_back(unary("fixedmath.Log2", positive, FixedMath::Log2));
+  cases.push_back(unary("fixedmath.Ln", positive, FixedMath::Ln));
+  cases.push_back(
+      binary("fixedmath.Pow", powBases, powExponents, FixedMath::Pow));
+  cases.push_back(unary("fixedmath.Pow2", pow2Args,
+                        [](Fixed64 x) { return FixedMath::Pow2(x); }));
+  cases.push_back(perSample("fixedmath.PowInt", {powBases, integers(-4, 4)}, 1,
+                            [](const int64_t *in, int64_t *out) {
+                              out[0] = FixedMath::PowInt(
+                                           fx(in[0]), static_cast<int>(in[1]))
+                                           .value;
+                            }));
+  cases.push_back(unary("fixedmath.Log2Int", positive, FixedMath::Log2Int));
+  cases.push_back(perSample("fixedmath.Frexp", {large}, 2,
+                            [](const int64_t *in, int64_t *out) {
+                              int exponent;
+                              out[0] = FixedMath::Frexp(fx(in[0]), exponent).value;
+                              out[1] = exponent;
+                            }));
+
+  // Vector ops
+  cases.push_back(perSample("vector2.normalize", {small, small}, 2,
+                            [](const int64_t *in, int64_t *out) {
+                              Vector2 vector = vector2(in);
+                              store(vector.normalize(), out);
+                            }));
+  cases.push_back(perSample("vector2.len", {medium, medium}, 1,
+                            [](const int64_t *in, int64_t *out) {
+                              out[0] = vector2(in).len().value;
+                            }));
+  cases.push_back(perSample("vector2.dot", {small, small, small, small}, 1,
+                            [](const int64_t *in, int64_t *out) {
+                              out[0] = Vector2::dot(vector2(in), vector2(in + 2))
+                                           .value;
+                            }));
+  cases.push_back(perSample("vector3.normalize", {small, small, small}, 3,
+                            [](const int64_t *in, int64_t *out) {
+                              Vector3 vector = vector3(in);
+                              vector.normalize();
+                              store(vector, out);
+                            }));
+  cases.push_back(perSample("vector3.length", {small, small, small}, 1,
+                            [](const int64_t *in, int64_t *out) {
+                              out[0] = vector3(in).length().value;
+                            }));
+  cases.push_back(perSample(
+      "vector3.squaredDistance", {small, small, small, small, small, small}, 1,
+      [](const int64_t *in, int64_t *out) {
+        out[0] = Vector3::squaredDistance(vector3(in), vector3(in + 3)).value;
+      }));
+  cases.push_back(perSample("vector3.rotate",
+                            {small, small, small, small, small, small, degrees},
+                            9, [](const int64_t *in, int64_t *out) {
+                              Vector3 vv = vector3(in);
+                              Vector3 vo = vector3(in + 3);
+                              store(Vector3::rotateX(vv, vo, fx(in[6])), out);
+                              store(Vector3::rotateY(vv, vo, fx(in[6])), out + 3);
+                              store(Vector3::rotateZ(vv, vo, fx(in[6])), out + 6);
+                            }));
+  cases.push_back(perSample(
+      "vector3.calculateAngle", {small, small, small, small, small, small}, 1,
+      [](const int64_t *in, int64_t *out) {
+        out[0] = Vector3::calculateAngle(vector3(in), vector3(in + 3)).value;
+      }));
+  cases.push_back(perSample(
+      "vector3.pointToLineSegmentDistanceSqr",
+      {small, small, small, small, small, small, small, small, small}, 1,
+      [](const int64_t *in, int64_t *out) {
+        out[0] = Vector3::pointToLineSegmentDistanceSqr(
+                     vector3(in), vector3(in + 3), vector3(in + 6))
+                     .value;
+      }));
+  cases.push_back(perSample(
+      "vector3.decayKnockbackVector", {small, small, small, unit, radii}, 3,
+      [](const int64_t *in, int64_t *out) {
+        store(Vector3::decayKnockbackVector(vector3(in), fx(in[3]), fx(in[4])),
+              out);
+      }));
+
+  // Collision tests
+  cases.push_back(perSample(
+      "collision.Vector2.checkCircleOverlap",
+      {small, small, small, small, radii, radii}, 2,
+      [](const int64_t *in, int64_t *out) {
+        Fixed64 distSquared;
+        out[0] = Vector2::checkCircleOverlap(vector2(in), vector2(in + 2),
+                                             fx(in[4]), fx(in[5]), &distSquared);
+        out[1] = distSquared.value;
+      }));
+  cases.push_back(perSample(
+      "collision.Vector2.checkLineSegmentIntersectsCircle",
+      {small, small, radii, small, small, small, small}, 1,
+      [](const int64_t *in, int64_t *out) {
+        out[0] = Vector2::checkLineSegmentIntersectsCircle(
+            vector2(in), fx(in[2]), vector2(in + 3), vector2(in + 5));
+      }));
+  cases.push_back(perSample(
+      "collision.Vector3.checkCircleOverlap",
+      {small, small, small, small, small, small, radii, radii, flag}, 2,
+      [](const int64_t *in, int64_t *out) {
+        Fixed64 distSquared;
+        out[0] = Vector3::checkCircleOverlap(vector3(in), vector3(in + 3),
+                                             fx(in[6]), fx(in[7]), in[8] != 0,
+                                             &distSquared);
+        out[1] = distSquared.value;
+      }));
+  cases.push_back(perSample(
+      "collision.Vector3.checkRingCircleOverlap",
+      {small, small, small, radii, radii, small, small, small, radii, flag}, 1,
+      [](const int64_t *in, int64_t *out) {
+        Fixed64 inner = FixedMath::Min(fx(in[3]), fx(in[4]));
+        Fixed64 outer = FixedMath::Max(fx(in[3]), fx(in[4]));
+        out[0] = Vector3::checkRingCircleOverlap(
+            vector3(in), inner, outer, vector3(in + 5), fx(in[8]), in[9] != 0);
+      }));
+  cases.push_back(perSample(
+      "collision.Vector3.checkLineCircleIntersect",
+      {small, small, small, small, small, small, small, small, small, radii}, 1,
+      [](const int64_t *in, int64_t *out) {
+        out[0] = Vector3::checkLineCircleIntersect(
+            vector3(in), vector3(in + 3), vector3(in + 6), fx(in[9]));
+      }));
+  // Rects and sectors from a center, a size and an unnormalized direction
+  const std::vector<Domain> shape = {small,         small,        small,
+                                     radii,         radii,        symmetricUnit,
+                                     symmetricUnit, symmetricUnit};
+  auto addRectCases = [&]<Plane P>(const std::string &suffix) {
+    auto makeRect = [](const int64_t *in) {
+      Vector3 direction = vector3(in + 5);
+      direction.normalize();
+      return Rect::onPlane<P>(vector3(in), fx(in[3]), fx(in[4]), direction);
+    };
+    std::vector<Domain> rectCircle = shape;
+    rectCircle.insert(rectCircle.end(), {small, small, small, radii});
+    cases.push_back(perSample(
+        "collision.Rect.overlapsWithCircle" + suffix, rectCircle, 1,
+        [makeRect](const int64_t *in, int64_t *out) {
+          out[0] = makeRect(in).template overlapsWithCircle<P>(vector3(in + 8),
+                                                               fx(in[11]));
+        }));
+    std::vector<Domain> rectRect = shape;
+    rectRect.insert(rectRect.end(), shape.begin(), shape.end());
+    cases.push_back(perSample(
+        "collision.Rect.overlapsWithRect" + suffix, rectRect, 1,
+        [makeRect](const int64_t *in, int64_t *out) {
+          out[0] = makeRect(in).overlapsWithRect(makeRect(in + 8));
+        }));
+    std::vector<Domain> rectPoint = shape;
+    rectPoint.insert(rectPoint.end(), {small, small, small});
+    cases.push_back(perSample(
+        "collision.Rect.containsPoint" + suffix, rectPoint, 1,
+        [makeRect](const int64_t *in, int64_t *out) {
+          out[0] = makeRect(in).template containsPoint<P>(vector3(in + 8));
+        }));
+  };
+  addRectCases.template operator()<Plane::XY>(".2d");
+  addRectCases.template operator()<Plane::XZ>(".3d");
+  cases.push_back(perSample(
+      "collision.Sector.overlapsWithCircle",
+      {small, small, small, symmetricUnit, symmetricUnit, symmetricUnit,
+       range(0.0, 180.0), radii, small, small, small, radii},
+      1, [](const int64_t *in, int64_t *out) {
+        Vector3 direction = vector3(in + 3);
+        direction.normalize();
+        Sector sector;
+        sector.init(vector3(in), direction, fx(in[6]), fx(in[7]));
+        out[0] = sector.overlapsWithCircle(vector3(in + 8), fx(in[11]));
+      }));
+
+  // Batch APIs, which may take different code paths than the scalar ones.
+  // They go through the entry points, so threaded builds split them across
+  // the JobPool.
+  cases.push_back({"batch.Atan2Many", {small, small}, 1,
+                   [](const Columns &in, size_t count, int64_t *out) {
+                     Fixed64Native::atan2Many(
+                         reinterpret_cast<uintptr_t>(in[0].data()),
+                         reinterpret_cast<uintptr_t>(in[1].data()),
+                         reinterpret_cast<uintptr_t>(out),
+                         static_cast<uint32_t>(count));
+                   }});
+  cases.push_back({"batch.Atan2DegMany", {small, small}, 1,
+                   [](const Columns &in, size_t count, int64_t *out) {
+                     Fixed64Native::atan2DegMany(
+                         reinterpret_cast<uintptr_t>(in[0].data()),
+                         reinterpret_cast<uintptr_t>(in[1].data()),
+                         reinterpret_cast<uintptr_t>(out),
+                         static_cast<uint32_t>(count));
+                   }});
+  cases.push_back({"batch.Atan2HeadingMany", {small, small}, 1,
+                   [](const Columns &in, size_t count, int64_t *out) {
+                     std::vector<uint32_t> headings(count);
+                     Fixed64Native::atan2HeadingMany(
+                         reinterpret_cast<uintptr_t>(in[0].data()),
+                         reinterpret_cast<uintptr_t>(in[1].data()),
+                         reinterpret_cast<uintptr_t>(headings.data()),
+                         static_cast<uint32_t>(count), 12);
+                     std::copy(headings.begin(), headings.end(), out);
+                   }});
+  cases.push_back({"batch.Vector2.normalizeMany", {small, small}, 2,
+                   [](const Columns &in, size_t count, int64_t *out) {
+                     std::vector<int64_t> xs = in[0];
+                     std::vector<int64_t> ys = in[1];
+                     Vector2::normalizeMany(reinterpret_cast<uintptr_t>(xs.data()),
+                                            reinterpret_cast<uintptr_t>(ys.data()),
+                                            static_cast<uint32_t>(count));
+                     for (size_t i = 0; i < count; ++i) {
+                       out[i * 2] = xs[i];
+                       out[i * 2 + 1] = ys[i];
+                     }
+                   }});
+  cases.push_back({"batch.Vector3.normalizeMany", {small, small, small}, 3,
+                   [](const Columns &in, size_t count, int64_t *out) {
+                     std::vector<int64_t> xs = in[0];
+                     std::vector<int64_t> ys = in[1];
+                     std::vector<int64_t> zs = in[2];
+                     Vector3::normalizeMany(reinterpret_cast<uintptr_t>(xs.data()),
+                                            reinterpret_cast<uintptr_t>(ys.data()),
+                                            reinterpret_cast<uintptr_t>(zs.data()),
+                                            static_cast<uint32_t>(count));
+                     for (size_t i = 0; i < count; ++i) {
+                       out[i * 3] = xs[i];
+                       out[i * 3 + 1] = ys[i];
+                       out[i * 3 + 2] = zs[i];
+                     }
+                   }});
+
+  // Number conversion, in every rounding mode and for floats
+  for (FixedRounding mode :
+       {FixedRounding::Floor, FixedRounding::Truncate, FixedRounding::Nearest,
+        FixedRounding::LegacyFloor}) {
+    static const char *const kModeNames[] = {"floor", "truncate", "nearest",
+                                             "legacyFloor"};
+    cases.push_back({std::string("convert.fromDoubles.") +
+                         kModeNames[static_cast<int>(mode)],
+                     {large, fraction}, 1,
+                     [mode](const Columns &in, size_t count, int64_t *out) {
+                       std::vector<double> values(count);
+                       for (size_t i = 0; i < count; ++i) {
+                         values[i] = toDouble(in[0][i], in[1][i]);
+                       }
+                       FixedConvert::fromDoubles(values.data(), count, out,
+                                                 mode);
+                     }});
+  }
+  cases.push_back(perSample("convert.fromFloat", {large, fraction}, 1,
+                            [](const int64_t *in, int64_t *out) {
+                              out[0] = FixedConvert::fromFloat(
+                                  static_cast<float>(toDouble(in[0], in[1])));
+                            }));
+  cases.push_back(perSample("convert.toDouble", {large}, 1,
+                            [](const int64_t *in, int64_t *out) {
+                              out[0] = std::bit_cast<int64_t>(
+                                  static_cast<double>(fx(in[0])));
+                            }));
+
+  // Decimal text; toChars is recorded as a hash of the text
+  cases.push_back(perSample("decimal.toChars", {large, integers(0, 16)}, 1,
+                            [](const int64_t *in, int64_t *out) {
+                              char text[FixedDecimal::kMaxLength];
+                              size_t length = FixedDecimal::format(
+                                  in[0], text, sizeof(text),
+                                  static_cast<int>(in[1]));
+                              StateHash hash;
+                              hash.update(text, length);
+                              out[0] = static_cast<int64_t>(hash.digest());
+                            }));
+  cases.push_back(perSample("decimal.fromChars", {large, integers(0, 16)}, 1,
+                            [](const int64_t *in, int64_t *out) {
+                              char text[FixedDecimal::kMaxLength];
+                              size_t length = FixedDecimal::format(
+                                  in[0], text, sizeof(text),
+                                  static_cast<int>(in[1]));
+                              int64_t parsed = 0;
+                              FixedDecimal::parse(text, length, parsed);
+                              out[0] = parsed;
+                            }));
+  return cases;
+}
+
+// Fills the next `count` samples of the corpus
+class Corpus {
+ public:
+  Corpus(const Case &testCase, uint64_t seed)
+      : _rng(seed ^ caseHash(testCase.name)), _domains(testCase.domains) {
+    for (const Domain &domain : _domains) {
+      std::vector<int64_t> edges;
+      for (int64_t value : {domain.min, domain.max, int64_t{0}, int64_t{1},
+                            int64_t{-1}, Fixed64Const::One.value,
+                            -Fixed64Const::One.value, Fixed64Const::Point5.value,
+                            -Fixed64Const::Point5.value}) {
+        if (value >= domain.min && value <= domain.max) {
+          edges.push_back(value);
+        }
+      }
+      _edges.push_back(std::move(edges));
+    }
+  }
+
+  void next(Columns &columns, size_t count) {
+    columns.resize(_domains.size());
+    for (auto &column : columns) {
+      column.resize(count);
+    }
+    for (size_t i = 0; i < count; ++i, ++_index) {
+      bool edge = _index % kEdgeInterval == kEdgeInterval - 1;
+      for (size_t k = 0; k < _domains.size(); ++k) {
+        columns[k][i] = edge ? _edges[k][_rng() % _edges[k].size()]
+                             : uniform(_domains[k]);
+      }
+    }
+  }
+
+ private:
+  static uint64_t caseHash(const std::string &name) {
+    StateHash hash;
+    hash.update(name.data(), name.size());
+    return hash.digest();
+  }
+
+  int64_t uniform(const Domain &domain) {
+    uint64_t span = static_cast<uint64_t>(domain.max) -
+                    static_cast<uint64_t>(domain.min) + 1;
+    return static_cast<int64_t>(static_cast<uint64_t>(domain.min) +
+                                _rng() % span);
+  }
+
+  std::mt19937_64 _rng;
+  std::vector<Domain> _domains;
+  std::vector<std::vector<int64_t>> _edges;
+  uint64_t _index = 0;
+};
+
+// Reference report, loaded whole
+class Report {
+ public:
+  struct Entry {
+    size_t outputs;
+    uint64_t count;
+    const uint8_t *values;
+    uint64_t digest;
+  };
+
+  bool load(const char *path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      return false;
+    }
+    _data.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+    size_t offset = 0;
+    if (_data.size() < 22 || std::memcmp(_data.data(), kMagic, 4) != 0 ||
+        _data[4] != kVersion) {
+      return false;
+    }
+    mathVersion = _data[5];
+    seed = read64(6);
+    samples = read64(14);
+    offset = 22;
+    while (offset < _data.size()) {
+      uint64_t nameLength = read64(offset);
+      offset += 8;
+      if (nameLength > _data.size() - offset) {
+        return false;
+      }
+      std::string name(reinterpret_cast<const char *>(&_data[offset]),
+                       nameLength);
+      offset += nameLength;
+      if (_data.size() - offset < 17) {
+        return false;
+      }
+      Entry entry;
+      entry.outputs = _data[offset++];
+      entry.count = read64(offset);
+      offset += 8;
+      uint64_t bytes = entry.count * entry.outputs * 8;
+      if (bytes > _data.size() - offset || _data.size() - offset - bytes < 8) {
+        return false;
+      }
+      entry.values = &_data[offset];
+      offset += bytes;
+      entry.digest = read64(offset);
+      offset += 8;
+      _entries[name] = entry;
+    }
+    return true;
+  }
+
+  const Entry *find(const std::string &name) const {
+    auto it = _entries.find(name);
+    return it == _entries.end() ? nullptr : &it->second;
+  }
+
+  static int64_t value(const Entry &entry, uint64_t index) {
+    uint64_t raw = 0;
+    for (int i = 0; i < 8; ++i) {
+      raw |= static_cast<uint64_t>(entry.values[index * 8 + i]) << (8 * i);
+    }
+    return static_cast<int64_t>(raw);
+  }
+
+  uint8_t mathVersion = 0;
+  uint64_t seed = 0;
+  uint64_t samples = 0;
+
+ private:
+  uint64_t read64(size_t offset) const {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+      value |= static_cast<uint64_t>(_data[offset + i]) << (8 * i);
+    }
+    return value;
+  }
+
+  std::vector<uint8_t> _data;
+  std::unordered_map<std::string, Entry> _entries;
+};
+
+void write64(std::ofstream &out, uint64_t value) {
+  uint8_t bytes[8];
+  for (int i = 0; i < 8; ++i) {
+    bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+  out.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+}
+
+std::string describe(int64_t raw) {
+  char text[FixedDecimal::kMaxLength];
+  FixedDecimal::format(raw, text, sizeof(text), FixedDecimal::kMaxDigits);
+  return std::to_string(raw) + " (" + text + ")";
+}
+
+struct Options {
+  uint64_t samples = 100000;
+  uint64_t seed = 1;
+  std::string filter;
+  const char *out = nullptr;
+  const char *compare = nullptr;
+  uint64_t maxMismatches = 5;
+  // JobPool workers, -1 for the pool's default
+  int64_t workers = -1;
+};
+
+bool parseOptions(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; ++i) {
+    bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--samples") == 0 && hasValue) {
+      options.samples = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+      options.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+      options.filter = argv[++i];
+    } else if (std::strcmp(argv[i], "--out") == 0 && hasValue) {
+      options.out = argv[++i];
+    } else if (std::strcmp(argv[i], "--compare") == 0 && hasValue) {
+      options.compare = argv[++i];
+    } else if (std::strcmp(argv[i], "--max-mismatches") == 0 && hasValue) {
+      options.maxMismatches = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--workers") == 0 && hasValue) {
+      options.workers = std::strtoll(argv[++i], nullptr, 10);
+    } else {
+      return false;
+    }
+  }
+  return options.samples > 0;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::fprintf(stderr,
+                 "usage: Fixed64Determinism [--samples N] [--seed S] "
+                 "[--filter text] [--out report] [--compare report] "
+                 "[--max-mismatches K] [--workers N]\n");
+    return 2;
+  }
+  if (options.workers >= 0) {
+    JobPool::setWorkerCount(static_cast<uint32_t>(options.workers));
+  }
+
+  Report reference;
+  if (options.compare) {
+    if (!reference.load(options.compare)) {
+      std::fprintf(stderr, "%s: not a readable determinism report\n",
+                   options.compare);
+      return 2;
+    }
+    options.seed = reference.seed;
+    options.samples = reference.samples;
+    if (reference.mathVersion != FIXED64_MATH_VERSION) {
+      std::fprintf(stderr,
+                   "warning: report is FIXED64_MATH_VERSION %u, this build %d\n",
+                   reference.mathVersion, FIXED64_MATH_VERSION);
+    }
+  }
+
+  std::ofstream out;
+  if (options.out) {
+    out.open(options.out, std::ios::binary);
+    if (!out) {
+      std::fprintf(stderr, "cannot write %s\n", options.out);
+      return 2;
+    }
+    out.write(reinterpret_cast<const char *>(kMagic), sizeof(kMagic));
+    out.put(static_cast<char>(kVersion));
+    out.put(static_cast<char>(FIXED64_MATH_VERSION));
+    write64(out, options.seed);
+    write64(out, options.samples);
+  }
+
+  std::printf("seed %llu, %llu samples per case, FIXED64_MATH_VERSION %d\n",
+              static_cast<unsigned long long>(options.seed),
+              static_cast<unsigned long long>(options.samples),
+              FIXED64_MATH_VERSION);
+  auto start = std::chrono::steady_clock::now();
+  uint64_t totalSamples = 0;
+  size_t mismatchedCases = 0;
+  Columns inputs;
+  std::vector<int64_t> outputs;
+  std::vector<uint8_t> bytes;
+  for (const Case &testCase : makeCases()) {
+    if (testCase.name.find(options.filter) == std::string::npos) {
+      continue;
+    }
+    const Report::Entry *expected =
+        options.compare ? reference.find(testCase.name) : nullptr;
+    if (expected && (expected->count != options.samples ||
+                     expected->outputs != testCase.outputs)) {
+      std::printf("%-52s shape differs from the report\n",
+                  testCase.name.c_str());
+      ++mismatchedCases;
+      continue;
+    }
+    if (out.is_open()) {
+      write64(out, testCase.name.size());
+      out.write(testCase.name.data(),
+                static_cast<std::streamsize>(testCase.name.size()));
+      out.put(static_cast<char>(testCase.outputs));
+      write64(out, options.samples);
+    }
+
+    Corpus corpus(testCase, options.seed);
+    StateHash digest;
+    uint64_t mismatches = 0;
+    for (uint64_t done = 0; done < options.samples;) {
+      size_t count = static_cast<size_t>(
+          std::min<uint64_t>(kChunk, options.samples - done));
+      corpus.next(inputs, count);
+      outputs.assign(count * testCase.outputs, 0);
+      testCase.run(inputs, count, outputs.data());
+      digest.updateRaw(outputs.data(), outputs.size());
+      if (out.is_open()) {
+        bytes.resize(outputs.size() * 8);
+        for (size_t i = 0; i < outputs.size(); ++i) {
+          for (int b = 0; b < 8; ++b) {
+            bytes[i * 8 + b] =
+                static_cast<uint8_t>(static_cast<uint64_t>(outputs[i]) >> (8 * b));
+          }
+        }
+        out.write(reinterpret_cast<const char *>(bytes.data()),
+                  static_cast<std::streamsize>(bytes.size()));
+      }
+      if (expected) {
+        for (size_t i = 0; i < count; ++i) {
+          uint64_t sample = done + i;
+          bool same = true;
+          for (size_t k = 0; k < testCase.outputs; ++k) {
+            same &= Report::value(*expected, sample * testCase.outputs + k) ==
+                    outputs[i * testCase.outputs + k];
+          }
+          if (same || mismatches++ >= options.maxMismatches) {
+            continue;
+          }
+          std::printf("  %s sample %llu, inputs", testCase.name.c_str(),
+                      static_cast<unsigned long long>(sample));
+          for (const auto &column : inputs) {
+            std::printf(" %s", describe(column[i]).c_str());
+          }
+          std::printf("\n");
+          for (size_t k = 0; k < testCase.outputs; ++k) {
+            int64_t want =
+                Report::value(*expected, sample * testCase.outputs + k);
+            int64_t got = outputs[i * testCase.outputs + k];
+            std::printf("    output %zu: expected %s, actual %s%s\n", k,
+                        describe(want).c_str(), describe(got).c_str(),
+                        want == got ? "" : " <");
+          }
+        }
+      }
+      done += count;
+    }
+    if (out.is_open()) {
+      write64(out, digest.digest());
+    }
+    totalSamples += options.samples;
+
+    const char *status = "";
+    std::string mismatchText;
+    if (options.compare && !expected) {
+      status = "not in report";
+    } else if (mismatches > 0) {
+      mismatchText = std::to_string(mismatches) + " MISMATCHES";
+      status = mismatchText.c_str();
+      ++mismatchedCases;
+    } else if (expected) {
+      status = "ok";
+    }
+    std::printf("%-52s %016llx %s\n", testCase.name.c_str(),
+                static_cast<unsigned long long>(digest.digest()), status);
+  }
+
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  std::printf("%llu samples in %.1f s\n",
+              static_cast<unsigned long long>(totalSamples), seconds);
+  if (options.compare) {
+    std::printf(mismatchedCases == 0 ? "all cases match %s\n"
+                                     : "cases differ from %s\n",
+                options.compare);
+  }
+  return mismatchedCases == 0 ? 0 : 1;
+}
@@ -0,0 +1,243 @@
+// ExportTypings.cpp
+// Fixed64ExportTypings: writes Fixed64Exports.ts, the typed entry points of
+// the wasm module, from the lists in EntryPoints.h (see CExports.h).
+//
+//   Fixed64ExportTypings [--out file]...
+//
+// Without --out the module goes to stdout. The export-typings target
+// regenerates the esm and cjs copies under src/.
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Arena.h"
+#include "CExports.h"
+#include "EntityTable.h"
+#include "Fixed64Native.h"
+#include "JobPool.h"
+#include "Rect.h"
+#include "Sector.h"
+#include "SimContext.h"
+#include "Snapshot.h"
+#include "StateHash.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+using namespace Skynet;
+
+namespace {
+
+struct Entry {
+  std::string owner;
+  std::string name;
+  std::vector<std::string> parameters;
+  std::string result;
+  // Converts the raw wasm result into what embind returns
+  std::string conversion;
+  bool exported;
+};
+
+template <typename T>
+std::string typeName() {
+  if constexpr (std::is_void_v<T>) {
+    return "void";
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return "boolean";
+  } else if constexpr (std::is_same_v<T, std::string>) {
+    return "string";
+  } else {
+    static_assert(std::is_arithmetic_v<T>, "no TS type for this parameter");
+    return "number";
+  }
+}
+
+template <typename T>
+std::string conversion() {
+  if constexpr (std::is_same_v<T, bool>) {
+    return " !== 0";
+  } else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>) {
+    // Unsigned 32-bit results arrive as signed wasm i32 values
+    return " >>> 0";
+  } else {
+    return "";
+  }
+}
+
+template <auto Function>
+struct Describe;
+
+template <typename R, typename... Args, R (*Function)(Args...)>
+struct Describe<Function> {
+  static Entry entry(const char *owner, const char *name) {
+    Entry entry{owner, name, {typeName<std::decay_t<Args>>()...},
+                typeName<std::decay_t<R>>(), conversion<std::decay_t<R>>(),
+                CExportable<Function>::value &&
+                    !kPlaceholderEntryPoint<Function>};
+    return entry;
+  }
+};
+
+std::vector<Entry> entries() {
+  return {
+#define FIXED64_DESCRIBE_ENTRY(owner, name, fn) \
+  Describe<fn>::entry(#owner, #name),
+      FIXED64_ENTRY_POINTS(FIXED64_DESCRIBE_ENTRY)
+#undef FIXED64_DESCRIBE_ENTRY
+  };
+}
+
+// The embind owner of an entry; free functions live on the module itself
+std::string embindOwner(const Entry &entry) {
+  return entry.owner == "Module" ? "module" : "module." + entry.owner;
+}
+
+std::string parameterList(const Entry &entry) {
+  std::string text;
+  for (size_t i = 0; i < entry.parameters.size(); ++i) {
+    if (i > 0) {
+      text += ", ";
+    }
+    text += "a" + std::to_string(i) + ": " + entry.parameters[i];
+  }
+  return text;
+}
+
+std::string argumentList(const Entry &entry) {
+  std::string text;
+  for (size_t i = 0; i < entry.parameters.size(); ++i) {
+    if (i > 0) {
+      text += ", ";
+    }
+    text += "a" + std::to_string(i);
+  }
+  return text;
+}
+
+// Entries grouped by owner, in list order
+std::vector<std::vector<size_t>> owners(const std::vector<Entry> &entries) {
+  std::vector<std::vector<size_t>> groups;
+  std::vector<std::string> names;
+  for (size_t id = 0; id < entries.size(); ++id) {
+    size_t group = 0;
+    while (group < names.size() && names[group] != entries[id].owner) {
+      ++group;
+    }
+    if (group == names.size()) {
+      names.push_back(entries[id].owner);
+      groups.emplace_back();
+    }
+    groups[group].push_back(id);
+  }
+  return groups;
+}
+
+std::string generate() {
+  std::vector<Entry> all = entries();
+  std::vector<std::vector<size_t>> groups = owners(all);
+  std::string ts;
+  ts += "/* eslint-disable */\n";
+  ts += "// Fixed64Exports.ts\n";
+  ts += "// Generated by Fixed64ExportTypings from src/cpp/include/EntryPoints.h, do not edit;\n";
+  ts += "// regenerate with `cmake --build <native build> --target export-typings`.\n";
+  ts += "//\n";
+  ts += "// bindFixed64Exports() calls the plain wasm functions of a FIXED64_C_EXPORTS build\n";
+  ts += "// (see CExports.h), bindFixed64Embind() the embind functions of any build. Both\n";
+  ts += "// return the same shape and the same result types.\n\n";
+
+  for (const auto &group : groups) {
+    ts += "export interface " + all[group[0]].owner + "EntryPoints {\n";
+    for (size_t id : group) {
+      const Entry &entry = all[id];
+      ts += "    " + entry.name + "(" + parameterList(entry) + "): " +
+            entry.result + ";\n";
+    }
+    ts += "}\n\n";
+  }
+
+  ts += "export interface Fixed64EntryPoints {\n";
+  for (const auto &group : groups) {
+    const std::string &owner = all[group[0]].owner;
+    ts += "    " + owner + ": " + owner + "EntryPoints;\n";
+  }
+  ts += "}\n\n";
+
+  ts += "/** Length of fixed64_export_table() the bindings were generated for */\n";
+  ts += "export const fixed64ExportCount = " + std::to_string(all.size()) +
+        ";\n\n";
+
+  ts += "/** `table` is the wasm function table, `indices` the contents of fixed64_export_table() */\n";
+  ts += "export function bindFixed64Exports(module: any, table: WebAssembly.Table, indices: Uint32Array): Fixed64EntryPoints {\n";
+  ts += "    if (indices.length !== fixed64ExportCount) {\n";
+  ts += "        throw new Error(`Fixed64Exports.ts expects ${fixed64ExportCount} entry points, the module exports ${indices.length}`);\n";
+  ts += "    }\n";
+  ts += "    const get = (id: number): any => table.get(indices[id]);\n";
+  for (size_t id = 0; id < all.size(); ++id) {
+    if (all[id].exported && !all[id].conversion.empty()) {
+      ts += "    const e" + std::to_string(id) + " = get(" +
+            std::to_string(id) + ");\n";
+    }
+  }
+  ts += "    return {\n";
+  for (const auto &group : groups) {
+    ts += "        " + all[group[0]].owner + ": {\n";
+    for (size_t id : group) {
+      const Entry &entry = all[id];
+      std::string value;
+      if (!entry.exported) {
+        value = embindOwner(entry) + "." + entry.name;
+      } else if (entry.conversion.empty()) {
+        value = "get(" + std::to_string(id) + ")";
+      } else {
+        value = "(" + parameterList(entry) + "): " + entry.result + " => e" +
+                std::to_string(id) + "(" + argumentList(entry) + ")" +
+                entry.conversion;
+      }
+      ts += "            " + entry.name + ": " + value + ",\n";
+    }
+    ts += "        },\n";
+  }
+  ts += "    };\n";
+  ts += "}\n\n";
+
+  ts += "export function bindFixed64Embind(module: any): Fixed64EntryPoints {\n";
+  ts += "    return {\n";
+  for (const auto &group : groups) {
+    const Entry &first = all[group[0]];
+    ts += "        " + first.owner + ": " + embindOwner(first) + ",\n";
+  }
+  ts += "    };\n";
+  ts += "}\n";
+  return ts;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::vector<const char *> outputs;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+      outputs.push_back(argv[++i]);
+    } else {
+      std::fprintf(stderr, "usage: Fixed64ExportTypings [--out file]...\n");
+      return 2;
+    }
+  }
+  std::string ts = generate();
+  if (outputs.empty()) {
+    std::fwrite(ts.data(), 1, ts.size(), stdout);
+    return 0;
+  }
+  for (const char *path : outputs) {
+    std::ofstream file(path, std::ios::binary);
+    file << ts;
+    if (!file) {
+      std::fprintf(stderr, "cannot write %s\n", path);
+      return 2;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,808 @@
+// Fixed64Benchmark.cpp
+// Benchmark suite for the Fixed64 core: every FixedMath kernel, the vector
+// ops, the Rect/Sector collision tests, the batch APIs, state hashing,
+// snapshot encoding, number and decimal text conversion and the cost of the
+// interop wrappers behind the wasm bindings. Builds natively and with emcc;
+// the emcc build runs under Node.
+// See Benchmark.h for the options.
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Fixed64.h"
+#include "Fixed64Format.h"
+#include "Fixed64Native.h"
+#include "FixedMath.h"
+#include "Instrumentation.h"
+#include "Interop.h"
+#include "Rect.h"
+#include "Sector.h"
+#include "SimContext.h"
+#include "Snapshot.h"
+#include "StateHash.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+using namespace Skynet;
+using Skynet::Benchmark::Suite;
+
+namespace {
+constexpr size_t kBatch = 4096;
+// Batches large enough for the JobPool of threaded builds to split
+constexpr size_t kParallelBatch = 16 * kBatch;
+
+int64_t toChecksum(Fixed64 value) { return value.value; }
+int64_t toChecksum(int64_t value) { return value; }
+int64_t toChecksum(int value) { return value; }
+int64_t toChecksum(uint32_t value) { return value; }
+int64_t toChecksum(bool value) { return value ? 1 : 0; }
+int64_t toChecksum(const Vector2 &value) {
+  return value._x.value + value._y.value;
+}
+int64_t toChecksum(const Vector3 &value) {
+  return value._x.value + value._y.value + value._z.value;
+}
+
+template <typename Func>
+void addUnary(Suite &suite, const char *group, const char *name,
+              const std::vector<Fixed64> &xs, Func func) {
+  suite.add(group, name, xs.size(), [&xs, func] {
+    int64_t sum = 0;
+    for (Fixed64 x : xs) {
+      sum += toChecksum(func(x));
+    }
+    return sum;
+  });
+}
+
+template <typename Func>
+void addBinary(Suite &suite, const char *group, const char *name,
+               const std::vector<Fixed64> &xs, const std::vector<Fixed64> &ys,
+               Func func) {
+  suite.add(group, name, xs.size(), [&xs, &ys, func] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < xs.size(); ++i) {
+      sum += toChecksum(func(xs[i], ys[i]));
+    }
+    return sum;
+  });
+}
+
+template <typename Func>
+void addTernary(Suite &suite, const char *group, const char *name,
+                const std::vector<Fixed64> &xs, const std::vector<Fixed64> &ys,
+                const std::vector<Fixed64> &zs, Func func) {
+  suite.add(group, name, xs.size(), [&xs, &ys, &zs, func] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < xs.size(); ++i) {
+      sum += toChecksum(func(xs[i], ys[i], zs[i]));
+    }
+    return sum;
+  });
+}
+
+std::vector<int64_t> rawColumn(const std::vector<Fixed64> &column) {
+  std::vector<int64_t> raw(column.size());
+  for (size_t i = 0; i < column.size(); ++i) {
+    raw[i] = column[i].value;
+  }
+  return raw;
+}
+
+template <typename Vector, size_t N>
+std::vector<Vector> vectorColumn(
+    const std::array<const std::vector<Fixed64> *, N> &components) {
+  std::vector<Vector> vectors(components[0]->size());
+  for (size_t i = 0; i < vectors.size(); ++i) {
+    if constexpr (N == 2) {
+      vectors[i] = Vector((*components[0])[i], (*components[1])[i]);
+    } else {
+      vectors[i] = Vector((*components[0])[i], (*components[1])[i],
+                          (*components[2])[i]);
+    }
+  }
+  return vectors;
+}
+
+// Writes a value into the interop parameter array the way the TS wrappers
+// do for Fixed64 instances (raw high/low words).
+void setParam(size_t index, Fixed64 value) {
+  getInteropParamArray()[index] = static_cast<Fixed64Param>(value);
+}
+
+// The same for plain JS numbers, which are parsed from a double.
+void setParam(size_t index, double value) {
+  Fixed64Param param;
+  param.isRaw = true;
+  param.raw = value;
+  getInteropParamArray()[index] = param;
+}
+
+void setParam(size_t index, const Vector3 &value) {
+  setParam(index, value._x);
+  setParam(index + 1, value._y);
+  setParam(index + 2, value._z);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  Suite suite("Fixed64Benchmark", Benchmark::parseOptions(argc, argv));
+  std::mt19937_64 rng(suite.options().seed);
+
+  using Benchmark::randomColumn;
+  const auto signedSmall = randomColumn(rng, kBatch, -200.0, 200.0);
+  const auto signedSmall2 = randomColumn(rng, kBatch, -200.0, 200.0);
+  const auto signedSmall3 = randomColumn(rng, kBatch, -200.0, 200.0);
+  const auto positive = randomColumn(rng, kBatch, 0.001, 30000.0);
+  const auto unit = randomColumn(rng, kBatch, 0.0, 1.0);
+  const auto symmetricUnit = randomColumn(rng, kBatch, -1.0, 1.0);
+  const auto radians = randomColumn(rng, kBatch, -6.3, 6.3);
+  const auto degrees = randomColumn(rng, kBatch, -360.0, 360.0);
+  const auto expArgs = randomColumn(rng, kBatch, -11.9, 20.0);
+  const auto powBases = randomColumn(rng, kBatch, 0.01, 16.0);
+  const auto powExponents = randomColumn(rng, kBatch, -8.0, 8.0);
+  const auto pow2Args = randomColumn(rng, kBatch, -16.0, 30.0);
+  const auto radii = randomColumn(rng, kBatch, 0.5, 20.0);
+  const auto radii2 = randomColumn(rng, kBatch, 0.5, 20.0);
+  std::vector<Fixed64> nonZero = signedSmall2;
+  for (auto &value : nonZero) {
+    if (value.value == 0) {
+      value = Fixed64Const::One;
+    }
+  }
+  std::vector<int> smallExponents(kBatch);
+  for (auto &exponent : smallExponents) {
+    exponent = static_cast<int>(rng() % 9) - 4;
+  }
+
+  const auto vectors2 = vectorColumn<Vector2, 2>({&signedSmall, &signedSmall2});
+  const auto vectors2b = vectorColumn<Vector2, 2>({&signedSmall2, &signedSmall3});
+  const auto vectors3 =
+      vectorColumn<Vector3, 3>({&signedSmall, &signedSmall2, &signedSmall3});
+  const auto vectors3b =
+      vectorColumn<Vector3, 3>({&signedSmall3, &signedSmall, &signedSmall2});
+  const auto directions =
+      vectorColumn<Vector3, 3>({&symmetricUnit, &unit, &unit});
+
+  // Fixed64 arithmetic
+  addBinary(suite, "fixed64", "add", signedSmall, signedSmall2,
+            [](Fixed64 a, Fixed64 b) { return a + b; });
+  addBinary(suite, "fixed64", "sub", signedSmall, signedSmall2,
+            [](Fixed64 a, Fixed64 b) { return a - b; });
+  addBinary(suite, "fixed64", "mul", signedSmall, signedSmall2,
+            [](Fixed64 a, Fixed64 b) { return a * b; });
+  addBinary(suite, "fixed64", "div", signedSmall, nonZero,
+            [](Fixed64 a, Fixed64 b) { return a / b; });
+  addBinary(suite, "fixed64", "mod", signedSmall, nonZero,
+            [](Fixed64 a, Fixed64 b) { return a % b; });
+  addBinary(suite, "fixed64", "lt", signedSmall, signedSmall2,
+            [](Fixed64 a, Fixed64 b) { return a < b; });
+
+  // Rounding and sign
+  addUnary(suite, "fixedmath", "Abs", signedSmall, FixedMath::Abs);
+  addUnary(suite, "fixedmath", "Sign", signedSmall, FixedMath::Sign);
+  addUnary(suite, "fixedmath", "Floor", signedSmall, FixedMath::Floor);
+  addUnary(suite, "fixedmath", "Ceil", signedSmall, FixedMath::Ceil);
+  addUnary(suite, "fixedmath", "Round", signedSmall, FixedMath::Round);
+  addUnary(suite, "fixedmath", "FloorToInt", signedSmall,
+           FixedMath::FloorToInt);
+  addUnary(suite, "fixedmath", "CeilToInt", signedSmall, FixedMath::CeilToInt);
+  addUnary(suite, "fixedmath", "RoundToInt", signedSmall,
+           FixedMath::RoundToInt);
+  addUnary(suite, "fixedmath", "Fractions", signedSmall, FixedMath::Fractions);
+  addBinary(suite, "fixedmath", "Min", signedSmall, signedSmall2,
+            FixedMath::Min);
+  addBinary(suite, "fixedmath", "Max", signedSmall, signedSmall2,
+            FixedMath::Max);
+  addUnary(suite, "fixedmath", "Clamp", signedSmall, [](Fixed64 x) {
+    return FixedMath::Clamp(x, Fixed64(-100), Fixed64(100));
+  });
+  addUnary(suite, "fixedmath", "Clamp01", symmetricUnit, FixedMath::Clamp01);
+  addBinary(suite, "fixedmath", "IsOppositeSign", signedSmall, signedSmall2,
+            FixedMath::IsOppositeSign);
+  addBinary(suite, "fixedmath", "SetSameSign", signedSmall, signedSmall2,
+            FixedMath::SetSameSign);
+
+  // Interpolation
+  addTernary(suite, "fixedmath", "Lerp", signedSmall, signedSmall2, unit,
+             FixedMath::Lerp);
+  addTernary(suite, "fixedmath", "LerpUnclamped", signedSmall, signedSmall2,
+             unit, FixedMath::LerpUnclamped);
+  addTernary(suite, "fixedmath", "InverseLerp", signedSmall, signedSmall2,
+             signedSmall3, FixedMath::InverseLerp);
+  addTernary(suite, "fixedmath", "LerpAngle", degrees, degrees, unit,
+             FixedMath::LerpAngle);
+  addBinary(suite, "fixedmath", "Repeat", signedSmall, positive,
+            FixedMath::Repeat);
+  addUnary(suite, "fixedmath", "NormalizeRadians", degrees,
+           FixedMath::NormalizeRadians);
+
+  // Roots and reciprocals
+  addUnary(suite, "fixedmath", "Sqrt", positive, FixedMath::Sqrt);
+  addUnary(suite, "fixedmath", "SqrtV1", positive, FixedMath::SqrtV1);
+  addUnary(suite, "fixedmath", "SqrtV2", positive, FixedMath::SqrtV2);
+  addUnary(suite, "fixedmath", "Rsqrt", positive, FixedMath::Rsqrt);
+  addUnary(suite, "fixedmath", "Rcp", nonZero, FixedMath::Rcp);
+  addBinary(suite, "fixedmath", "Normalize2", signedSmall, signedSmall2,
+            [](Fixed64 x, Fixed64 y) {
+              Fixed64 components[2] = {x, y};
+              FixedMath::Normalize(components);
+              return components[0] + components[1];
+            });
+  addTernary(suite, "fixedmath", "Normalize3", signedSmall, signedSmall2,
+             signedSmall3, [](Fixed64 x, Fixed64 y, Fixed64 z) {
+               Fixed64 components[3] = {x, y, z};
+               FixedMath::Normalize(components);
+               return components[0] + components[1] + components[2];
+             });
+
+  // Trigonometry
+  addUnary(suite, "fixedmath", "Sin", radians, FixedMath::Sin);
+  addUnary(suite, "fixedmath", "Cos", radians, FixedMath::Cos);
+  addUnary(suite, "fixedmath", "Tan", radians, FixedMath::Tan);
+  addUnary(suite, "fixedmath", "Asin", symmetricUnit, FixedMath::Asin);
+  addUnary(suite, "fixedmath", "Acos", symmetricUnit, FixedMath::Acos);
+  addUnary(suite, "fixedmath", "Atan", signedSmall, FixedMath::Atan);
+  addUnary(suite, "fixedmath", "AtanApproximated", symmetricUnit,
+           FixedMath::AtanApproximated);
+  addBinary(suite, "fixedmath", "Atan2", signedSmall, signedSmall2,
+            FixedMath::Atan2);
+  addBinary(suite, "fixedmath", "Atan2V1", signedSmall, signedSmall2,
+            FixedMath::Atan2V1);
+  addBinary(suite, "fixedmath", "Atan2V2", signedSmall, signedSmall2,
+            FixedMath::Atan2V2);
+  addBinary(suite, "fixedmath", "Atan2Deg", signedSmall, signedSmall2,
+            FixedMath::Atan2Deg);
+  addBinary(suite, "fixedmath", "Atan2Heading", signedSmall, signedSmall2,
+            [](Fixed64 y, Fixed64 x) {
+              return FixedMath::Atan2Heading(y, x, 8);
+            });
+
+  // Exponentials, logarithms and powers
+  addUnary(suite, "fixedmath", "Exp", expArgs, FixedMath::Exp);
+  addUnary(suite, "fixedmath", "ExpV1", expArgs, FixedMath::ExpV1);
+  addUnary(suite, "fixedmath", "ExpV2", expArgs, FixedMath::ExpV2);
+  addUnary(suite, "fixedmath", "ExpApproximated", expArgs,
+           FixedMath::ExpApproximated);
+  addUnary(suite, "fixedmath", "Log2", positive, FixedMath::Log2);
+  addUnary(suite, "fixedmath", "Ln", positive, FixedMath::Ln);
+  addBinary(suite, "fixedmath", "Pow", powBases, powExponents,
+            FixedMath::Pow);
+  addUnary(suite, "fixedmath", "Pow2", pow2Args,
+           [](Fixed64 x) { return FixedMath::Pow2(x); });
+  suite.add("fixedmath", "PowInt", kBatch, [&powBases, &smallExponents] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += FixedMath::PowInt(powBases[i], smallExponents[i]).value;
+    }
+    return sum;
+  });
+
+  // Bit operations
+  addUnary(suite, "fixedmath", "BitScanReverse", positive, [](Fixed64 x) {
+    return FixedMath::BitScanReverse(static_cast<uint64_t>(x.value));
+  });
+  addUnary(suite, "fixedmath", "CountLeadingZeroes", positive, [](Fixed64 x) {
+    return FixedMath::CountLeadingZeroes(static_cast<uint64_t>(x.value));
+  });
+  addUnary(suite, "fixedmath", "CountTrailingZeroes", positive, [](Fixed64 x) {
+    return FixedMath::CountTrailingZeroes(static_cast<uint64_t>(x.value));
+  });
+  addUnary(suite, "fixedmath", "PopCount", positive, [](Fixed64 x) {
+    return FixedMath::PopCount(static_cast<uint64_t>(x.value));
+  });
+  addUnary(suite, "fixedmath", "Log2Int", positive, FixedMath::Log2Int);
+  addUnary(suite, "fixedmath", "Frexp", signedSmall, [](Fixed64 x) {
+    int exponent;
+    return FixedMath::Frexp(x, exponent).value + exponent;
+  });
+
+  // Vector ops
+  suite.add("vector2", "add", kBatch, [&vectors2, &vectors2b] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += toChecksum(vectors2[i].add(vectors2b[i]));
+    }
+    return sum;
+  });
+  suite.add("vector2", "dot", kBatch, [&vectors2, &vectors2b] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += Vector2::dot(vectors2[i], vectors2b[i]).value;
+    }
+    return sum;
+  });
+  suite.add("vector2", "len", kBatch, [&vectors2] {
+    int64_t sum = 0;
+    for (const auto &vector : vectors2) {
+      sum += vector.len().value;
+    }
+    return sum;
+  });
+  suite.add("vector2", "normalize", kBatch, [&vectors2] {
+    int64_t sum = 0;
+    for (Vector2 vector : vectors2) {
+      sum += toChecksum(vector.normalize());
+    }
+    return sum;
+  });
+  suite.add("vector2", "checkCircleOverlap", kBatch,
+            [&vectors2, &vectors2b, &radii, &radii2] {
+              int64_t sum = 0;
+              for (size_t i = 0; i < kBatch; ++i) {
+                sum += Vector2::checkCircleOverlap(vectors2[i], vectors2b[i],
+                                                   radii[i], radii2[i]);
+              }
+              return sum;
+            });
+  suite.add("vector2", "checkLineSegmentIntersectsCircle", kBatch,
+            [&vectors2, &vectors2b, &radii] {
+              int64_t sum = 0;
+              for (size_t i = 0; i + 1 < kBatch; ++i) {
+                sum += Vector2::checkLineSegmentIntersectsCircle(
+                    vectors2[i], radii[i], vectors2b[i], vectors2b[i + 1]);
+              }
+              return sum;
+            });
+
+  suite.add("vector3", "add", kBatch, [&vectors3, &vectors3b] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += toChecksum(vectors3[i] + vectors3b[i]);
+    }
+    return sum;
+  });
+  suite.add("vector3", "dot", kBatch, [&vectors3, &vectors3b] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += Vector3::dot(vectors3[i], vectors3b[i]).value;
+    }
+    return sum;
+  });
+  suite.add("vector3", "length", kBatch, [&vectors3] {
+    int64_t sum = 0;
+    for (const auto &vector : vectors3) {
+      sum += vector.length().value;
+    }
+    return sum;
+  });
+  suite.add("vector3", "normalize", kBatch, [&vectors3] {
+    int64_t sum = 0;
+    for (Vector3 vector : vectors3) {
+      vector.normalize();
+      sum += toChecksum(vector);
+    }
+    return sum;
+  });
+  suite.add("vector3", "squaredDistance", kBatch, [&vectors3, &vectors3b] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += Vector3::squaredDistance(vectors3[i], vectors3b[i]).value;
+    }
+    return sum;
+  });
+  suite.add("vector3", "rotateZ", kBatch, [&vectors3, &vectors3b, &degrees] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += toChecksum(Vector3::rotateZ(vectors3[i], vectors3b[i], degrees[i]));
+    }
+    return sum;
+  });
+  suite.add("vector3", "calculateAngle", kBatch, [&vectors3, &vectors3b] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += Vector3::calculateAngle(vectors3[i], vectors3b[i]).value;
+    }
+    return sum;
+  });
+  suite.add("vector3", "pointToLineSegmentDistanceSqr", kBatch,
+            [&vectors3, &vectors3b] {
+              int64_t sum = 0;
+              for (size_t i = 0; i + 1 < kBatch; ++i) {
+                sum += Vector3::pointToLineSegmentDistanceSqr(
+                           vectors3b[i], vectors3b[i + 1], vectors3[i])
+                           .value;
+              }
+              return sum;
+            });
+  suite.add("vector3", "checkCircleOverlap", kBatch,
+            [&vectors3, &vectors3b, &radii, &radii2] {
+              int64_t sum = 0;
+              for (size_t i = 0; i < kBatch; ++i) {
+                sum += Vector3::checkCircleOverlap(
+                    vectors3[i], vectors3b[i], radii[i], radii2[i], true);
+              }
+              return sum;
+            });
+
+  // Collision tests; shapes are built once, only the test is measured
+  std::vector<Rect> rects(kBatch);
+  std::vector<Sector> sectors(kBatch);
+  for (size_t i = 0; i < kBatch; ++i) {
+    Vector3 direction = directions[i];
+    direction.normalize();
+    rects[i].init(vectors3[i], radii[i], radii2[i], direction);
+    sectors[i].init(vectors3[i], direction, degrees[i] / 4, radii[i]);
+  }
+  suite.add("collision", "Rect.init", kBatch,
+            [&vectors3, &radii, &radii2, &directions] {
+              int64_t sum = 0;
+              Rect rect;
+              for (size_t i = 0; i < kBatch; ++i) {
+                rect.init(vectors3[i], radii[i], radii2[i], directions[i]);
+                sum += rect.containsPoint(vectors3[i]);
+              }
+              return sum;
+            });
+  suite.add("collision", "Rect.overlapsWithCircle", kBatch,
+            [&rects, &vectors3b, &radii2] {
+              int64_t sum = 0;
+              for (size_t i = 0; i < kBatch; ++i) {
+                sum += rects[i].overlapsWithCircle(vectors3b[i], radii2[i]);
+              }
+              return sum;
+            });
+  suite.add("collision", "Rect.overlapsWithRect", kBatch, [&rects] {
+    int64_t sum = 0;
+    for (size_t i = 0; i + 1 < kBatch; ++i) {
+      sum += rects[i].overlapsWithRect(rects[i + 1]);
+    }
+    return sum;
+  });
+  suite.add("collision", "Rect.containsPoint", kBatch, [&rects, &vectors3b] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += rects[i].containsPoint(vectors3b[i]);
+    }
+    return sum;
+  });
+  // The same tests with the plane fixed at compile time
+  suite.add("collision", "Rect.overlapsWithCircle<XY>", kBatch,
+            [&rects, &vectors3b, &radii2] {
+              int64_t sum = 0;
+              for (size_t i = 0; i < kBatch; ++i) {
+                sum += rects[i].overlapsWithCircle<Plane::XY>(vectors3b[i],
+                                                              radii2[i]);
+              }
+              return sum;
+            });
+  suite.add("collision", "Rect.containsPoint<XY>", kBatch,
+            [&rects, &vectors3b] {
+              int64_t sum = 0;
+              for (size_t i = 0; i < kBatch; ++i) {
+                sum += rects[i].containsPoint<Plane::XY>(vectors3b[i]);
+              }
+              return sum;
+            });
+  suite.add("collision", "Sector.overlapsWithCircle", kBatch,
+            [&sectors, &vectors3b, &radii2] {
+              int64_t sum = 0;
+              for (size_t i = 0; i < kBatch; ++i) {
+                sum += sectors[i].overlapsWithCircle(vectors3b[i], radii2[i]);
+              }
+              return sum;
+            });
+
+  // Batch APIs over raw columns
+  const auto rawYs = rawColumn(signedSmall);
+  const auto rawXs = rawColumn(signedSmall2);
+  const auto rawZs = rawColumn(signedSmall3);
+  std::vector<int64_t> rawOut(kBatch);
+  std::vector<uint32_t> headings(kBatch);
+  suite.add("batch", "Atan2Many", kBatch, [&rawYs, &rawXs, &rawOut] {
+    FixedMath::Atan2Many(rawYs.data(), rawXs.data(), rawOut.data(), kBatch);
+    return rawOut[0];
+  });
+  suite.add("batch", "Atan2HeadingMany", kBatch, [&rawYs, &rawXs, &headings] {
+    FixedMath::Atan2HeadingMany(rawYs.data(), rawXs.data(), headings.data(),
+                                kBatch, 8);
+    return static_cast<int64_t>(headings[0]);
+  });
+  std::vector<int64_t> normalizeXs(kBatch);
+  std::vector<int64_t> normalizeYs(kBatch);
+  std::vector<int64_t> normalizeZs(kBatch);
+  suite.add("batch", "Vector2.normalizeMany", kBatch, [&] {
+    normalizeXs = rawXs;
+    normalizeYs = rawYs;
+    Vector2::normalizeMany(reinterpret_cast<uintptr_t>(normalizeXs.data()),
+                           reinterpret_cast<uintptr_t>(normalizeYs.data()),
+                           kBatch);
+    return normalizeXs[0];
+  });
+  suite.add("batch", "Vector3.normalizeMany", kBatch, [&] {
+    normalizeXs = rawXs;
+    normalizeYs = rawYs;
+    normalizeZs = rawZs;
+    Vector3::normalizeMany(reinterpret_cast<uintptr_t>(normalizeXs.data()),
+                           reinterpret_cast<uintptr_t>(normalizeYs.data()),
+                           reinterpret_cast<uintptr_t>(normalizeZs.data()),
+                           kBatch);
+    return normalizeXs[0];
+  });
+
+  // Batch entry points on large columns; threaded builds split these across
+  // JobPool::workerCount() workers
+  std::vector<int64_t> wideYs(kParallelBatch);
+  std::vector<int64_t> wideXs(kParallelBatch);
+  std::vector<int64_t> wideZs(kParallelBatch);
+  for (size_t i = 0; i < kParallelBatch; ++i) {
+    wideYs[i] = rawYs[i % kBatch];
+    wideXs[i] = rawXs[i % kBatch];
+    wideZs[i] = rawZs[i % kBatch];
+  }
+  std::vector<int64_t> wideOut(kParallelBatch);
+  suite.add("parallel", "Fixed64Native.atan2Many", kParallelBatch, [&] {
+    Fixed64Native::atan2Many(reinterpret_cast<uintptr_t>(wideYs.data()),
+                             reinterpret_cast<uintptr_t>(wideXs.data()),
+                             reinterpret_cast<uintptr_t>(wideOut.data()),
+                             kParallelBatch);
+    return wideOut[0];
+  });
+  std::vector<int64_t> wideNormalXs(kParallelBatch);
+  std::vector<int64_t> wideNormalYs(kParallelBatch);
+  std::vector<int64_t> wideNormalZs(kParallelBatch);
+  suite.add("parallel", "Vector3.normalizeMany", kParallelBatch, [&] {
+    wideNormalXs = wideXs;
+    wideNormalYs = wideYs;
+    wideNormalZs = wideZs;
+    Vector3::normalizeMany(reinterpret_cast<uintptr_t>(wideNormalXs.data()),
+                           reinterpret_cast<uintptr_t>(wideNormalYs.data()),
+                           reinterpret_cast<uintptr_t>(wideNormalZs.data()),
+                           kParallelBatch);
+    return wideNormalXs[0];
+  });
+
+  // State hashing, per hashed Fixed64 value
+  suite.add("hash", "StateHash.column", kBatch, [&rawXs] {
+    return static_cast<int64_t>(StateHash::hashRaw(rawXs.data(), kBatch));
+  });
+  suite.add("hash", "StateHash.vector3Columns", kBatch * 3, [&] {
+    StateHash::resetWrapper(0, 0);
+    StateHash::updateVector3Columns(reinterpret_cast<uintptr_t>(rawXs.data()),
+                                    reinterpret_cast<uintptr_t>(rawYs.data()),
+                                    reinterpret_cast<uintptr_t>(rawZs.data()),
+                                    kBatch);
+    return static_cast<int64_t>(SimContext::current().stateHash.digest());
+  });
+  suite.add("hash", "StateHash.params", 6, [&signedSmall] {
+    for (size_t i = 0; i < 6; ++i) {
+      setParam(i, signedSmall[i]);
+    }
+    StateHash::resetWrapper(0, 0);
+    StateHash::updateParams(6);
+    return static_cast<int64_t>(SimContext::current().stateHash.digest());
+  });
+
+  // Snapshot encoding per value, absolute and as a delta to the previous
+  // tick, next to the string round trip it replaces
+  std::vector<int64_t> movedXs(kBatch);
+  for (size_t i = 0; i < kBatch; ++i) {
+    movedXs[i] = rawXs[i] + static_cast<int64_t>(rng() % 4096) - 2048;
+  }
+  std::vector<uint8_t> snapshotBuffer(Snapshot::maxEncodedSize(kBatch));
+  std::vector<int64_t> decoded(kBatch);
+  auto encodeSnapshot = [&](const std::vector<int64_t> &values,
+                            SnapshotMode mode) {
+    SnapshotWriter writer(snapshotBuffer.data(), snapshotBuffer.size());
+    writer.writeColumn(values.data(), kBatch, mode, rawXs.data());
+    return writer.size();
+  };
+  suite.add("snapshot", "encode.absolute", kBatch, [&] {
+    return static_cast<int64_t>(encodeSnapshot(rawXs, SnapshotMode::Absolute));
+  });
+  suite.add("snapshot", "encode.reference", kBatch, [&] {
+    return static_cast<int64_t>(
+        encodeSnapshot(movedXs, SnapshotMode::Reference));
+  });
+  for (SnapshotMode mode : {SnapshotMode::Absolute, SnapshotMode::Reference}) {
+    bool reference = mode == SnapshotMode::Reference;
+    auto encoded = std::make_shared<std::vector<uint8_t>>(
+        Snapshot::maxEncodedSize(kBatch));
+    SnapshotWriter writer(encoded->data(), encoded->size());
+    writer.writeColumn(reference ? movedXs.data() : rawXs.data(), kBatch, mode,
+                       rawXs.data());
+    encoded->resize(writer.size());
+    suite.add("snapshot", reference ? "decode.reference" : "decode.absolute",
+              kBatch, [encoded, &decoded, &rawXs] {
+                SnapshotReader reader(encoded->data(), encoded->size());
+                reader.readColumn(decoded.data(), kBatch, rawXs.data(), kBatch);
+                return decoded[kBatch - 1];
+              });
+  }
+  suite.add("snapshot", "toString", kBatch, [&signedSmall2] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += static_cast<int64_t>(toString(signedSmall2[i]).size());
+    }
+    return sum;
+  });
+  std::vector<std::string> strings(kBatch);
+  for (size_t i = 0; i < kBatch; ++i) {
+    strings[i] = toString(signedSmall2[i]);
+  }
+  suite.add("snapshot", "fromString", kBatch, [&strings] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += parseFixed64(strings[i]).value;
+    }
+    return sum;
+  });
+
+  // double -> Fixed64, the conversion behind every number param from JS,
+  // next to the std::floor based code it replaces
+  std::vector<double> doubles(kBatch);
+  for (size_t i = 0; i < kBatch; ++i) {
+    doubles[i] = static_cast<double>(signedSmall[i]) +
+                 static_cast<double>(rng() % 1000) * 1e-9;
+  }
+  suite.add("convert", "floorLegacyCode", kBatch, [&doubles] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      int64_t integerPart = static_cast<int64_t>(std::floor(doubles[i]));
+      double fractionalPart = doubles[i] - integerPart;
+      sum += (integerPart << FixLut::PRECISION) +
+             static_cast<int64_t>(fractionalPart * FixLut::ONE);
+    }
+    return sum;
+  });
+  for (FixedRounding rounding :
+       {FixedRounding::LegacyFloor, FixedRounding::Floor,
+        FixedRounding::Truncate, FixedRounding::Nearest}) {
+    static constexpr const char *kNames[] = {"floor", "truncate", "nearest",
+                                             "legacyFloor"};
+    suite.add("convert", kNames[static_cast<int>(rounding)], kBatch,
+              [&doubles, rounding] {
+                int64_t sum = 0;
+                for (size_t i = 0; i < kBatch; ++i) {
+                  sum += FixedConvert::fromDouble(doubles[i], rounding);
+                }
+                return sum;
+              });
+  }
+  suite.add("convert", "fromDoubles", kBatch, [&doubles, &decoded] {
+    FixedConvert::fromDoubles(doubles.data(), kBatch, decoded.data());
+    return decoded[kBatch - 1];
+  });
+  suite.add("convert", "param", kBatch, [&doubles] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      setParam(0, doubles[i]);
+      sum += Fixed64(getInteropParamArray()[0]).value;
+    }
+    return sum;
+  });
+
+  // Decimal text into caller buffers, without the std::string allocation
+  std::vector<int64_t> rawSmall2(kBatch);
+  for (size_t i = 0; i < kBatch; ++i) {
+    rawSmall2[i] = signedSmall2[i].value;
+  }
+  std::vector<char> text(kBatch * FixedDecimal::kMaxLength);
+  suite.add("decimal", "toChars", kBatch, [&signedSmall2, &text] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      sum += static_cast<int64_t>(
+          signedSmall2[i].toChars(text.data(), FixedDecimal::kMaxLength));
+    }
+    return sum;
+  });
+  suite.add("decimal", "fromChars", kBatch, [&strings] {
+    int64_t sum = 0;
+    Fixed64 value;
+    for (size_t i = 0; i < kBatch; ++i) {
+      Fixed64::fromChars(strings[i].data(), strings[i].size(), value);
+      sum += value.value;
+    }
+    return sum;
+  });
+  suite.add("decimal", "formatMany", kBatch, [&rawSmall2, &text] {
+    return static_cast<int64_t>(FixedDecimal::formatMany(
+        rawSmall2.data(), kBatch, text.data(), text.size()));
+  });
+  size_t textLength = FixedDecimal::formatMany(rawSmall2.data(), kBatch,
+                                               text.data(), text.size());
+  auto parsedText = std::make_shared<std::string>(text.data(), textLength);
+  suite.add("decimal", "parseMany", kBatch, [parsedText, &decoded] {
+    return FixedDecimal::parseMany(parsedText->data(), parsedText->size(), '\n',
+                                   decoded.data(), kBatch);
+  });
+
+  // Interop wrappers: parameter marshaling, the wrapped op and reading the
+  // result back, as seen from the JS side minus the embind call itself.
+  suite.add("interop", "emptyCall", kBatch, [] {
+    // Called through a pointer like the embind invoker does
+    void (*volatile call)() = &Fixed64Native::emptyCall;
+    for (size_t i = 0; i < kBatch; ++i) {
+      call();
+    }
+    return static_cast<int64_t>(0);
+  });
+  suite.add("interop", "add.raw", kBatch, [&signedSmall, &signedSmall2] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      setParam(0, signedSmall[i]);
+      setParam(1, signedSmall2[i]);
+      Fixed64Native::add();
+      sum += Fixed64(getInteropReturnArray()[0]).value;
+    }
+    return sum;
+  });
+  // Overhead of the FIXED64_INSTRUMENTATION wrapper, counting only and with
+  // timing switched on
+  for (bool timing : {false, true}) {
+    suite.add("interop", timing ? "add.instrumented.timed" : "add.instrumented",
+              kBatch, [&signedSmall, &signedSmall2, timing] {
+                using Entry =
+                    Instrumented<EntryPoint::Fixed64Native_add, &Fixed64Native::add>;
+                Instrumentation::setTiming(timing);
+                int64_t sum = 0;
+                for (size_t i = 0; i < kBatch; ++i) {
+                  setParam(0, signedSmall[i]);
+                  setParam(1, signedSmall2[i]);
+                  Entry::call();
+                  sum += Fixed64(getInteropReturnArray()[0]).value;
+                }
+                Instrumentation::setTiming(false);
+                return sum;
+              });
+  }
+  suite.add("interop", "add.double", kBatch, [&signedSmall, &signedSmall2] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      setParam(0, static_cast<double>(signedSmall[i]));
+      setParam(1, static_cast<double>(signedSmall2[i]));
+      Fixed64Native::add();
+      sum += Fixed64(getInteropReturnArray()[0]).value;
+    }
+    return sum;
+  });
+  suite.add("interop", "sqrt", kBatch, [&positive] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      setParam(0, positive[i]);
+      Fixed64Native::sqrt();
+      sum += Fixed64(getInteropReturnArray()[0]).value;
+    }
+    return sum;
+  });
+  suite.add("interop", "atan2", kBatch, [&signedSmall, &signedSmall2] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      setParam(0, signedSmall[i]);
+      setParam(1, signedSmall2[i]);
+      Fixed64Native::atan2();
+      sum += Fixed64(getInteropReturnArray()[0]).value;
+    }
+    return sum;
+  });
+  suite.add("interop", "Vector3.add", kBatch, [&vectors3, &vectors3b] {
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBatch; ++i) {
+      setParam(0, vectors3[i]);
+      setParam(3, vectors3b[i]);
+      Vector3::add();
+      sum += Fixed64(getInteropReturnArray()[0]).value;
+    }
+    return sum;
+  });
+  suite.add("interop", "Rect.overlapsWithCircle", kBatch,
+            [&vectors3, &vectors3b, &directions, &radii, &radii2] {
+              int64_t sum = 0;
+              for (size_t i = 0; i < kBatch; ++i) {
+                setParam(0, vectors3[i]);
+                setParam(3, radii[i]);
+                setParam(4, radii2[i]);
+                setParam(5, directions[i]);
+                setParam(8, vectors3b[i]);
+                setParam(11, radii2[i]);
+                sum += Rect::overlapsWithCircle(false);
+              }
+              return sum;
+            });
+
+  return suite.run();
+}
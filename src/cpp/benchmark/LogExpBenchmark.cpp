@@ -0,0 +1,107 @@
+// LogExpBenchmark.cpp
+// Accuracy against a double reference and throughput of Log2, Ln, Pow and
+// both Exp kernels (FIXED64_MATH_VERSION 1 and 2) across the usable range.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "FixedMath.h"
+
+using namespace Skynet;
+
+namespace {
+struct Kernel {
+  const char *name;
+  const char *range;
+  Fixed64 (*fixed)(Fixed64, Fixed64);
+  double (*reference)(double, double);
+  double min;
+  double max;
+};
+
+const Kernel kKernels[] = {
+    {"Log2", "[0.001, 32767)",
+     [](Fixed64 x, Fixed64) { return FixedMath::Log2(x); },
+     [](double x, double) { return std::log2(x); }, 0.001, 32767.0},
+    {"Ln", "[0.001, 32767)",
+     [](Fixed64 x, Fixed64) { return FixedMath::Ln(x); },
+     [](double x, double) { return std::log(x); }, 0.001, 32767.0},
+    {"ExpV1", "[-11.9, 20)",
+     [](Fixed64 x, Fixed64) { return FixedMath::ExpV1(x); },
+     [](double x, double) { return std::exp(x); }, -11.9, 20.0},
+    {"ExpV2", "[-11.9, 20)",
+     [](Fixed64 x, Fixed64) { return FixedMath::ExpV2(x); },
+     [](double x, double) { return std::exp(x); }, -11.9, 20.0},
+    {"Pow", "[0.01, 16)^[-8, 8)",
+     [](Fixed64 x, Fixed64 y) { return FixedMath::Pow(x, y); },
+     [](double x, double y) { return std::pow(x, y); }, 0.01, 16.0},
+};
+
+double measureNsPerOp(const Kernel &kernel, const std::vector<Fixed64> &xs,
+                      const std::vector<Fixed64> &ys, int64_t &sink) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < xs.size(); ++i) {
+    sink += kernel.fixed(xs[i], ys[i]).value;
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> elapsed = end - start;
+  return elapsed.count() / static_cast<double>(xs.size());
+}
+}  // namespace
+
+int main() {
+  constexpr size_t kSamples = 1 << 18;
+  constexpr int kRepetitions = 5;
+
+  std::mt19937_64 rng(0x5EED5EEDULL);
+  int64_t sink = 0;
+
+  std::printf("%-8s %-20s %10s %12s %12s\n", "kernel", "range", "ns/op",
+              "max err", "mean err");
+  for (const auto &kernel : kKernels) {
+    std::uniform_real_distribution<double> dist(kernel.min, kernel.max);
+    std::uniform_real_distribution<double> exponentDist(-8.0, 8.0);
+    std::vector<Fixed64> xs(kSamples);
+    std::vector<Fixed64> ys(kSamples);
+    for (size_t i = 0; i < kSamples; ++i) {
+      xs[i] = Fixed64(dist(rng));
+      ys[i] = Fixed64(exponentDist(rng));
+    }
+
+    // Warm up before timing.
+    measureNsPerOp(kernel, xs, ys, sink);
+
+    double nsPerOp = 0;
+    for (int i = 0; i < kRepetitions; ++i) {
+      nsPerOp += measureNsPerOp(kernel, xs, ys, sink);
+    }
+    nsPerOp /= kRepetitions;
+
+    // Errors are in raw units (2^-16) for results up to one, and relative
+    // errors times 2^16 above, so they are not ulps for large results.
+    // Results beyond the representable range saturate to Max.
+    const double maxRaw = static_cast<double>(Fixed64Const::Max.value);
+    double maxError = 0;
+    double sumError = 0;
+    for (size_t i = 0; i < kSamples; ++i) {
+      double expected = std::min(
+          maxRaw, kernel.reference(static_cast<double>(xs[i]),
+                                   static_cast<double>(ys[i])) *
+                      FixLut::ONE);
+      double actual = static_cast<double>(kernel.fixed(xs[i], ys[i]).value);
+      double error = std::fabs(actual - expected) /
+                    std::max(1.0, std::fabs(expected) / FixLut::ONE);
+      maxError = std::max(maxError, error);
+      sumError += error;
+    }
+
+    std::printf("%-8s %-20s %10.2f %12.3f %12.3f\n", kernel.name, kernel.range,
+                nsPerOp, maxError, sumError / kSamples);
+  }
+
+  std::printf("checksum: %lld\n", static_cast<long long>(sink));
+  return 0;
+}
@@ -0,0 +1,150 @@
+// ReplayTool.cpp
+// Fixed64Replay: re-executes a recording taken with Fixed64.startRecording()
+// (see Recorder.h) against the native core and reports the first call whose
+// outputs differ from the recorded ones.
+//
+//   Fixed64Replay <log> [--repeat N] [--timing]
+//
+// Every run prints the replay time per record, which makes a recording of
+// real traffic a native performance replay; --timing adds the time spent per
+// entry point (including a clock read per call), and --repeat replays the log
+// N times for steadier numbers. Only the first pass is compared, since state
+// such as the running StateHash carries over between passes.
+//
+// Exits with 0 when every executed call matched, 1 on a divergence and 2 on
+// unreadable input.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "Replay.h"
+
+using namespace Skynet;
+
+namespace {
+
+void printUsage() {
+  std::fprintf(stderr, "usage: Fixed64Replay <log> [--repeat N] [--timing]\n");
+}
+
+const char *entryName(EntryPoint entry) {
+  return entry == EntryPoint::Count ? "<unknown>"
+                                    : Instrumentation::name(entry);
+}
+
+void printTiming(const EntryPointStats *stats) {
+  std::vector<size_t> order;
+  for (size_t i = 0; i < Instrumentation::kEntryPointCount; ++i) {
+    if (stats[i].calls > 0) {
+      order.push_back(i);
+    }
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return stats[a].nanoseconds > stats[b].nanoseconds;
+  });
+  std::printf("%-36s %12s %14s %10s\n", "entry", "calls", "total ns",
+              "ns/call");
+  for (size_t i : order) {
+    std::printf("%-36s %12llu %14llu %10.1f\n",
+                Instrumentation::name(static_cast<EntryPoint>(i)),
+                static_cast<unsigned long long>(stats[i].calls),
+                static_cast<unsigned long long>(stats[i].nanoseconds),
+                static_cast<double>(stats[i].nanoseconds) /
+                    static_cast<double>(stats[i].calls));
+  }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const char *path = nullptr;
+  int repeat = 1;
+  bool timing = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+      repeat = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--timing") == 0) {
+      timing = true;
+    } else if (argv[i][0] != '-' && path == nullptr) {
+      path = argv[i];
+    } else {
+      printUsage();
+      return 2;
+    }
+  }
+  if (path == nullptr) {
+    printUsage();
+    return 2;
+  }
+
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    std::fprintf(stderr, "cannot open %s\n", path);
+    return 2;
+  }
+  std::vector<uint8_t> log((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+
+  Replayer replayer(log.data(), log.size());
+  if (replayer.error()) {
+    std::fprintf(stderr, "%s: %s\n", path, replayer.error());
+    return 2;
+  }
+  if (replayer.warning()) {
+    std::fprintf(stderr, "warning: %s (log %u, build %d)\n",
+                 replayer.warning(), replayer.mathVersion(),
+                 FIXED64_MATH_VERSION);
+  }
+  if (replayer.droppedCount() > 0) {
+    std::fprintf(stderr,
+                 "warning: %llu earlier records were dropped by the ring "
+                 "buffer, stateful calls may not match\n",
+                 static_cast<unsigned long long>(replayer.droppedCount()));
+  }
+
+  std::vector<EntryPointStats> stats(Instrumentation::kEntryPointCount);
+  EntryPointStats *timed = timing ? stats.data() : nullptr;
+  auto start = std::chrono::steady_clock::now();
+  ReplayReport report = replayer.run(timed, !timing);
+  for (int pass = 1; pass < repeat; ++pass) {
+    replayer.run(timed, false);
+  }
+  double elapsedNs = std::chrono::duration<double, std::nano>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+  std::printf("%zu records, %zu executed, %zu skipped (wasm memory)\n",
+              report.records, report.executed, report.skipped);
+  if (report.records > 0) {
+    std::printf("%.1f ns per record over %d pass(es)\n",
+                elapsedNs / (static_cast<double>(report.records) * repeat),
+                repeat);
+  }
+  if (timing) {
+    printTiming(stats.data());
+  }
+  switch (report.status) {
+    case ReplayStatus::Ok:
+      std::printf("no divergence\n");
+      return 0;
+    case ReplayStatus::Diverged:
+      std::printf(
+          "first divergence at record %zu (%zu in total): %s%s\n"
+          "  expected: %s\n"
+          "  actual:   %s\n",
+          report.index, report.divergences, entryName(report.entry),
+          report.arguments.c_str(), report.expected.c_str(),
+          report.actual.c_str());
+      return 1;
+    default:
+      std::fprintf(stderr, "malformed record %zu (%s)\n", report.index,
+                   entryName(report.entry));
+      return 2;
+  }
+}
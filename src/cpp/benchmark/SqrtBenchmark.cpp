@@ -0,0 +1,84 @@
+// SqrtBenchmark.cpp
+// Compares the legacy Newton Sqrt (FIXED64_MATH_VERSION 1) with the
+// LUT-seeded one (FIXED64_MATH_VERSION 2) for speed and precision.
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "FixedMath.h"
+
+using namespace Skynet;
+
+namespace {
+struct InputRange {
+  const char *name;
+  int64_t min;
+  int64_t max;
+};
+
+template <typename Func>
+double measureNsPerOp(const std::vector<Fixed64> &inputs, Func func,
+                      int64_t &sink) {
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &input : inputs) {
+    sink += func(input).value;
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> elapsed = end - start;
+  return elapsed.count() / static_cast<double>(inputs.size());
+}
+}  // namespace
+
+int main() {
+  constexpr size_t kSamples = 1 << 20;
+  constexpr int kRepetitions = 5;
+  const InputRange ranges[] = {
+      {"[0, 1)", 0, FixLut::ONE},
+      {"[1, 100)", FixLut::ONE, 100 * FixLut::ONE},
+      {"[100, 32768)", 100 * FixLut::ONE, 32768 * FixLut::ONE},
+      {"usable", 0, Fixed64Const::UsableMax.value << FixLut::PRECISION},
+  };
+
+  std::mt19937_64 rng(0x5EED5EEDULL);
+  int64_t sink = 0;
+
+  std::printf("%-14s %12s %12s %10s %14s\n", "range", "v1 ns/op", "v2 ns/op",
+              "speedup", "v1 max ulps");
+  for (const auto &range : ranges) {
+    std::uniform_int_distribution<int64_t> dist(range.min, range.max - 1);
+    std::vector<Fixed64> inputs(kSamples);
+    for (auto &input : inputs) {
+      input = Fixed64(dist(rng));
+    }
+
+    // Warm up both kernels before timing.
+    measureNsPerOp(inputs, FixedMath::SqrtV1, sink);
+    measureNsPerOp(inputs, FixedMath::SqrtV2, sink);
+
+    double v1 = 0;
+    double v2 = 0;
+    for (int i = 0; i < kRepetitions; ++i) {
+      v1 += measureNsPerOp(inputs, FixedMath::SqrtV1, sink);
+      v2 += measureNsPerOp(inputs, FixedMath::SqrtV2, sink);
+    }
+    v1 /= kRepetitions;
+    v2 /= kRepetitions;
+
+    // SqrtV2 is exact, so it is the reference for the legacy error.
+    int64_t maxUlps = 0;
+    for (const auto &input : inputs) {
+      int64_t diff =
+          FixedMath::SqrtV1(input).value - FixedMath::SqrtV2(input).value;
+      maxUlps = std::max(maxUlps, std::abs(diff));
+    }
+
+    std::printf("%-14s %12.2f %12.2f %9.2fx %14lld\n", range.name, v1, v2,
+                v1 / v2, static_cast<long long>(maxUlps));
+  }
+
+  std::printf("checksum: %lld\n", static_cast<long long>(sink));
+  return 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+// Bump allocation from one block reserved up front.
+//
+// allocate() hands out aligned slices of the block and returns nullptr once
+// the block is full. It never calls malloc, so a tick that takes its buffers
+// from arenas cannot grow the wasm heap, and JS views over the heap stay
+// attached for the whole tick. In FIXED64_HEAP_SIZE builds the heap never
+// grows at all and the views can be kept for good. reset() frees every slice
+// at once, e.g. at the start of the next tick; rewind() frees the slices
+// taken after a mark().
+//
+// JS creates arenas with Arena.create(capacity), which allocates the Arena
+// and its block in one piece through SimContext::allocate() and returns its
+// address, 0 if the heap is exhausted. Arena.allocate(arena, size) returns
+// the address of a slice, 0 when the arena is full.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Skynet {
+
+class Arena {
+ public:
+  // Alignment of every slice, enough for Fixed64 columns and SIMD loads
+  static constexpr size_t kAlignment = 16;
+
+  Arena() = default;
+  Arena(void *block, size_t capacity)
+      : _data(static_cast<uint8_t *>(block)), _capacity(capacity) {}
+
+  // `size` bytes aligned to kAlignment, nullptr if the rest of the block is
+  // too small
+  void *allocate(size_t size) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(_data);
+    uintptr_t next = (base + _used + kAlignment - 1) & ~(kAlignment - 1);
+    size_t offset = next - base;
+    if (offset > _capacity || size > _capacity - offset) {
+      return nullptr;
+    }
+    _used = offset + size;
+    return _data + offset;
+  }
+
+  template <typename T>
+  T *allocate(size_t count) {
+    if (count > _capacity / sizeof(T)) {
+      return nullptr;
+    }
+    return static_cast<T *>(allocate(count * sizeof(T)));
+  }
+
+  size_t mark() const { return _used; }
+  void rewind(size_t mark) { _used = mark < _used ? mark : _used; }
+  void reset() { _used = 0; }
+
+  uint8_t *data() const { return _data; }
+  size_t used() const { return _used; }
+  size_t capacity() const { return _capacity; }
+
+  // An arena of `capacity` bytes, nullptr if the memory is not available
+  static Arena *create(size_t capacity);
+  static void destroy(Arena *arena);
+
+  // JS entry points, arenas and slices passed as addresses
+  static uintptr_t createWrapper(uint32_t capacity);
+  static void destroyWrapper(uintptr_t arena);
+  static uintptr_t allocateWrapper(uintptr_t arena, uint32_t size);
+  static void resetWrapper(uintptr_t arena);
+  static uint32_t usedWrapper(uintptr_t arena);
+  static uint32_t capacityWrapper(uintptr_t arena);
+
+ private:
+  uint8_t *_data = nullptr;
+  size_t _capacity = 0;
+  size_t _used = 0;
+};
+
+}  // namespace Skynet
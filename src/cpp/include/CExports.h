@@ -0,0 +1,60 @@
+#pragma once
+
+// Entry points as plain wasm functions, next to their embind bindings.
+//
+// Embind calls go through a generic invoker that converts every argument and
+// result, which costs more than most of the ops themselves. With
+// FIXED64_C_EXPORTS=1 the module also exports fixed64_export_table(): the
+// function table index of every entry of EntryPoints.h, in EntryPoint order.
+// The generated Fixed64Exports.ts looks these up in the wasm table and calls
+// them directly. The table holds the FIXED64_ENTRY_FUNCTION pointers, so
+// instrumentation and recording apply to both paths.
+//
+// Only entry points whose parameters and result map onto wasm values without
+// conversion code are exported (see CExportable); the table holds 0 for the
+// others, which stay embind-only.
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "EntryPoints.h"
+
+#ifndef FIXED64_C_EXPORTS
+#define FIXED64_C_EXPORTS 0
+#endif
+
+namespace Skynet {
+
+// bool, 32-bit integers, floating point and wasm addresses. 64-bit integers
+// would reach JS as BigInt; natively uintptr_t is a 64-bit integer, so the
+// typings generator can not tell them apart and the lists must not use
+// uint64_t parameters.
+template <typename T>
+constexpr bool kCExportValue =
+    std::is_same_v<T, uintptr_t> ||
+    (std::is_arithmetic_v<T> &&
+     (std::is_floating_point_v<T> || std::numeric_limits<T>::digits <= 32));
+
+template <auto Function>
+struct CExportable;
+
+template <typename R, typename... Args, R (*Function)(Args...)>
+struct CExportable<Function> {
+  static constexpr bool value = (std::is_void_v<R> || kCExportValue<R>) &&
+                                (kCExportValue<Args> && ...);
+};
+
+}  // namespace Skynet
+
+#if FIXED64_C_EXPORTS
+extern "C" {
+
+// EntryPoint-indexed function table indices, 0 for entry points that are not
+// exported
+const uintptr_t *fixed64_export_table();
+
+uint32_t fixed64_export_count();
+}
+#endif
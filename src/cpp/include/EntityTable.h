@@ -0,0 +1,157 @@
+#pragma once
+
+// Columnar entity store in module memory.
+//
+// An EntityTable holds up to `capacity` entities as rows of typed columns.
+// Every column has one, two or three components (Fixed64, Vector2, Vector3),
+// and each component is a separate array of raw int64 values, the layout the
+// batch kernels and StateHash already take. Rows are dense: despawn() moves
+// the last row into the hole, so the first size() values of every component
+// are the live entities. Ids stay fixed for the life of an entity. ids() maps
+// rows to ids and rowOf() maps ids back; the id of a despawned entity is
+// handed out again, the most recently freed first, which keeps spawning
+// deterministic.
+//
+// All memory is taken up front through SimContext::allocate(), the table with
+// create(capacity) and each column with addColumn(). Spawning never allocates,
+// so JS views over the columns (Int32Array pairs or BigInt64Array over
+// column() addresses) stay attached across ticks in a FIXED64_HEAP_SIZE
+// build. The kernels below run on the columns in place, and the queries leave
+// the matching rows in the tick arena (TickArena.h), so positions, velocities
+// and radii never pass through the interop arrays.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Skynet {
+
+class EntityTable {
+ public:
+  static constexpr uint32_t kMaxColumns = 16;
+  static constexpr uint32_t kMaxComponents = 3;
+  // Result of spawn() on a full table and of rowOf() for unknown ids
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  EntityTable(uint32_t capacity, uint32_t *ids, uint32_t *rows,
+              uint32_t *freeIds)
+      : _capacity(capacity), _ids(ids), _rows(rows), _freeIds(freeIds) {}
+  EntityTable(const EntityTable &) = delete;
+  EntityTable &operator=(const EntityTable &) = delete;
+
+  // Id of a new entity with all components zero, kNone if the table is full
+  uint32_t spawn() {
+    if (_size == _capacity) {
+      return kNone;
+    }
+    uint32_t id = _freeCount ? _freeIds[--_freeCount] : _nextId++;
+    uint32_t row = _size++;
+    for (uint32_t column = 0; column < _columnCount; ++column) {
+      for (uint32_t c = 0; c < _components[column]; ++c) {
+        _data[column][c][row] = 0;
+      }
+    }
+    _ids[row] = id;
+    _rows[id] = row;
+    return id;
+  }
+
+  // Removes the entity, moving the last row into its place
+  bool despawn(uint32_t id) {
+    uint32_t row = rowOf(id);
+    if (row == kNone) {
+      return false;
+    }
+    uint32_t last = --_size;
+    if (row != last) {
+      for (uint32_t column = 0; column < _columnCount; ++column) {
+        for (uint32_t c = 0; c < _components[column]; ++c) {
+          _data[column][c][row] = _data[column][c][last];
+        }
+      }
+      _ids[row] = _ids[last];
+      _rows[_ids[row]] = row;
+    }
+    _rows[id] = kNone;
+    _freeIds[_freeCount++] = id;
+    return true;
+  }
+
+  // Row of a live entity, kNone otherwise
+  uint32_t rowOf(uint32_t id) const {
+    return id < _nextId ? _rows[id] : kNone;
+  }
+
+  // A new zeroed column of `components` (1 to 3) values per row, -1 if the
+  // arguments are invalid or the memory is not available
+  int32_t addColumn(uint32_t components);
+
+  // Values of one component, valid for the first size() rows
+  int64_t *component(uint32_t column, uint32_t c) const {
+    return column < _columnCount && c < _components[column]
+               ? _data[column][c]
+               : nullptr;
+  }
+
+  uint32_t components(uint32_t column) const {
+    return column < _columnCount ? _components[column] : 0;
+  }
+
+  const uint32_t *ids() const { return _ids; }
+  uint32_t size() const { return _size; }
+  uint32_t capacity() const { return _capacity; }
+  uint32_t columnCount() const { return _columnCount; }
+
+  // A table of `capacity` entities without columns, nullptr if the memory is
+  // not available
+  static EntityTable *create(uint32_t capacity);
+  static void destroy(EntityTable *table);
+
+  // JS entry points, tables passed as addresses. Values are read from and
+  // written to the interop arrays one component per slot.
+  static uintptr_t createWrapper(uint32_t capacity);
+  static void destroyWrapper(uintptr_t table);
+  static int32_t addColumnWrapper(uintptr_t table, uint32_t components);
+  static uint32_t spawnWrapper(uintptr_t table);
+  static bool despawnWrapper(uintptr_t table, uint32_t id);
+  static uint32_t rowOfWrapper(uintptr_t table, uint32_t id);
+  static uint32_t sizeWrapper(uintptr_t table);
+  static uint32_t capacityWrapper(uintptr_t table);
+  static uintptr_t idsWrapper(uintptr_t table);
+  static uintptr_t columnWrapper(uintptr_t table, uint32_t column,
+                                 uint32_t component);
+  static uint32_t componentsWrapper(uintptr_t table, uint32_t column);
+  static bool set(uintptr_t table, uint32_t column, uint32_t id);
+  static bool get(uintptr_t table, uint32_t column, uint32_t id);
+
+  // Kernels over the first size() rows; false if a column has the wrong
+  // number of components
+  static bool normalize(uintptr_t table, uint32_t column);
+  // position += velocity * param 0, e.g. the tick's delta time
+  static bool integrate(uintptr_t table, uint32_t position,
+                        uint32_t velocity);
+  // Fixed64 column `out` = atan2(y, x) of Vector2 column `vector`
+  static bool atan2(uintptr_t table, uint32_t vector, uint32_t out);
+  // Every column into the bound StateHash, component by component
+  static void hash(uintptr_t table);
+
+  // Rows whose circle (Vector2 or Vector3 column `position`, Fixed64 column
+  // `radius`) overlaps the rect or sector in params 0-7, as a tick arena
+  // view; see Rect::queryCircles
+  static bool queryRect(uintptr_t table, uint32_t position, uint32_t radius);
+  static bool querySector(uintptr_t table, uint32_t position,
+                          uint32_t radius);
+
+ private:
+  uint32_t _capacity;
+  uint32_t _size = 0;
+  uint32_t _nextId = 0;
+  uint32_t _freeCount = 0;
+  uint32_t _columnCount = 0;
+  uint32_t *_ids;      // row -> id
+  uint32_t *_rows;     // id -> row, kNone for free ids
+  uint32_t *_freeIds;  // despawned ids, most recent last
+  uint32_t _components[kMaxColumns] = {};
+  int64_t *_data[kMaxColumns][kMaxComponents] = {};
+};
+
+}  // namespace Skynet
@@ -0,0 +1,229 @@
+#pragma once
+
+// Static entry points bound to JS, one X(owner, name, function) per binding.
+// The owner is the embind class (Module for free functions) and the name the
+// JS-visible function name; statics that share their name with a member
+// overload are cast to their exact type. Bindings, instrumentation and
+// anything else that needs to enumerate the JS surface expand these lists
+// instead of repeating the function names.
+
+namespace Skynet {
+
+// Entry points that only hold their slot in the lists: they keep the entry
+// point ids, the C export table and recordings of all builds in line, but
+// nothing binds them
+template <auto Function>
+inline constexpr bool kPlaceholderEntryPoint = false;
+
+}  // namespace Skynet
+
+// Entry points returning std::string; the lean build keeps their slots with
+// placeholders (see Fixed64Native::toString)
+#define FIXED64_FORMAT_ENTRY_POINTS(X) \
+  X(Fixed64Native, toString, &Fixed64Native::toString)
+
+#define FIXED64_NATIVE_ENTRY_POINTS(X)                                         \
+  X(Fixed64Native, parseFloat, &Fixed64Native::parseFloat)                     \
+  X(Fixed64Native, parseFloatRounded, &Fixed64Native::parseFloatRounded)       \
+  X(Fixed64Native, parseFloatMany, &Fixed64Native::parseFloatMany)             \
+  X(Fixed64Native, div, &Fixed64Native::div)                                   \
+  X(Fixed64Native, toNumber, &Fixed64Native::toNumber)                         \
+  FIXED64_FORMAT_ENTRY_POINTS(X)                                               \
+  X(Fixed64Native, formatDecimal, &Fixed64Native::formatDecimal)               \
+  X(Fixed64Native, parseDecimal, &Fixed64Native::parseDecimal)                 \
+  X(Fixed64Native, formatDecimalMany, &Fixed64Native::formatDecimalMany)       \
+  X(Fixed64Native, parseDecimalMany, &Fixed64Native::parseDecimalMany)         \
+  X(Fixed64Native, abs, &Fixed64Native::abs)                                   \
+  X(Fixed64Native, acos, &Fixed64Native::acos)                                 \
+  X(Fixed64Native, add, &Fixed64Native::add)                                   \
+  X(Fixed64Native, asin, &Fixed64Native::asin)                                 \
+  X(Fixed64Native, atan, &Fixed64Native::atan)                                 \
+  X(Fixed64Native, atan2, &Fixed64Native::atan2)                               \
+  X(Fixed64Native, atan2Deg, &Fixed64Native::atan2Deg)                         \
+  X(Fixed64Native, atan2Heading, &Fixed64Native::atan2Heading)                 \
+  X(Fixed64Native, atan2Many, &Fixed64Native::atan2Many)                       \
+  X(Fixed64Native, atan2DegMany, &Fixed64Native::atan2DegMany)                 \
+  X(Fixed64Native, atan2HeadingMany, &Fixed64Native::atan2HeadingMany)         \
+  X(Fixed64Native, ceil, &Fixed64Native::ceil)                                 \
+  X(Fixed64Native, clamp, &Fixed64Native::clamp)                               \
+  X(Fixed64Native, cos, &Fixed64Native::cos)                                   \
+  X(Fixed64Native, exp, &Fixed64Native::exp)                                   \
+  X(Fixed64Native, floor, &Fixed64Native::floor)                               \
+  X(Fixed64Native, mod, &Fixed64Native::mod)                                   \
+  X(Fixed64Native, mul, &Fixed64Native::mul)                                   \
+  X(Fixed64Native, square, &Fixed64Native::square)                             \
+  X(Fixed64Native, pow2, &Fixed64Native::pow2)                                 \
+  X(Fixed64Native, log2, &Fixed64Native::log2)                                 \
+  X(Fixed64Native, ln, &Fixed64Native::ln)                                     \
+  X(Fixed64Native, pow, &Fixed64Native::pow)                                   \
+  X(Fixed64Native, powInt, &Fixed64Native::powInt)                             \
+  X(Fixed64Native, clz, &Fixed64Native::clz)                                   \
+  X(Fixed64Native, ctz, &Fixed64Native::ctz)                                   \
+  X(Fixed64Native, popcount, &Fixed64Native::popcount)                         \
+  X(Fixed64Native, log2Int, &Fixed64Native::log2Int)                           \
+  X(Fixed64Native, frexp, &Fixed64Native::frexp)                               \
+  X(Fixed64Native, round, &Fixed64Native::round)                               \
+  X(Fixed64Native, sign, &Fixed64Native::sign)                                 \
+  X(Fixed64Native, sin, &Fixed64Native::sin)                                   \
+  X(Fixed64Native, sqrt, &Fixed64Native::sqrt)                                 \
+  X(Fixed64Native, sub, &Fixed64Native::sub)                                   \
+  X(Fixed64Native, tan, &Fixed64Native::tan)                                   \
+  X(Fixed64Native, neg, &Fixed64Native::neg)                                   \
+  X(Fixed64Native, isNaN, &Fixed64Native::isNaN)                               \
+  X(Fixed64Native, isInfinity, &Fixed64Native::isInfinity)                     \
+  X(Fixed64Native, isFinite, &Fixed64Native::isFinite)                         \
+  X(Fixed64Native, isInteger, &Fixed64Native::isInteger)                       \
+  X(Fixed64Native, isNegative, &Fixed64Native::isNegative)                     \
+  X(Fixed64Native, isPositive, &Fixed64Native::isPositive)                     \
+  X(Fixed64Native, isZero, &Fixed64Native::isZero)                             \
+  X(Fixed64Native, gt, &Fixed64Native::gt)                                     \
+  X(Fixed64Native, gte, &Fixed64Native::gte)                                   \
+  X(Fixed64Native, lt, &Fixed64Native::lt)                                     \
+  X(Fixed64Native, lte, &Fixed64Native::lte)                                   \
+  X(Fixed64Native, eq, &Fixed64Native::eq)                                     \
+  X(Fixed64Native, cmp, &Fixed64Native::cmp)                                   \
+  X(Fixed64Native, min, &Fixed64Native::min)                                   \
+  X(Fixed64Native, max, &Fixed64Native::max)                                   \
+  X(Fixed64Native, sum, &Fixed64Native::sum)                                   \
+  X(Fixed64Native, emptyCall, &Fixed64Native::emptyCall)
+
+#define VECTOR2_ENTRY_POINTS(X)                                                \
+  X(Vector2, add, &Vector2::addWrapper)                                        \
+  X(Vector2, sub, &Vector2::subWrapper)                                        \
+  X(Vector2, scalar, &Vector2::scalar)                                         \
+  X(Vector2, normalize, &Vector2::normalizeWrapper)                            \
+  X(Vector2, normalizeMany, &Vector2::normalizeMany)                           \
+  X(Vector2, len, &Vector2::lenWrapper)                                        \
+  X(Vector2, dot, &Vector2::dotWrapper)
+
+#define MODULE_ENTRY_POINTS(X)                                                 \
+  X(Module, abs, &absWrapper)                                                  \
+  X(Module, absSq, &absSqWrapper)                                              \
+  X(Module, det, &detWrapper)                                                  \
+  X(Module, normalize, &normalizeWrapper)
+
+#define VECTOR3_ENTRY_POINTS(X)                                                \
+  X(Vector3, cross, &Vector3::cross)                                           \
+  X(Vector3, dot, &Vector3::dotWrapper)                                        \
+  X(Vector3, add, &Vector3::add)                                               \
+  X(Vector3, sub, &Vector3::sub)                                               \
+  X(Vector3, mul, &Vector3::mul)                                               \
+  X(Vector3, div, &Vector3::div)                                               \
+  X(Vector3, scalar, &Vector3::scalar)                                         \
+  X(Vector3, normalize, &Vector3::normalizeWrapper)                            \
+  X(Vector3, normalizeMany, &Vector3::normalizeMany)                           \
+  X(Vector3, normalizedDirection, &Vector3::normalizedDirection)               \
+  X(Vector3, negative, &Vector3::negative)                                     \
+  X(Vector3, distance, &Vector3::distance)                                     \
+  X(Vector3, squaredDistance, &Vector3::squaredDistanceWrapper)                \
+  X(Vector3, rotateX, &Vector3::rotateXWrapper)                                \
+  X(Vector3, rotateY, &Vector3::rotateYWrapper)                                \
+  X(Vector3, rotateZ, &Vector3::rotateZWrapper)                                \
+  X(Vector3, lerp, &Vector3::lerp)                                             \
+  X(Vector3, lengthSqr, &Vector3::lengthSqrWrapper)                            \
+  X(Vector3, len, &Vector3::len)                                               \
+  X(Vector3, isCircleOverlaps, &Vector3::isCircleOverlaps)                     \
+  X(Vector3, isCircleOverlapsXY,                                               \
+    &Vector3::isCircleOverlapsOnPlane<Plane::XY>)                              \
+  X(Vector3, isCircleOverlapsXZ,                                               \
+    &Vector3::isCircleOverlapsOnPlane<Plane::XZ>)                              \
+  X(Vector3, isLineCircleIntersect, &Vector3::isLineCircleIntersect)           \
+  X(Vector3, decayKnockbackVector, &Vector3::decayKnockbackVectorWrapper)      \
+  X(Vector3, velocityToForward, &Vector3::velocityToForward)                   \
+  X(Vector3, moveForward, &Vector3::moveForwardWrapper)                        \
+  X(Vector3, emptyCall, &Vector3::emptyCall)
+
+#define RECT_ENTRY_POINTS(X)                                                   \
+  X(Rect, overlapsWithCircle,                                                  \
+    static_cast<bool (*)(bool)>(&Rect::overlapsWithCircle))                    \
+  X(Rect, overlapsWithRect, static_cast<bool (*)()>(&Rect::overlapsWithRect))  \
+  X(Rect, containsPoint, static_cast<bool (*)()>(&Rect::containsPoint))        \
+  X(Rect, overlapsWithCircleXY, &Rect::overlapsWithCircleOnPlane<Plane::XY>)   \
+  X(Rect, overlapsWithCircleXZ, &Rect::overlapsWithCircleOnPlane<Plane::XZ>)   \
+  X(Rect, overlapsWithRectXY, &Rect::overlapsWithRectOnPlane<Plane::XY>)       \
+  X(Rect, overlapsWithRectXZ, &Rect::overlapsWithRectOnPlane<Plane::XZ>)       \
+  X(Rect, containsPointXY, &Rect::containsPointOnPlane<Plane::XY>)             \
+  X(Rect, containsPointXZ, &Rect::containsPointOnPlane<Plane::XZ>)             \
+  X(Rect, queryCircles, &Rect::queryCircles)
+
+#define SECTOR_ENTRY_POINTS(X)                                                 \
+  X(Sector, overlapsWithCircle,                                                \
+    static_cast<bool (*)()>(&Sector::overlapsWithCircle))                      \
+  X(Sector, queryCircles, &Sector::queryCircles)
+
+#define STATE_HASH_ENTRY_POINTS(X)                                             \
+  X(StateHash, reset, &StateHash::resetWrapper)                                \
+  X(StateHash, updateParams, &StateHash::updateParams)                         \
+  X(StateHash, updateBytes, &StateHash::updateBytes)                           \
+  X(StateHash, updateColumn, &StateHash::updateColumn)                         \
+  X(StateHash, updateVector2Columns, &StateHash::updateVector2Columns)         \
+  X(StateHash, updateVector3Columns, &StateHash::updateVector3Columns)         \
+  X(StateHash, digest, &StateHash::digestWrapper)
+
+#define SNAPSHOT_ENTRY_POINTS(X)                                               \
+  X(Snapshot, encode, &Snapshot::encode)                                       \
+  X(Snapshot, decode, &Snapshot::decode)                                       \
+  X(Snapshot, decodedCount, &Snapshot::decodedCount)                           \
+  X(Snapshot, maxEncodedSize, &Snapshot::maxEncodedSizeWrapper)
+
+#define JOB_POOL_ENTRY_POINTS(X)                                               \
+  X(JobPool, setWorkerCount, &JobPool::setWorkerCount)                         \
+  X(JobPool, workerCount, &JobPool::workerCount)
+
+#define SIM_CONTEXT_ENTRY_POINTS(X)                                            \
+  X(SimContext, create, &SimContext::createWrapper)                            \
+  X(SimContext, destroy, &SimContext::destroyWrapper)                          \
+  X(SimContext, bind, &SimContext::bindWrapper)                                \
+  X(SimContext, current, &SimContext::currentWrapper)                          \
+  X(SimContext, setWorldType, &SimContext::setWorldType)                       \
+  X(SimContext, worldType, &SimContext::worldTypeWrapper)                      \
+  X(SimContext, reserveTickArena, &SimContext::reserveTickArena)               \
+  X(SimContext, beginTick, &SimContext::beginTick)                             \
+  X(SimContext, tickArena, &SimContext::tickArenaWrapper)                      \
+  X(SimContext, tickArenaUsed, &SimContext::tickArenaUsed)                     \
+  X(SimContext, tickArenaPeak, &SimContext::tickArenaPeak)                     \
+  X(SimContext, tickArenaOverflows, &SimContext::tickArenaOverflows)           \
+  X(SimContext, resetTickArenaStats, &SimContext::resetTickArenaStats)
+
+#define ARENA_ENTRY_POINTS(X)                                                  \
+  X(Arena, create, &Arena::createWrapper)                                      \
+  X(Arena, destroy, &Arena::destroyWrapper)                                    \
+  X(Arena, allocate, &Arena::allocateWrapper)                                  \
+  X(Arena, reset, &Arena::resetWrapper)                                        \
+  X(Arena, used, &Arena::usedWrapper)                                          \
+  X(Arena, capacity, &Arena::capacityWrapper)
+
+#define ENTITY_TABLE_ENTRY_POINTS(X)                                           \
+  X(EntityTable, create, &EntityTable::createWrapper)                          \
+  X(EntityTable, destroy, &EntityTable::destroyWrapper)                        \
+  X(EntityTable, addColumn, &EntityTable::addColumnWrapper)                    \
+  X(EntityTable, spawn, &EntityTable::spawnWrapper)                            \
+  X(EntityTable, despawn, &EntityTable::despawnWrapper)                        \
+  X(EntityTable, rowOf, &EntityTable::rowOfWrapper)                            \
+  X(EntityTable, size, &EntityTable::sizeWrapper)                              \
+  X(EntityTable, capacity, &EntityTable::capacityWrapper)                      \
+  X(EntityTable, ids, &EntityTable::idsWrapper)                                \
+  X(EntityTable, column, &EntityTable::columnWrapper)                          \
+  X(EntityTable, components, &EntityTable::componentsWrapper)                  \
+  X(EntityTable, set, &EntityTable::set)                                       \
+  X(EntityTable, get, &EntityTable::get)                                       \
+  X(EntityTable, normalize, &EntityTable::normalize)                           \
+  X(EntityTable, integrate, &EntityTable::integrate)                           \
+  X(EntityTable, atan2, &EntityTable::atan2)                                   \
+  X(EntityTable, hash, &EntityTable::hash)                                     \
+  X(EntityTable, queryRect, &EntityTable::queryRect)                           \
+  X(EntityTable, querySector, &EntityTable::querySector)
+
+#define FIXED64_ENTRY_POINTS(X)                                                \
+  FIXED64_NATIVE_ENTRY_POINTS(X)                                               \
+  VECTOR2_ENTRY_POINTS(X)                                                      \
+  MODULE_ENTRY_POINTS(X)                                                       \
+  VECTOR3_ENTRY_POINTS(X)                                                      \
+  RECT_ENTRY_POINTS(X)                                                         \
+  SECTOR_ENTRY_POINTS(X)                                                       \
+  STATE_HASH_ENTRY_POINTS(X)                                                   \
+  SNAPSHOT_ENTRY_POINTS(X)                                                     \
+  JOB_POOL_ENTRY_POINTS(X)                                                     \
+  SIM_CONTEXT_ENTRY_POINTS(X)                                                  \
+  ARENA_ENTRY_POINTS(X)                                                        \
+  ENTITY_TABLE_ENTRY_POINTS(X)
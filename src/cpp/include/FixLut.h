@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bit>
 #include <cstdint>
 
 namespace Skynet
@@ -93,6 +94,115 @@ namespace Skynet
       return v2;
     }
 
+    // floor(sqrt(value)) for any 64-bit value. The CLZ-normalized top byte
+    // picks a seed from SqrtLut (~8 bits), two Newton steps take it past 32
+    // bits and the final loops correct the truncation by at most one.
+    static uint64_t isqrt(uint64_t value)
+    {
+      if (value == 0)
+      {
+        return 0;
+      }
+
+      int shift = std::countl_zero(value) & ~1;
+      uint64_t normalized = value << shift;
+      uint64_t root = static_cast<uint64_t>(SqrtLut[(normalized >> 56) - 64]) << 16;
+      root >>= shift >> 1;
+
+      root = (root + value / root) >> 1;
+      root = (root + value / root) >> 1;
+
+      if (root > 0xFFFFFFFFULL)
+      {
+        root = 0xFFFFFFFFULL;
+      }
+      while (root * root > value)
+      {
+        --root;
+      }
+      while (root < 0xFFFFFFFFULL && (root + 1) * (root + 1) <= value)
+      {
+        ++root;
+      }
+      return root;
+    }
+
+    // Reciprocal square root of a non-zero value as a Q30 mantissa in
+    // (2^30, 2^31], with 1 / sqrt(value) = mantissa * 2^(halfShift - 62).
+    // RsqrtLut seeds the CLZ-normalized value and two multiply-only
+    // Newton-Raphson steps refine it to ~29 bits.
+    static uint64_t rsqrt(uint64_t value, int &halfShift)
+    {
+      int shift = std::countl_zero(value) & ~1;
+      halfShift = shift >> 1;
+
+      uint64_t x = (value << shift) >> 32;
+      uint64_t y = static_cast<uint64_t>(RsqrtLut[(x >> 24) - 64]);
+      for (int i = 0; i < 2; ++i)
+      {
+        uint64_t xy2 = (x * ((y * y) >> 30)) >> 32;
+        y = (y * ((3ULL << 30) - xy2)) >> 31;
+      }
+      return y;
+    }
+
+    // Reciprocal of a non-zero value as a Q30 mantissa in (2^30, 2^31], with
+    // 1 / value = mantissa * 2^(shift - 94). RcpLut seeds the CLZ-normalized
+    // value to ~9 bits and one multiply-only Newton-Raphson step refines it
+    // to ~18 bits.
+    static int64_t rcp(uint64_t value, int &shift)
+    {
+      shift = std::countl_zero(value);
+
+      int64_t x = (int64_t)((value << shift) >> 33);
+      int64_t y = RcpLut[(x >> 22) - 256];
+      int64_t error = (1LL << 61) - x * y;
+      return y + ((y * (error >> 30)) >> 31);
+    }
+
+    // log2(value) of a non-zero integer in Q30. The CLZ position gives the
+    // integer part, Log2Lut is interpolated over the bits below it.
+    static int64_t log2(uint64_t value)
+    {
+      int exponent = 63 - std::countl_zero(value);
+      uint64_t fraction = (value << (63 - exponent)) << 1;
+      int index = (int)(fraction >> 56);
+      int64_t weight = (int64_t)((fraction >> 34) & ((1ULL << 22) - 1));
+      int64_t a = Log2Lut[index];
+      int64_t b = Log2Lut[index + 1];
+      return ((int64_t)exponent << 30) + a + (((b - a) * weight) >> 22);
+    }
+
+    // 2^value for a Q30 exponent, returned as a raw Q16 value. Exp2Lut is
+    // interpolated for the fractional part; results saturate at INT64_MAX
+    // and round to the nearest raw value below one.
+    static int64_t exp2(int64_t value)
+    {
+      int64_t exponent = value >> 30;
+      int64_t fraction = value & ((1LL << 30) - 1);
+      int index = (int)(fraction >> 22);
+      int64_t weight = fraction & ((1LL << 22) - 1);
+      int64_t a = Exp2Lut[index];
+      int64_t b = Exp2Lut[index + 1];
+      int64_t mantissa = a + (((b - a) * weight) >> 22);
+
+      // mantissa is in [2^30, 2^31), the Q16 result is mantissa * 2^(exponent - 14)
+      int64_t shift = exponent - (30 - PRECISION);
+      if (shift > 31)
+      {
+        return INT64_MAX;
+      }
+      if (shift >= 0)
+      {
+        return mantissa << shift;
+      }
+      if (shift < -31)
+      {
+        return 0;
+      }
+      return (mantissa + (1LL << (-shift - 1))) >> -shift;
+    }
+
     static inline const int64_t SinLut[] = {
         0, 804, 1608, 2412, 3216, 4019, 4821, 5623, 6424,
         7224, 8022, 8820, 9616, 10411, 11204, 11996, 12785, 13573,
@@ -347,5 +457,206 @@ namespace Skynet
         78926, 79651, 80398, 81170, 81969, 82798, 83662, 84566, 85515,
         86517, 87583, 88727, 89970, 91343, 92901, 94746, 102944, 102944,
         102944};
+
+    // sqrt(i + 64.5) * 2^12 for the top byte i + 64 of a normalized value,
+    // i.e. the root of the bucket midpoint in units of 2^16.
+    static inline const int64_t SqrtLut[] = {
+        32896, 33150, 33402, 33652, 33900, 34147, 34392, 34635, 34876,
+        35116, 35354, 35590, 35825, 36059, 36291, 36521, 36750, 36978,
+        37204, 37429, 37652, 37874, 38095, 38315, 38533, 38750, 38966,
+        39181, 39394, 39606, 39818, 40028, 40237, 40445, 40652, 40857,
+        41062, 41266, 41469, 41671, 41871, 42071, 42270, 42468, 42665,
+        42861, 43057, 43251, 43445, 43637, 43829, 44020, 44210, 44400,
+        44588, 44776, 44963, 45149, 45334, 45519, 45703, 45886, 46069,
+        46250, 46431, 46612, 46791, 46970, 47149, 47326, 47503, 47679,
+        47855, 48030, 48204, 48378, 48551, 48723, 48895, 49067, 49237,
+        49407, 49577, 49746, 49914, 50082, 50249, 50416, 50582, 50747,
+        50912, 51077, 51241, 51404, 51567, 51730, 51892, 52053, 52214,
+        52374, 52534, 52694, 52853, 53011, 53169, 53327, 53484, 53640,
+        53797, 53952, 54108, 54262, 54417, 54571, 54724, 54877, 55030,
+        55182, 55334, 55485, 55636, 55787, 55937, 56087, 56236, 56385,
+        56534, 56682, 56830, 56977, 57124, 57271, 57417, 57563, 57709,
+        57854, 57999, 58143, 58287, 58431, 58574, 58717, 58860, 59002,
+        59144, 59286, 59427, 59568, 59709, 59849, 59989, 60129, 60268,
+        60407, 60546, 60684, 60822, 60960, 61098, 61235, 61372, 61508,
+        61644, 61780, 61916, 62051, 62186, 62321, 62456, 62590, 62724,
+        62857, 62991, 63124, 63256, 63389, 63521, 63653, 63785, 63916,
+        64047, 64178, 64309, 64439, 64569, 64699, 64828, 64957, 65086,
+        65215, 65344, 65472};
+
+    // 2^30 / sqrt((i + 64.5) / 256): Q30 reciprocal root of the bucket
+    // midpoint for the top byte i + 64 of a normalized value.
+    static inline const int64_t RsqrtLut[] = {
+        2139143874, 2122751726, 2106730729, 2091067086, 2075747707, 2060760163,
+        2046092644, 2031733922, 2017673311, 2003900636, 1990406202, 1977180765,
+        1964215505, 1951502003, 1939032214, 1926798450, 1914793358, 1903009903,
+        1891441346, 1880081235, 1868923385, 1857961863, 1847190978, 1836605270,
+        1826199490, 1815968600, 1805907755, 1796012296, 1786277740, 1776699774,
+        1767274245, 1757997150, 1748864636, 1739872984, 1731018611, 1722298059,
+        1713707990, 1705245183, 1696906526, 1688689013, 1680589738, 1672605894,
+        1664734763, 1656973720, 1649320221, 1641771805, 1634326089, 1626980766,
+        1619733600, 1612582423, 1605525136, 1598559701, 1591684144, 1584896547,
+        1578195052, 1571577853, 1565043197, 1558589383, 1552214758, 1545917715,
+        1539696693, 1533550174, 1527476684, 1521474788, 1515543090, 1509680232,
+        1503884893, 1498155787, 1492491662, 1486891298, 1481353508, 1475877137,
+        1470461055, 1465104167, 1459805400, 1454563712, 1449378085, 1444247527,
+        1439171070, 1434147770, 1429176706, 1424256978, 1419387709, 1414568043,
+        1409797142, 1405074190, 1400398389, 1395768961, 1391185142, 1386646190,
+        1382151377, 1377699992, 1373291341, 1368924744, 1364599536, 1360315069,
+        1356070705, 1351865825, 1347699819, 1343572091, 1339482060, 1335429155,
+        1331412818, 1327432501, 1323487671, 1319577802, 1315702382, 1311860907,
+        1308052885, 1304277832, 1300535277, 1296824755, 1293145812, 1289498003,
+        1285880891, 1282294047, 1278737053, 1275209495, 1271710972, 1268241085,
+        1264799448, 1261385678, 1257999402, 1254640252, 1251307868, 1248001897,
+        1244721991, 1241467811, 1238239020, 1235035292, 1231856302, 1228701736,
+        1225571280, 1222464631, 1219381487, 1216321553, 1213284541, 1210270165,
+        1207278145, 1204308207, 1201360079, 1198433497, 1195528200, 1192643930,
+        1189780435, 1186937467, 1184114781, 1181312139, 1178529303, 1175766042,
+        1173022127, 1170297333, 1167591440, 1164904229, 1162235487, 1159585004,
+        1156952571, 1154337986, 1151741047, 1149161556, 1146599320, 1144054146,
+        1141525847, 1139014236, 1136519130, 1134040351, 1131577719, 1129131062,
+        1126700207, 1124284984, 1121885226, 1119500771, 1117131454, 1114777118,
+        1112437604, 1110112758, 1107802427, 1105506461, 1103224711, 1100957032,
+        1098703280, 1096463311, 1094236988, 1092024170, 1089824724, 1087638513,
+        1085465407, 1083305275, 1081157988, 1079023419, 1076901444, 1074791939};
+
+    // 2^39 / (i + 256.5): Q30 reciprocal of the bucket midpoint for the top
+    // nine bits i + 256 of a normalized value.
+    static inline const int64_t RcpLut[] = {
+        2143297520, 2134974035, 2126714947, 2118519514, 2110387001, 2102316688,
+        2094307862, 2086359825, 2078471886, 2070643367, 2062873598, 2055161921,
+        2047507687, 2039910256, 2032368998, 2024883292, 2017452528, 2010076102,
+        2002753420, 1995483898, 1988266958, 1981102032, 1973988560, 1966925989,
+        1959913775, 1952951381, 1946038279, 1939173947, 1932357870, 1925589541,
+        1918868460, 1912194135, 1905566079, 1898983813, 1892446864, 1885954765,
+        1879507056, 1873103284, 1866743001, 1860425766, 1854151143, 1847918702,
+        1841728020, 1835578677, 1829470263, 1823402368, 1817374591, 1811386537,
+        1805437812, 1799528032, 1793656815, 1787823785, 1782028570, 1776270804,
+        1770550125, 1764866176, 1759218604, 1753607062, 1748031205, 1742490694,
+        1736985194, 1731514374, 1726077909, 1720675474, 1715306752, 1709971427,
+        1704669190, 1699399734, 1694162755, 1688957954, 1683785035, 1678643707,
+        1673533680, 1668454670, 1663406396, 1658388579, 1653400944, 1648443220,
+        1643515139, 1638616435, 1633746847, 1628906115, 1624093985, 1619310203,
+        1614554519, 1609826688, 1605126464, 1600453607, 1595807878, 1591189042,
+        1586596865, 1582031119, 1577491575, 1572978008, 1568490197, 1564027920,
+        1559590961, 1555179106, 1550792141, 1546429856, 1542092045, 1537778500,
+        1533489021, 1529223404, 1524981453, 1520762971, 1516567762, 1512395637,
+        1508246403, 1504119874, 1500015863, 1495934187, 1491874665, 1487837115,
+        1483821360, 1479827224, 1475854534, 1471903116, 1467972801, 1464063419,
+        1460174804, 1456306792, 1452459218, 1448631921, 1444824741, 1441037520,
+        1437270102, 1433522331, 1429794054, 1426085120, 1422395379, 1418724681,
+        1415072880, 1411439830, 1407825388, 1404229410, 1400651755, 1397092284,
+        1393550859, 1390027342, 1386521599, 1383033494, 1379562896, 1376109672,
+        1372673693, 1369254829, 1365852954, 1362467940, 1359099664, 1355748000,
+        1352412826, 1349094022, 1345791466, 1342505040, 1339234626, 1335980107,
+        1332741367, 1329518292, 1326310769, 1323118686, 1319941930, 1316780393,
+        1313633964, 1310502536, 1307386002, 1304284256, 1301197193, 1298124708,
+        1295066699, 1292023064, 1288993702, 1285978512, 1282977395, 1279990254,
+        1277016989, 1274057506, 1271111708, 1268179501, 1265260791, 1262355485,
+        1259463491, 1256584717, 1253719074, 1250866471, 1248026819, 1245200031,
+        1242386020, 1239584699, 1236795982, 1234019784, 1231256022, 1228504612,
+        1225765471, 1223038518, 1220323671, 1217620850, 1214929975, 1212250968,
+        1209583749, 1206928241, 1204284368, 1201652052, 1199031219, 1196421793,
+        1193823700, 1191236866, 1188661219, 1186096686, 1183543195, 1181000674,
+        1178469054, 1175948265, 1173438237, 1170938901, 1168450189, 1165972034,
+        1163504368, 1161047125, 1158600240, 1156163646, 1153737280, 1151321076,
+        1148914972, 1146518903, 1144132807, 1141756623, 1139390288, 1137033741,
+        1134686922, 1132349771, 1130022228, 1127704234, 1125395730, 1123096658,
+        1120806960, 1118526580, 1116255460, 1113993544, 1111740776, 1109497102,
+        1107262465, 1105036812, 1102820088, 1100612240, 1098413215, 1096222959,
+        1094041421, 1091868548, 1089704289, 1087548593, 1085401409, 1083262687,
+        1081132377, 1079010430, 1076896795, 1074791425};
+
+    // log2(1 + i / 256) in Q30.
+    static inline const int64_t Log2Lut[] = {
+        0, 6039314, 12055174, 18047761, 24017256, 29963836,
+        35887675, 41788947, 47667823, 53524472, 59359063, 65171760,
+        70962728, 76732128, 82480119, 88206862, 93912511, 99597222,
+        105261148, 110904440, 116527248, 122129721, 127712004, 133274244,
+        138816582, 144339162, 149842124, 155325606, 160789745, 166234679,
+        171660541, 177067464, 182455581, 187825021, 193175914, 198508388,
+        203822568, 209118580, 214396548, 219656594, 224898839, 230123404,
+        235330407, 240519966, 245692198, 250847218, 255985140, 261106077,
+        266210141, 271297442, 276368092, 281422197, 286459867, 291481207,
+        296486323, 301475319, 306448299, 311405366, 316346620, 321272163,
+        326182095, 331076513, 335955515, 340819199, 345667660, 350500993,
+        355319292, 360122651, 364911162, 369684916, 374444004, 379188517,
+        383918542, 388634168, 393335482, 398022572, 402695523, 407354420,
+        411999347, 416630388, 421247625, 425851141, 430441017, 435017334,
+        439580170, 444129607, 448665721, 453188592, 457698295, 462194908,
+        466678506, 471149164, 475606957, 480051959, 484484242, 488903880,
+        493310944, 497705506, 502087636, 506457405, 510814882, 515160136,
+        519493235, 523814248, 528123241, 532420281, 536705435, 540978767,
+        545240343, 549490228, 553728485, 557955178, 562170370, 566374123,
+        570566499, 574747559, 578917365, 583075977, 587223455, 591359858,
+        595485245, 599599675, 603703206, 607795895, 611877800, 615948977,
+        620009483, 624059373, 628098702, 632127527, 636145900, 640153876,
+        644151509, 648138853, 652115959, 656082880, 660039669, 663986377,
+        667923055, 671849754, 675766525, 679673418, 683570481, 687457766,
+        691335320, 695203192, 699061430, 702910083, 706749198, 710578822,
+        714399001, 718209783, 722011213, 725803337, 729586201, 733359850,
+        737124328, 740879680, 744625951, 748363183, 752091421, 755810707,
+        759521085, 763222597, 766915285, 770599192, 774274358, 777940826,
+        781598637, 785247830, 788888448, 792520529, 796144114, 799759243,
+        803365955, 806964289, 810554283, 814135978, 817709409, 821274617,
+        824831638, 828380510, 831921271, 835453956, 838978604, 842495250,
+        846003931, 849504683, 852997541, 856482542, 859959719, 863429109,
+        866890747, 870344666, 873790901, 877229486, 880660455, 884083842,
+        887499680, 890908003, 894308843, 897702233, 901088206, 904466794,
+        907838029, 911201944, 914558569, 917907937, 921250079, 924585025,
+        927912807, 931233456, 934547002, 937853475, 941152905, 944445323,
+        947730758, 951009239, 954280797, 957545460, 960803257, 964054218,
+        967298370, 970535742, 973766362, 976990259, 980207461, 983417995,
+        986621888, 989819169, 993009864, 996194001, 999371606, 1002542707,
+        1005707329, 1008865499, 1012017244, 1015162589, 1018301561, 1021434185,
+        1024560487, 1027680492, 1030794226, 1033901713, 1037002979, 1040098049,
+        1043186948, 1046269699, 1049346328, 1052416858, 1055481314, 1058539720,
+        1061592099, 1064638476, 1067678873, 1070713315, 1073741824};
+
+    // 2^(i / 256) in Q30.
+    static inline const int64_t Exp2Lut[] = {
+        1073741824, 1076653033, 1079572136, 1082499153, 1085434106, 1088377016,
+        1091327906, 1094286796, 1097253708, 1100228665, 1103211687, 1106202798,
+        1109202018, 1112209370, 1115224875, 1118248556, 1121280436, 1124320536,
+        1127368878, 1130425485, 1133490379, 1136563583, 1139645120, 1142735011,
+        1145833280, 1148939949, 1152055042, 1155178580, 1158310587, 1161451085,
+        1164600099, 1167757650, 1170923762, 1174098458, 1177281762, 1180473697,
+        1183674286, 1186883552, 1190101520, 1193328213, 1196563654, 1199807867,
+        1203060876, 1206322705, 1209593378, 1212872918, 1216161350, 1219458698,
+        1222764986, 1226080238, 1229404479, 1232737732, 1236080024, 1239431376,
+        1242791816, 1246161366, 1249540052, 1252927899, 1256324931, 1259731174,
+        1263146652, 1266571390, 1270005413, 1273448747, 1276901417, 1280363448,
+        1283834865, 1287315695, 1290805962, 1294305692, 1297814910, 1301333643,
+        1304861917, 1308399756, 1311947188, 1315504238, 1319070932, 1322647296,
+        1326233356, 1329829140, 1333434672, 1337049980, 1340675091, 1344310030,
+        1347954824, 1351609500, 1355274085, 1358948606, 1362633090, 1366327563,
+        1370032052, 1373746586, 1377471191, 1381205894, 1384950723, 1388705706,
+        1392470869, 1396246240, 1400031848, 1403827719, 1407633882, 1411450365,
+        1415277195, 1419114401, 1422962010, 1426820052, 1430688553, 1434567544,
+        1438457051, 1442357104, 1446267730, 1450188960, 1454120821, 1458063343,
+        1462016553, 1465980482, 1469955159, 1473940611, 1477936870, 1481943963,
+        1485961921, 1489990772, 1494030547, 1498081275, 1502142985, 1506215708,
+        1510299473, 1514394310, 1518500250, 1522617322, 1526745556, 1530884983,
+        1535035634, 1539197537, 1543370725, 1547555228, 1551751076, 1555958300,
+        1560176931, 1564406999, 1568648537, 1572901575, 1577166143, 1581442275,
+        1585730000, 1590029350, 1594340357, 1598663052, 1602997467, 1607343634,
+        1611701585, 1616071351, 1620452965, 1624846459, 1629251865, 1633669214,
+        1638098541, 1642539877, 1646993254, 1651458706, 1655936265, 1660425963,
+        1664927835, 1669441912, 1673968228, 1678506817, 1683057710, 1687620943,
+        1692196547, 1696784557, 1701385007, 1705997930, 1710623359, 1715261330,
+        1719911875, 1724575029, 1729250827, 1733939301, 1738640488, 1743354420,
+        1748081133, 1752820662, 1757573041, 1762338305, 1767116489, 1771907628,
+        1776711757, 1781528911, 1786359126, 1791202437, 1796058879, 1800928489,
+        1805811301, 1810707353, 1815616678, 1820539314, 1825475297, 1830424663,
+        1835387448, 1840363688, 1845353420, 1850356681, 1855373507, 1860403934,
+        1865448001, 1870505744, 1875577199, 1880662405, 1885761398, 1890874216,
+        1896000896, 1901141476, 1906295993, 1911464486, 1916646992, 1921843549,
+        1927054196, 1932278970, 1937517909, 1942771053, 1948038440, 1953320108,
+        1958616096, 1963926443, 1969251188, 1974590370, 1979944027, 1985312200,
+        1990694927, 1996092249, 2001504204, 2006930832, 2012372174, 2017828268,
+        2023299156, 2028784876, 2034285470, 2039800978, 2045331439, 2050876895,
+        2056437387, 2062012954, 2067603638, 2073209480, 2078830522, 2084466803,
+        2090118366, 2095785251, 2101467502, 2107165158, 2112878262, 2118606857,
+        2124350982, 2130110682, 2135885998, 2141676973, 2147483648};
   };
-}
\ No newline at end of file
+}
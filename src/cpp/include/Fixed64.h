@@ -1,15 +1,13 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
-#include <iomanip>
-#include <sstream>
-#include <stdexcept>
-#include <string>
-#include <vector>
+#include <type_traits>
 
 #include "FixLut.h"
+#include "FixedConvert.h"
+#include "FixedDecimal.h"
 
 namespace Skynet {
 struct Fixed64Param {
@@ -39,37 +37,30 @@ class Fixed64 {
     return Fixed64(value << FixLut::PRECISION);
   }
 
-  // Convert to string
-  std::string toString() const {
-    return std::to_string(static_cast<double>(*this));
-  }
-
-  // Convert a string to Fixed64
-  static Fixed64 fromString(const std::string &str) {
-    try {
-      // Attempt to convert the string to a double
-      double value = std::stod(str);
-      // Create a Fixed64 object
-      Fixed64 fixed;
-      // Use the parseFloat member function to convert the double to Fixed64
-      fixed.parseFloat(value);
-      return fixed;
-    } catch (const std::invalid_argument &e) {
-      // If conversion fails (invalid input string), throw an exception
-      throw std::invalid_argument("Invalid string for Fixed64 conversion");
-    } catch (const std::out_of_range &e) {
-      // If the conversion result is out of range, throw an exception
-      throw std::out_of_range(
-          "String value out of range for Fixed64 conversion");
-    }
+  // Writes the value as decimal text with at most `digits` fractional digits
+  // into `buffer`, see FixedDecimal::format. Returns the length, 0 if the
+  // buffer is too small.
+  size_t toChars(char *buffer, size_t capacity,
+                 int digits = FixedDecimal::kDefaultDigits) const {
+    return FixedDecimal::format(value, buffer, capacity, digits);
+  }
+
+  static bool fromChars(const char *text, size_t length, Fixed64 &out) {
+    return FixedDecimal::parse(text, length, out.value);
   }
 
+  // Rounds with FixedConvert::kDefaultRounding, see FixedConvert.h
   template <typename T>
   void parseFloat(const T &value) {
-    int64_t integerPart = static_cast<int64_t>(std::floor(value));
-    T fractionalPart = value - integerPart;
-    this->value = (integerPart << FixLut::PRECISION) +
-                  static_cast<int64_t>(fractionalPart * FixLut::ONE);
+    if constexpr (std::is_same_v<T, float>) {
+      this->value = FixedConvert::fromFloat(value);
+    } else {
+      this->value = FixedConvert::fromDouble(static_cast<double>(value));
+    }
+  }
+
+  static Fixed64 fromDouble(double value, FixedRounding rounding) {
+    return Fixed64(FixedConvert::fromDouble(value, rounding));
   }
 
   Fixed64(const Fixed64Param &param) {
@@ -385,9 +376,9 @@ class Fixed64 {
     return value == obj.value;
   }  // Determines if another object is equal to this instance
 
-  // Get hash code
+  // Get hash code, folded like C#'s Int64.GetHashCode
   std::size_t GetHashCode() const {
-    return std::hash<int64_t>()(value);
+    return static_cast<std::size_t>(value ^ (value >> 32));
   }  // Computes the hash code for the value
 
   static constexpr int Size = 8;  // Size of the Fixed64 type in bytes
@@ -406,22 +397,6 @@ inline bool operator<=(const Fixed64Param &a, const Fixed64Param &b) {
   return !(a > b);
 }
 
-inline std::ostream &operator<<(std::ostream &os, const Fixed64 &obj) {
-  os << obj.toString();
-  return os;
-}
-
-inline std::ostream &operator<<(std::ostream &os, const Fixed64Param &obj) {
-  os << obj.isRaw;
-  if (obj.isRaw) {
-    os << obj.raw;
-  } else {
-    os << obj.high << "," << obj.low;
-  }
-
-  return os;
-}
-
 class Fixed64Const {
  public:
   static constexpr Fixed64 Max = Fixed64(INT64_MAX);
@@ -0,0 +1,76 @@
+#pragma once
+
+// Optional std::string and iostream formatting of the math types.
+//
+// The math headers only offer the allocation-free Fixed64::toChars and
+// Fixed64::fromChars (see FixedDecimal.h), so a build that never includes
+// this header carries no string formatting or stream code. Tools, tests and
+// the non-lean bindings include it for readable output.
+
+#include <cstdlib>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+#include "Fixed64.h"
+#include "FixedDecimal.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+namespace Skynet {
+
+// Decimal text, exact to FixedDecimal::kDefaultDigits digits
+inline std::string toString(Fixed64 value) {
+  char buffer[FixedDecimal::kMaxLength];
+  return std::string(buffer, value.toChars(buffer, sizeof(buffer)));
+}
+
+inline std::string toString(const Vector2 &vector) {
+  return "{x: " + toString(vector.x()) + ", y: " + toString(vector.y()) + "}";
+}
+
+inline std::string toString(const Vector3 &vector) {
+  return "{x: " + toString(vector.x()) + ", y: " + toString(vector.y()) +
+         ", z: " + toString(vector.z()) + "}";
+}
+
+// Parses decimal text, rounding to the nearest value; throws
+// std::invalid_argument on malformed text, or aborts when compiled without
+// exceptions (FIXED64_LEAN)
+inline Fixed64 parseFixed64(const std::string &text) {
+  Fixed64 value;
+  if (!Fixed64::fromChars(text.data(), text.size(), value)) {
+#if __cpp_exceptions
+    throw std::invalid_argument("Invalid string for Fixed64 conversion");
+#else
+    std::abort();
+#endif
+  }
+  return value;
+}
+
+inline std::ostream &operator<<(std::ostream &os, Fixed64 value) {
+  return os << toString(value);
+}
+
+inline std::ostream &operator<<(std::ostream &os, const Fixed64Param &param) {
+  os << param.isRaw;
+  if (param.isRaw) {
+    os << param.raw;
+  } else {
+    os << param.high << "," << param.low;
+  }
+  return os;
+}
+
+inline std::ostream &operator<<(std::ostream &os, const Vector2 &vector) {
+  return os << "(" << toString(vector.x()) << "," << toString(vector.y())
+            << ")";
+}
+
+inline std::ostream &operator<<(std::ostream &os, const Vector3 &vector) {
+  return os << "(" << toString(vector.x()) << "," << toString(vector.y())
+            << "," << toString(vector.z()) << ")";
+}
+
+}  // namespace Skynet
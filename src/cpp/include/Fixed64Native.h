@@ -1,11 +1,15 @@
 #pragma once
 
 #include <cmath>
-#include <iomanip>
+#if !FIXED64_LEAN
+#include <string>
+#endif
 
+#include "EntryPoints.h"
 #include "Fixed64.h"
 #include "FixedMath.h"
 #include "Interop.h"
+#include "JobPool.h"
 
 namespace Skynet {
 class Fixed64Native {
@@ -15,6 +19,25 @@ class Fixed64Native {
     getInteropReturnArray()[0] = static_cast<Fixed64Param>(result);
   }
 
+  // `rounding` is a FixedRounding
+  static void parseFloatRounded(double value, uint32_t rounding) {
+    Fixed64 result =
+        Fixed64::fromDouble(value, static_cast<FixedRounding>(rounding));
+    getInteropReturnArray()[0] = static_cast<Fixed64Param>(result);
+  }
+
+  // Converts `count` doubles at `values` into raw Fixed64 values at `out`
+  static void parseFloatMany(uintptr_t values, uint32_t count, uintptr_t out,
+                             uint32_t rounding) {
+    const double *in = reinterpret_cast<const double *>(values);
+    int64_t *raw = reinterpret_cast<int64_t *>(out);
+    JobPool::parallelFor(
+        count, JobPool::kBatchGrain, [&](uint32_t begin, uint32_t end) {
+          FixedConvert::fromDoubles(in + begin, end - begin, raw + begin,
+                                    static_cast<FixedRounding>(rounding));
+        });
+  }
+
   static void div() {
     Fixed64 fx(getInteropParamArray()[0]);
     Fixed64 fy(getInteropParamArray()[1]);
@@ -27,9 +50,57 @@ class Fixed64Native {
     return static_cast<double>(fn);
   }
 
+#if !FIXED64_LEAN
+  // Allocates a std::string for embind; formatDecimal is the lean way out
   static std::string toString() {
     Fixed64 fn(getInteropParamArray()[0]);
-    return fn.toString();
+    char buffer[FixedDecimal::kMaxLength];
+    return std::string(buffer, fn.toChars(buffer, sizeof(buffer)));
+  }
+#else
+  // Holds the slot of toString in the entry point lists, never bound
+  static void toString() {}
+#endif
+
+  // Formats param 0 into the interop char array, returns the length
+  static uint32_t formatDecimal(int digits) {
+    Fixed64 fn(getInteropParamArray()[0]);
+    InteropCharArray &text = getInteropCharArray();
+    size_t length = fn.toChars(text.data.data(), text.data.size(), digits);
+    text.touchWritten(length);
+    return static_cast<uint32_t>(length);
+  }
+
+  // Parses `length` chars of the interop char array into return[0]
+  static bool parseDecimal(uint32_t length) {
+    InteropCharArray &text = getInteropCharArray();
+    text.touch(length);
+    Fixed64 result;
+    if (length > text.data.size() ||
+        !Fixed64::fromChars(text.data.data(), length, result)) {
+      return false;
+    }
+    getInteropReturnArray()[0] = static_cast<Fixed64Param>(result);
+    return true;
+  }
+
+  // Bulk variants on wasm memory, see FixedDecimal::formatMany/parseMany
+  static uint32_t formatDecimalMany(uintptr_t values, uint32_t count,
+                                    uintptr_t out, uint32_t capacity,
+                                    int digits, uint32_t separator) {
+    return static_cast<uint32_t>(FixedDecimal::formatMany(
+        reinterpret_cast<const int64_t *>(values), count,
+        reinterpret_cast<char *>(out), capacity, digits,
+        static_cast<char>(separator)));
+  }
+
+  static int32_t parseDecimalMany(uintptr_t text, uint32_t length,
+                                  uint32_t separator, uintptr_t out,
+                                  uint32_t capacity) {
+    return static_cast<int32_t>(FixedDecimal::parseMany(
+        reinterpret_cast<const char *>(text), length,
+        static_cast<char>(separator), reinterpret_cast<int64_t *>(out),
+        capacity));
   }
 
   static void abs() {
@@ -70,6 +141,57 @@ class Fixed64Native {
     getInteropReturnArray()[0] = static_cast<Fixed64Param>(result);
   }
 
+  static void atan2Deg() {
+    Fixed64 fy(getInteropParamArray()[0]);
+    Fixed64 fx(getInteropParamArray()[1]);
+    auto result = FixedMath::Atan2Deg(fy, fx);
+    getInteropReturnArray()[0] = static_cast<Fixed64Param>(result);
+  }
+
+  static uint32_t atan2Heading(int bits) {
+    Fixed64 fy(getInteropParamArray()[0]);
+    Fixed64 fx(getInteropParamArray()[1]);
+    return FixedMath::Atan2Heading(fy, fx, bits);
+  }
+
+  // Batch variants over columns of raw int64 values in wasm memory, split
+  // across the JobPool in threaded builds.
+  static void atan2Many(uintptr_t ys, uintptr_t xs, uintptr_t out,
+                        uint32_t count) {
+    const int64_t *y = reinterpret_cast<const int64_t *>(ys);
+    const int64_t *x = reinterpret_cast<const int64_t *>(xs);
+    int64_t *result = reinterpret_cast<int64_t *>(out);
+    JobPool::parallelFor(
+        count, JobPool::kBatchGrain, [&](uint32_t begin, uint32_t end) {
+          FixedMath::Atan2Many(y + begin, x + begin, result + begin,
+                               end - begin);
+        });
+  }
+
+  static void atan2DegMany(uintptr_t ys, uintptr_t xs, uintptr_t out,
+                           uint32_t count) {
+    const int64_t *y = reinterpret_cast<const int64_t *>(ys);
+    const int64_t *x = reinterpret_cast<const int64_t *>(xs);
+    int64_t *result = reinterpret_cast<int64_t *>(out);
+    JobPool::parallelFor(
+        count, JobPool::kBatchGrain, [&](uint32_t begin, uint32_t end) {
+          FixedMath::Atan2DegMany(y + begin, x + begin, result + begin,
+                                  end - begin);
+        });
+  }
+
+  static void atan2HeadingMany(uintptr_t ys, uintptr_t xs, uintptr_t out,
+                               uint32_t count, int bits) {
+    const int64_t *y = reinterpret_cast<const int64_t *>(ys);
+    const int64_t *x = reinterpret_cast<const int64_t *>(xs);
+    uint32_t *result = reinterpret_cast<uint32_t *>(out);
+    JobPool::parallelFor(
+        count, JobPool::kBatchGrain, [&](uint32_t begin, uint32_t end) {
+          FixedMath::Atan2HeadingMany(y + begin, x + begin, result + begin,
+                                      end - begin, bits);
+        });
+  }
+
   static void ceil() {
     Fixed64 fn(getInteropParamArray()[0]);
     auto result = FixedMath::Ceil(fn);
@@ -128,6 +250,59 @@ class Fixed64Native {
     getInteropReturnArray()[0] = static_cast<Fixed64Param>(result);
   }
 
+  static void log2() {
+    Fixed64 fn(getInteropParamArray()[0]);
+    auto result = FixedMath::Log2(fn);
+    getInteropReturnArray()[0] = static_cast<Fixed64Param>(result);
+  }
+
+  static void ln() {
+    Fixed64 fn(getInteropParamArray()[0]);
+    auto result = FixedMath::Ln(fn);
+    getInteropReturnArray()[0] = static_cast<Fixed64Param>(result);
+  }
+
+  static void pow() {
+    Fixed64 fbase(getInteropParamArray()[0]);
+    Fixed64 fexponent(getInteropParamArray()[1]);
+    auto result = FixedMath::Pow(fbase, fexponent);
+    getInteropReturnArray()[0] = static_cast<Fixed64Param>(result);
+  }
+
+  static void powInt(int exponent) {
+    Fixed64 fbase(getInteropParamArray()[0]);
+    auto result = FixedMath::PowInt(fbase, exponent);
+    getInteropReturnArray()[0] = static_cast<Fixed64Param>(result);
+  }
+
+  static int clz() {
+    Fixed64 fn(getInteropParamArray()[0]);
+    return FixedMath::CountLeadingZeroes(static_cast<uint64_t>(fn.value));
+  }
+
+  static int ctz() {
+    Fixed64 fn(getInteropParamArray()[0]);
+    return FixedMath::CountTrailingZeroes(static_cast<uint64_t>(fn.value));
+  }
+
+  static int popcount() {
+    Fixed64 fn(getInteropParamArray()[0]);
+    return FixedMath::PopCount(static_cast<uint64_t>(fn.value));
+  }
+
+  static int log2Int() {
+    Fixed64 fn(getInteropParamArray()[0]);
+    return FixedMath::Log2Int(fn);
+  }
+
+  static int frexp() {
+    Fixed64 fn(getInteropParamArray()[0]);
+    int exponent;
+    auto mantissa = FixedMath::Frexp(fn, exponent);
+    getInteropReturnArray()[0] = static_cast<Fixed64Param>(mantissa);
+    return exponent;
+  }
+
   static void round() {
     Fixed64 fn(getInteropParamArray()[0]);
     auto result = FixedMath::Round(fn);
@@ -242,7 +417,7 @@ class Fixed64Native {
     return fx.CompareTo(fy);
   }
 
-  static void max(size_t length) {
+  static void max(uint32_t length) {
     Fixed64 maxVal = Fixed64Const::MinValue;
     for (unsigned i = 0; i < length; i++) {
       Fixed64 fixedV(getInteropParamArray()[i]);
@@ -252,7 +427,7 @@ class Fixed64Native {
     getInteropReturnArray()[0] = static_cast<Fixed64Param>(maxVal);
   }
 
-  static void min(size_t length) {
+  static void min(uint32_t length) {
     Fixed64 minVal = Fixed64Const::MaxValue;
     for (unsigned i = 0; i < length; i++) {
       Fixed64 fixedV(getInteropParamArray()[i]);
@@ -262,7 +437,7 @@ class Fixed64Native {
     getInteropReturnArray()[0] = static_cast<Fixed64Param>(minVal);
   }
 
-  static void sum(size_t length) {
+  static void sum(uint32_t length) {
     Fixed64 total = Fixed64Const::Zero;
     for (unsigned i = 0; i < length; i++) {
       Fixed64 fixedV(getInteropParamArray()[i]);
@@ -272,7 +447,11 @@ class Fixed64Native {
     getInteropReturnArray()[0] = static_cast<Fixed64Param>(total);
   }
 
-  static std::string testPerformance(const uint32_t testTimes);
   static void emptyCall() {}
 };
+
+#if FIXED64_LEAN
+template <>
+inline constexpr bool kPlaceholderEntryPoint<&Fixed64Native::toString> = true;
+#endif
 }  // namespace Skynet
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+// Exact conversion from double to raw Q47.16 values.
+//
+// Scaling by 2^16 only changes the exponent, so value * 2^16 is exact, and so
+// are its truncation and the comparisons that turn it into floor or nearest.
+// No step rounds, which makes the result independent of the rounding mode,
+// excess precision and contraction flags: a multiply, a truncating conversion
+// and a range check, where the legacy parseFloat needed std::floor, a
+// subtraction, a multiply and two conversions.
+//
+// That legacy code computed floor(v) + (v - floor(v)) * 2^16 and matches
+// Floor except in (-1, 0), where 1 + v is rounded to the significand first
+// (53 bits, 24 for floats), so e.g. -1e-20 became 0 rather than -1.
+// LegacyFloor reproduces that bit for bit and is what Fixed64(double) uses
+// under FIXED64_MATH_VERSION 1; version 2 switches to the exact Floor.
+//
+// Values outside the Fixed64 range saturate to INT64_MIN/INT64_MAX; NaN
+// converts to 0, like the JS wrapper does.
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#ifndef FIXED64_MATH_VERSION
+#define FIXED64_MATH_VERSION 1
+#endif
+
+namespace Skynet {
+
+enum class FixedRounding : uint8_t {
+  // Towards negative infinity
+  Floor = 0,
+  // Towards zero
+  Truncate = 1,
+  // To the nearest raw value, halfway cases away from zero
+  Nearest = 2,
+  // Floor with the legacy rounding in (-1, 0), see above
+  LegacyFloor = 3,
+  // FixedConvert::kDefaultRounding of the build, as are unknown values
+  Default = 255,
+};
+
+class FixedConvert {
+ public:
+  // Rounding of Fixed64(double) and of number params passed from JS
+#if FIXED64_MATH_VERSION >= 2
+  static constexpr FixedRounding kDefaultRounding = FixedRounding::Floor;
+#else
+  static constexpr FixedRounding kDefaultRounding = FixedRounding::LegacyFloor;
+#endif
+
+  // T is double or float; only LegacyFloor depends on the type
+  template <FixedRounding Mode, typename T = double>
+  static int64_t fromDouble(T value) {
+    if constexpr (Mode == FixedRounding::LegacyFloor) {
+      if (isNegativeFraction(value)) {
+        return static_cast<int64_t>((value + T(1)) * T(kOne)) - kOne;
+      }
+    }
+    double scaled = static_cast<double>(value) * kOne;
+    if (!(scaled >= kMin && scaled < kMax)) {
+      return scaled != scaled ? 0
+             : scaled < 0     ? std::numeric_limits<int64_t>::min()
+                              : std::numeric_limits<int64_t>::max();
+    }
+    // Every mode starts from the truncation, a single conversion instruction
+    // on x86-64, ARM64 and wasm, where floor may be a libm call
+    int64_t truncated = static_cast<int64_t>(scaled);
+    if constexpr (Mode == FixedRounding::Truncate) {
+      return truncated;
+    } else if constexpr (Mode == FixedRounding::Nearest) {
+      double fraction = scaled - static_cast<double>(truncated);
+      return truncated + (fraction >= 0.5) - (fraction <= -0.5);
+    } else {
+      return truncated - (static_cast<double>(truncated) > scaled);
+    }
+  }
+
+  static int64_t fromDouble(double value,
+                            FixedRounding mode = kDefaultRounding) {
+    return fromValue(value, mode);
+  }
+
+  static int64_t fromFloat(float value, FixedRounding mode = kDefaultRounding) {
+    return fromValue(value, mode);
+  }
+
+  // Converts a column of doubles, e.g. level data or configuration tables
+  static void fromDoubles(const double *values, size_t count, int64_t *out,
+                          FixedRounding mode = kDefaultRounding) {
+    switch (mode) {
+      case FixedRounding::Floor:
+        fromDoubles<FixedRounding::Floor>(values, count, out);
+        break;
+      case FixedRounding::Truncate:
+        fromDoubles<FixedRounding::Truncate>(values, count, out);
+        break;
+      case FixedRounding::Nearest:
+        fromDoubles<FixedRounding::Nearest>(values, count, out);
+        break;
+      case FixedRounding::LegacyFloor:
+        fromDoubles<FixedRounding::LegacyFloor>(values, count, out);
+        break;
+      default:
+        fromDoubles<kDefaultRounding>(values, count, out);
+        break;
+    }
+  }
+
+ private:
+  static constexpr int64_t kOne = 1LL << 16;
+  static constexpr double kMin = -9223372036854775808.0;
+  static constexpr double kMax = 9223372036854775808.0;
+
+  // value in (-1, 0), as one comparison on the bits that is rarely true,
+  // unlike the sign tests of value > -1 && value < 0 on mixed-sign data
+  static bool isNegativeFraction(double value) {
+    uint64_t bits = std::bit_cast<uint64_t>(value);
+    // Smallest negative value up to, but excluding, -1.0
+    return bits - 0x8000000000000001ULL <
+           0xBFF0000000000000ULL - 0x8000000000000001ULL;
+  }
+
+  static bool isNegativeFraction(float value) {
+    uint32_t bits = std::bit_cast<uint32_t>(value);
+    return bits - 0x80000001U < 0xBF800000U - 0x80000001U;
+  }
+
+  template <typename T>
+  static int64_t fromValue(T value, FixedRounding mode) {
+    switch (mode) {
+      case FixedRounding::Floor:
+        return fromDouble<FixedRounding::Floor>(value);
+      case FixedRounding::Truncate:
+        return fromDouble<FixedRounding::Truncate>(value);
+      case FixedRounding::Nearest:
+        return fromDouble<FixedRounding::Nearest>(value);
+      case FixedRounding::LegacyFloor:
+        return fromDouble<FixedRounding::LegacyFloor>(value);
+      default:
+        return fromDouble<kDefaultRounding>(value);
+    }
+  }
+
+  template <FixedRounding Mode>
+  static void fromDoubles(const double *values, size_t count, int64_t *out) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = fromDouble<Mode>(values[i]);
+    }
+  }
+};
+
+}  // namespace Skynet
@@ -0,0 +1,277 @@
+#pragma once
+
+// Exact conversion between raw Q47.16 values and decimal text.
+//
+// The fraction of a raw value is frac / 2^16 = frac * 5^16 / 10^16, so it
+// has an exact decimal expansion of 16 digits. format() rounds that
+// expansion to the requested number of digits (half away from zero) and
+// parse() rounds decimal text to the nearest raw value the same way. With 5
+// or more digits, format() followed by parse() reproduces the raw value,
+// since 10^-5 is finer than the 2^-16 spacing of raw values.
+//
+// Neither function allocates; text is written to and read from caller
+// buffers.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Skynet {
+
+class FixedDecimal {
+ public:
+  static constexpr int kDefaultDigits = 5;
+  static constexpr int kMaxDigits = 16;
+  // "-140737488355328.0000152587890625" plus the terminating NUL
+  static constexpr size_t kMaxLength = 34;
+
+  // Writes the value with at most `digits` fractional digits, dropping
+  // trailing zeros (and the point for integers), followed by a NUL. Returns
+  // the length without the NUL, or 0 if `capacity` is too small.
+  static size_t format(int64_t raw, char *buffer, size_t capacity,
+                       int digits = kDefaultDigits) {
+    digits = digits < 0 ? 0 : digits > kMaxDigits ? kMaxDigits : digits;
+    bool negative = raw < 0;
+    uint64_t magnitude =
+        negative ? 0 - static_cast<uint64_t>(raw) : static_cast<uint64_t>(raw);
+    uint64_t integer = magnitude >> 16;
+    // Exact 16-digit fraction, rounded to `digits`
+    uint64_t fraction = (magnitude & 0xFFFF) * kFivePow16;
+    uint64_t divisor = kPow10[kMaxDigits - digits];
+    uint64_t rounded = fraction / divisor;
+    if ((fraction % divisor) * 2 >= divisor) {
+      ++rounded;
+    }
+    if (rounded == kPow10[digits]) {
+      rounded = 0;
+      ++integer;
+    }
+    // Drop trailing zeros
+    while (digits > 0 && rounded % 10 == 0) {
+      rounded /= 10;
+      --digits;
+    }
+
+    char text[kMaxLength];
+    size_t length = 0;
+    if (negative && (integer != 0 || digits > 0)) {
+      text[length++] = '-';
+    }
+    char integerDigits[20];
+    int integerLength = 0;
+    do {
+      integerDigits[integerLength++] = static_cast<char>('0' + integer % 10);
+      integer /= 10;
+    } while (integer != 0);
+    while (integerLength > 0) {
+      text[length++] = integerDigits[--integerLength];
+    }
+    if (digits > 0) {
+      text[length++] = '.';
+      for (int i = digits - 1; i >= 0; --i) {
+        text[length + i] = static_cast<char>('0' + rounded % 10);
+        rounded /= 10;
+      }
+      length += digits;
+    }
+
+    if (length + 1 > capacity) {
+      return 0;
+    }
+    for (size_t i = 0; i < length; ++i) {
+      buffer[i] = text[i];
+    }
+    buffer[length] = '\0';
+    return length;
+  }
+
+  // Parses [+-]digits[.digits][(e|E)[+-]digits] with at least one digit,
+  // rounding to the nearest raw value. Leading whitespace is skipped, as
+  // std::stod did for Fixed64::fromString. Returns false for malformed text
+  // or values outside the Fixed64 range; `raw` is then left unchanged.
+  static bool parse(const char *text, size_t length, int64_t &raw) {
+    size_t position = 0;
+    while (position < length &&
+           (text[position] == ' ' ||
+            (text[position] >= '\t' && text[position] <= '\r'))) {
+      ++position;
+    }
+    bool negative = false;
+    if (position < length && (text[position] == '+' || text[position] == '-')) {
+      negative = text[position] == '-';
+      ++position;
+    }
+
+    // Significant digits without leading zeros; `point` is the number of
+    // them before the decimal point (negative for 0.000ddd).
+    char digits[kMaxSignificant];
+    int count = 0;
+    int point = 0;
+    bool anyDigit = false;
+    bool seenPoint = false;
+    for (; position < length; ++position) {
+      char c = text[position];
+      if (c == '.' && !seenPoint) {
+        seenPoint = true;
+      } else if (c >= '0' && c <= '9') {
+        anyDigit = true;
+        if (c == '0' && count == 0) {
+          if (seenPoint) {
+            --point;
+          }
+        } else if (count < kMaxSignificant) {
+          digits[count++] = c - '0';
+          if (!seenPoint) {
+            ++point;
+          }
+        } else if (!seenPoint) {
+          ++point;
+        }
+      } else {
+        break;
+      }
+    }
+    if (!anyDigit) {
+      return false;
+    }
+
+    if (position < length && (text[position] == 'e' || text[position] == 'E')) {
+      ++position;
+      bool negativeExponent = false;
+      if (position < length &&
+          (text[position] == '+' || text[position] == '-')) {
+        negativeExponent = text[position] == '-';
+        ++position;
+      }
+      if (position == length) {
+        return false;
+      }
+      int exponent = 0;
+      for (; position < length; ++position) {
+        if (text[position] < '0' || text[position] > '9') {
+          return false;
+        }
+        if (exponent < 100000) {
+          exponent = exponent * 10 + (text[position] - '0');
+        }
+      }
+      point += negativeExponent ? -exponent : exponent;
+    }
+    if (position != length) {
+      return false;
+    }
+
+    auto digitAt = [&](int64_t index) -> uint64_t {
+      return index >= 0 && index < count ? digits[index] : 0;
+    };
+
+    // Integer part, at most 2^47 (only reached by the minimum value)
+    if (point > 15) {
+      return false;
+    }
+    uint64_t integer = 0;
+    for (int i = 0; i < point; ++i) {
+      integer = integer * 10 + digitAt(i);
+    }
+
+    // raw fraction = F17 * 2^16 / 10^17 = F17 / (2 * 5^17) for the first 17
+    // fractional digits F17. Later digits add less than 1 to F17 and cannot
+    // reach the next rounding boundary, which is a whole even number.
+    uint64_t fraction17 = 0;
+    for (int i = 0; i < 17; ++i) {
+      fraction17 = fraction17 * 10 + digitAt(static_cast<int64_t>(point) + i);
+    }
+    constexpr uint64_t kDivisor = 2 * kFivePow16 * 5;
+    uint64_t fraction = fraction17 / kDivisor;
+    if ((fraction17 % kDivisor) * 2 >= kDivisor) {
+      ++fraction;
+    }
+
+    uint64_t magnitude = (integer << 16) + fraction;
+    uint64_t limit = negative ? (1ULL << 63) : (1ULL << 63) - 1;
+    if (integer > (1ULL << 47) || magnitude > limit) {
+      return false;
+    }
+    raw = negative ? static_cast<int64_t>(0 - magnitude)
+                   : static_cast<int64_t>(magnitude);
+    return true;
+  }
+
+  // Formats `count` values separated by `separator` and terminated by a NUL.
+  // Returns the length without the NUL, or 0 if `capacity` is too small.
+  static size_t formatMany(const int64_t *values, size_t count, char *buffer,
+                           size_t capacity, int digits = kDefaultDigits,
+                           char separator = '\n') {
+    size_t length = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (i > 0) {
+        if (length + 1 >= capacity) {
+          return 0;
+        }
+        buffer[length++] = separator;
+      }
+      size_t written =
+          format(values[i], buffer + length, capacity - length, digits);
+      if (written == 0) {
+        return 0;
+      }
+      length += written;
+    }
+    if (count == 0) {
+      if (capacity == 0) {
+        return 0;
+      }
+      buffer[0] = '\0';
+    }
+    return length;
+  }
+
+  // Parses `separator`-separated values into `out`. Returns the number of
+  // values, or -(1 + index) of the first entry that is malformed, out of
+  // range or does not fit into `capacity`.
+  static int64_t parseMany(const char *text, size_t length, char separator,
+                           int64_t *out, size_t capacity) {
+    if (length == 0) {
+      return 0;
+    }
+    size_t count = 0;
+    size_t start = 0;
+    for (;;) {
+      size_t end = start;
+      while (end < length && text[end] != separator) {
+        ++end;
+      }
+      if (count == capacity || !parse(text + start, end - start, out[count])) {
+        return -1 - static_cast<int64_t>(count);
+      }
+      ++count;
+      if (end == length) {
+        return static_cast<int64_t>(count);
+      }
+      start = end + 1;
+    }
+  }
+
+ private:
+  static constexpr int kMaxSignificant = 40;
+  static constexpr uint64_t kFivePow16 = 152587890625ULL;
+  static constexpr uint64_t kPow10[kMaxDigits + 1] = {
+      1ULL,
+      10ULL,
+      100ULL,
+      1000ULL,
+      10000ULL,
+      100000ULL,
+      1000000ULL,
+      10000000ULL,
+      100000000ULL,
+      1000000000ULL,
+      10000000000ULL,
+      100000000000ULL,
+      1000000000000ULL,
+      10000000000000ULL,
+      100000000000000ULL,
+      1000000000000000ULL,
+      10000000000000000ULL};
+};
+
+}  // namespace Skynet
@@ -1,9 +1,23 @@
 #pragma once
 
 #include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 
 #include "Fixed64.h"
 
+// Selects which generation of the deterministic kernels is compiled in. Every
+// peer of a lockstep session must be built with the same value.
+//   1: legacy kernels
+//   2: LUT-seeded Sqrt with full 16-bit fractional precision, division-free
+//      Normalize, table-driven Exp, division-free Atan2, exact floor for
+//      double to Fixed64 conversion (see FixedConvert.h)
+#ifndef FIXED64_MATH_VERSION
+#define FIXED64_MATH_VERSION 1
+#endif
+
 namespace Skynet {
 class FixedMath {
  private:
@@ -15,15 +29,17 @@ class FixedMath {
   static inline const Fixed64 _atan2Number6{static_cast<int64_t>(65536LL)};
   static inline const Fixed64 _atan2Number7{static_cast<int64_t>(102943LL)};
   static inline const Fixed64 _atan2Number8{static_cast<int64_t>(205887LL)};
+  // 2^32 / (2 * pi)
+  static constexpr uint64_t _invPi2Q32 = 683565276ULL;
   static inline const Fixed64 _atanApproximatedNumber1{
       static_cast<int64_t>(16036LL)};
   static inline const Fixed64 _atanApproximatedNumber2{
       static_cast<int64_t>(4345LL)};
   static inline const Fixed64 _pow2Number1{static_cast<int64_t>(177LL)};
   static inline const Fixed64 _expNumber1{static_cast<int64_t>(94548LL)};
-  static inline const std::array<uint8_t, 32> _bsrLookup{
-      0, 9,  1,  10, 13, 21, 2,  29, 11, 14, 16, 18, 22, 25, 3, 30,
-      8, 12, 20, 28, 15, 17, 24, 7,  19, 27, 23, 6,  26, 5,  4, 31};
+  // ln(2) and log2(e) in Q30
+  static constexpr int64_t _ln2Q30 = 744261118LL;
+  static constexpr int64_t _log2EQ30 = 1549082005LL;
 
  public:
   static inline const Fixed64 PI = Fixed64Const::Pi;
@@ -31,17 +47,72 @@ class FixedMath {
   static inline const Fixed64 Rad2Deg = Fixed64Const::RadToDeg;
   static inline const Fixed64 Deg2Rad = Fixed64Const::DegToRad;
 
+  // Bit intrinsics, lowered to i32/i64 clz, ctz and popcnt on wasm.
+  // BitScanReverse returns the index of the highest set bit (0 for 0).
   static int BitScanReverse(uint32_t num) {
-    num |= num >> 1;
-    num |= num >> 2;
-    num |= num >> 4;
-    num |= num >> 8;
-    num |= num >> 16;
-    return _bsrLookup[(num * 0x07C4ACDDU) >> 27];
+    return num == 0 ? 0 : 31 - std::countl_zero(num);
+  }
+
+  static int BitScanReverse(uint64_t num) {
+    return num == 0 ? 0 : 63 - std::countl_zero(num);
+  }
+
+  static int CountLeadingZeroes(uint32_t num) { return std::countl_zero(num); }
+
+  static int CountLeadingZeroes(uint64_t num) { return std::countl_zero(num); }
+
+  static int CountTrailingZeroes(uint32_t num) { return std::countr_zero(num); }
+
+  static int CountTrailingZeroes(uint64_t num) { return std::countr_zero(num); }
+
+  static int PopCount(uint32_t num) { return std::popcount(num); }
+
+  static int PopCount(uint64_t num) { return std::popcount(num); }
+
+  // floor(log2(num)) for positive input, INT32_MIN otherwise.
+  static int Log2Int(Fixed64 num) {
+    if (num.value <= 0) {
+      return INT32_MIN;
+    }
+    return BitScanReverse(static_cast<uint64_t>(num.value)) - FixLut::PRECISION;
+  }
+
+  // Splits num into mantissa * 2^exponent with |mantissa| in [1, 2). Raw bits
+  // below the 16 kept fractional bits of the mantissa are truncated. Zero
+  // yields a zero mantissa and exponent.
+  static Fixed64 Frexp(Fixed64 num, int &exponent) {
+    if (num.value == 0) {
+      exponent = 0;
+      return Fixed64Const::Zero;
+    }
+
+    uint64_t magnitude = num.value < 0 ? 0 - static_cast<uint64_t>(num.value)
+                                       : static_cast<uint64_t>(num.value);
+    int highestBit = BitScanReverse(magnitude);
+    exponent = highestBit - FixLut::PRECISION;
+    int64_t mantissa =
+        static_cast<int64_t>(exponent >= 0 ? magnitude >> exponent
+                                           : magnitude << -exponent);
+    return Fixed64(num.value < 0 ? -mantissa : mantissa);
   }
 
-  static int CountLeadingZeroes(uint32_t num) {
-    return num == 0 ? 32 : BitScanReverse(num) ^ 31;
+  // num^exponent by binary exponentiation: at most 2 * log2(|exponent|)
+  // multiplies, plus one division for negative exponents.
+  static Fixed64 PowInt(Fixed64 num, int exponent) {
+    uint32_t remaining = exponent < 0 ? 0U - static_cast<uint32_t>(exponent)
+                                      : static_cast<uint32_t>(exponent);
+    Fixed64 result = Fixed64Const::One;
+    while (remaining != 0) {
+      if (remaining & 1U) {
+        result *= num;
+      }
+      remaining >>= 1;
+      if (remaining != 0) {
+        num *= num;
+      }
+    }
+
+    return exponent < 0 ? Fixed64Const::One / result : result;
   }
 
   // Calculates 2 raised to the power of the given number
@@ -112,6 +183,15 @@ class FixedMath {
   }
 
   static Fixed64 Atan2(Fixed64 y, Fixed64 x) {
+#if FIXED64_MATH_VERSION >= 2
+    return Atan2V2(y, x);
+#else
+    return Atan2V1(y, x);
+#endif
+  }
+
+  // Ratio of the smaller to the larger magnitude through a 64-bit division.
+  static Fixed64 Atan2V1(Fixed64 y, Fixed64 x) {
     auto absX = Abs(x);
     auto absY = Abs(y);
     auto t3 = absX;
@@ -134,15 +214,179 @@ class FixedMath {
     return t3;
   }
 
+  // Same polynomial as Atan2V1, with the ratio taken from a LUT-seeded
+  // reciprocal instead of a division; the ratio keeps all 16 fractional bits
+  // for large arguments.
+  static Fixed64 Atan2V2(Fixed64 y, Fixed64 x) {
+    uint64_t absX = Magnitude(x.value);
+    uint64_t absY = Magnitude(y.value);
+    if ((absX | absY) == 0) {
+      return Fixed64Const::Zero;
+    }
+    // Branch-free swap: the octant bits are random for headings.
+    uint64_t swap = (absX ^ absY) & (0 - static_cast<uint64_t>(absY > absX));
+    uint64_t larger = absX ^ swap;
+    uint64_t smaller = absY ^ swap;
+
+    // ratio = smaller / larger with both scaled into [0, 2^31) by the CLZ
+    // of the larger one.
+    int shift;
+    int64_t reciprocal = FixLut::rcp(larger, shift);
+    int64_t scaled = static_cast<int64_t>((smaller << shift) >> 33);
+    Fixed64 t3(static_cast<int64_t>((scaled * reciprocal + (1LL << 44)) >> 45));
+
+    auto t4 = t3 * t3;
+    auto t0 = _atan2Number1;
+    t0 = t0 * t4 + _atan2Number2;
+    t0 = t0 * t4 - _atan2Number3;
+    t0 = t0 * t4 + _atan2Number4;
+    t0 = t0 * t4 - _atan2Number5;
+    t0 = t0 * t4 + _atan2Number6;
+    t3 = t0 * t3;
+    t3 = absY > absX ? _atan2Number7 - t3 : t3;
+    t3 = x.value < 0 ? _atan2Number8 - t3 : t3;
+    t3 = y.value < 0 ? -t3 : t3;
+    return t3;
+  }
+
+  // Atan2 in degrees, in (-180, 180].
+  static Fixed64 Atan2Deg(Fixed64 y, Fixed64 x) {
+    return Atan2(y, x) * Fixed64Const::RadToDeg;
+  }
+
+  // Heading of (x, y) quantized to 2^bits steps per turn, counter-clockwise
+  // from +x, rounded to the nearest step; bits is clamped to [1, 16]. With
+  // bits = 3 this is the octant.
+  static uint32_t Atan2Heading(Fixed64 y, Fixed64 x, int bits) {
+    bits = bits < 1 ? 1 : bits > 16 ? 16 : bits;
+    int64_t angle = Atan2(y, x).value;
+    angle += Fixed64Const::Pi2.value & (angle >> 63);
+    int shift = 48 - bits;
+    uint64_t heading =
+        (static_cast<uint64_t>(angle) * _invPi2Q32 + (1ULL << (shift - 1))) >>
+        shift;
+    return static_cast<uint32_t>(heading & ((1ULL << bits) - 1));
+  }
+
+  // Column variants over raw values; out may alias ys or xs.
+  static void Atan2Many(const int64_t *ys, const int64_t *xs, int64_t *out,
+                        size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = Atan2(Fixed64(ys[i]), Fixed64(xs[i])).value;
+    }
+  }
+
+  static void Atan2DegMany(const int64_t *ys, const int64_t *xs, int64_t *out,
+                           size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = Atan2Deg(Fixed64(ys[i]), Fixed64(xs[i])).value;
+    }
+  }
+
+  static void Atan2HeadingMany(const int64_t *ys, const int64_t *xs,
+                               uint32_t *out, size_t count, int bits) {
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = Atan2Heading(Fixed64(ys[i]), Fixed64(xs[i]), bits);
+    }
+  }
+
   static Fixed64 Rcp(Fixed64 num) {
     return Fixed64::parseLong(4294967296LL / num.value);
   }
 
+  // 1 / sqrt(num) without a division. Zero yields PositiveInfinity and
+  // negative input NaN.
   static Fixed64 Rsqrt(Fixed64 num) {
-    return Fixed64::parseLong(4294967296LL / Sqrt(num).value);
+    if (num.value <= 0) {
+      return num.value == 0 ? Fixed64Const::PositiveInfinity
+                            : Fixed64Const::NaN;
+    }
+
+    // The raw result is 2^24 / sqrt(raw) = mantissa * 2^(halfShift - 38).
+    int halfShift;
+    uint64_t mantissa = FixLut::rsqrt(static_cast<uint64_t>(num.value), halfShift);
+    int shift = 38 - halfShift;
+    return Fixed64(static_cast<int64_t>(
+        (mantissa + (1ULL << (shift - 1))) >> shift));
+  }
+
+  // Scales the components of a vector to unit length in place; a zero vector
+  // is left unchanged.
+  template <int N>
+  static void Normalize(Fixed64 (&components)[N]) {
+#if FIXED64_MATH_VERSION >= 2
+    NormalizeV2(components);
+#else
+    NormalizeV1(components);
+#endif
+  }
+
+  // Sqrt of the squared length, then one division per component.
+  template <int N>
+  static void NormalizeV1(Fixed64 (&components)[N]) {
+    Fixed64 lengthSqr = Fixed64Const::Zero;
+    for (int i = 0; i < N; ++i) {
+      lengthSqr += components[i] * components[i];
+    }
+
+    Fixed64 length = Sqrt(lengthSqr);
+    if (length != Fixed64Const::Zero) {
+      for (int i = 0; i < N; ++i) {
+        components[i] = components[i] / length;
+      }
+    }
+  }
+
+  // One reciprocal square root and a multiply per component. The magnitudes
+  // are rescaled so the largest lies in [2^30, 2^31), which keeps the sum of
+  // squares in 64 bits and the precision independent of the vector length.
+  template <int N>
+  static void NormalizeV2(Fixed64 (&components)[N]) {
+    static_assert(N >= 1 && N <= 3, "sum of squares must fit in 64 bits");
+
+    uint64_t magnitudes[N];
+    uint64_t largest = 0;
+    for (int i = 0; i < N; ++i) {
+      int64_t value = components[i].value;
+      magnitudes[i] = value < 0 ? 0 - static_cast<uint64_t>(value)
+                                : static_cast<uint64_t>(value);
+      largest = magnitudes[i] > largest ? magnitudes[i] : largest;
+    }
+
+    if (largest == 0) {
+      return;
+    }
+
+    int shift = std::countl_zero(largest) - 33;
+    uint64_t lengthSqr = 0;
+    for (int i = 0; i < N; ++i) {
+      magnitudes[i] =
+          shift >= 0 ? magnitudes[i] << shift : magnitudes[i] >> -shift;
+      lengthSqr += magnitudes[i] * magnitudes[i];
+    }
+
+    int halfShift;
+    uint64_t inverse = FixLut::rsqrt(lengthSqr, halfShift);
+    int resultShift = 62 - FixLut::PRECISION - halfShift;
+    uint64_t half = 1ULL << (resultShift - 1);
+    for (int i = 0; i < N; ++i) {
+      int64_t scaled = static_cast<int64_t>(
+          (magnitudes[i] * inverse + half) >> resultShift);
+      components[i].value = components[i].value < 0 ? -scaled : scaled;
+    }
   }
 
   static Fixed64 Sqrt(Fixed64 num) {
+#if FIXED64_MATH_VERSION >= 2
+    return SqrtV2(num);
+#else
+    return SqrtV1(num);
+#endif
+  }
+
+  // Newton iteration on the raw value; the root is shifted back by 8 bits, so
+  // only the top 8 fractional bits are significant.
+  static Fixed64 SqrtV1(Fixed64 num) {
     Fixed64 r;
 
     if (num.value == 0) {
@@ -162,6 +406,34 @@ class FixedMath {
     return r;
   }
 
+  // floor(sqrt(num)) to the last raw bit in a bounded number of steps.
+  // Non-positive input yields zero.
+  static Fixed64 SqrtV2(Fixed64 num) {
+    if (num.value <= 0) {
+      return Fixed64Const::Zero;
+    }
+
+    uint64_t value = static_cast<uint64_t>(num.value);
+    if (value < (1ULL << (64 - FixLut::PRECISION))) {
+      return Fixed64(static_cast<int64_t>(FixLut::isqrt(value << FixLut::PRECISION)));
+    }
+
+    // value << 16 no longer fits: take the integer root and append the 8
+    // result bits contributed by the 16 fractional input bits digit by digit.
+    uint64_t root = FixLut::isqrt(value);
+    uint64_t remainder = value - root * root;
+    for (int i = 0; i < (FixLut::PRECISION >> 1); ++i) {
+      root <<= 1;
+      remainder <<= 2;
+      if (remainder >= (root << 1) + 1) {
+        remainder -= (root << 1) + 1;
+        root += 1;
+      }
+    }
+
+    return Fixed64(static_cast<int64_t>(root));
+  }
+
   static Fixed64 Floor(Fixed64 num) {
     num.value = num.value >> FixLut::PRECISION << FixLut::PRECISION;
     return num;
@@ -283,6 +555,15 @@ class FixedMath {
   static Fixed64 Pow2(int power) { return Fixed64(FixLut::ONE << power); }
 
   static Fixed64 Exp(Fixed64 num) {
+#if FIXED64_MATH_VERSION >= 2
+    return ExpV2(num);
+#else
+    return ExpV1(num);
+#endif
+  }
+
+  // Taylor series, up to 28 terms with a division each.
+  static Fixed64 ExpV1(Fixed64 num) {
     if (num == Fixed64Const::Zero) return Fixed64Const::One;
     if (num == Fixed64Const::One) return Fixed64Const::E;
     if (num.value >= 2097152) return Fixed64Const::Max;
@@ -305,5 +586,105 @@ class FixedMath {
 
     return result;
   }
+
+  // e^num as 2^(num * log2(e)): one multiply and a table interpolation.
+  // Saturates over the same range as ExpV1. LogExpBenchmark measures at most
+  // 0.55 raw units below one and a relative error of 0.55 * 2^-16 above.
+  static Fixed64 ExpV2(Fixed64 num) {
+    if (num.value >= 2097152) return Fixed64Const::Max;
+    if (num.value <= -786432) return Fixed64Const::Zero;
+
+    return Fixed64(FixLut::exp2((num.value * _log2EQ30) >> FixLut::PRECISION));
+  }
+
+  // log2(num) for positive input, NaN otherwise.
+  static Fixed64 Log2(Fixed64 num) {
+    if (num.value <= 0) {
+      return Fixed64Const::NaN;
+    }
+
+    int64_t log = Log2Q30(num);
+    return Fixed64(static_cast<int64_t>((log + (1LL << 13)) >>
+                                        (30 - FixLut::PRECISION)));
+  }
+
+  // Natural logarithm for positive input, NaN otherwise.
+  static Fixed64 Ln(Fixed64 num) {
+    if (num.value <= 0) {
+      return Fixed64Const::NaN;
+    }
+
+    // Q24 * Q30 keeps the product in 64 bits for the whole value range.
+    int64_t log = Log2Q30(num) >> 6;
+    return Fixed64(static_cast<int64_t>((log * _ln2Q30 + (1LL << 37)) >> 38));
+  }
+
+  // num^exponent. Integer exponents that cannot overflow use PowInt and are
+  // exact up to rounding of the multiplies; everything else goes through
+  // 2^(exponent * log2(num)) and saturates at Max. A negative base requires
+  // an integer exponent and yields NaN otherwise.
+  static Fixed64 Pow(Fixed64 num, Fixed64 exponent) {
+    if (exponent.value == 0) {
+      return Fixed64Const::One;
+    }
+    if (num.value == 0) {
+      return exponent.value > 0 ? Fixed64Const::Zero
+                                : Fixed64Const::PositiveInfinity;
+    }
+
+    bool negate = false;
+    if (num.value < 0) {
+      if (!exponent.isInteger()) {
+        return Fixed64Const::NaN;
+      }
+      negate = ((exponent.value >> FixLut::PRECISION) & 1) != 0;
+      num = -num;
+    }
+
+    if (exponent.isInteger() && exponent.value > 0) {
+      int64_t power = exponent.value >> FixLut::PRECISION;
+      int integerBits = Log2Int(num) + 1;
+      // Fixed64 products are exact only while they stay below UsableMax.
+      // Powers beyond int range go through exp2, which rounds |num| < 1 to
+      // zero instead of truncating the power.
+      if (power <= std::numeric_limits<int>::max() &&
+          (integerBits <= 0 || integerBits * power < 32)) {
+        Fixed64 result = PowInt(num, static_cast<int>(power));
+        return negate ? -result : result;
+      }
+    }
+
+    int64_t log = Log2Q30(num);
+    uint64_t exponentMagnitude = exponent.value < 0
+                                     ? 0 - static_cast<uint64_t>(exponent.value)
+                                     : static_cast<uint64_t>(exponent.value);
+    uint64_t logMagnitude = log < 0 ? 0 - static_cast<uint64_t>(log)
+                                    : static_cast<uint64_t>(log);
+    Fixed64 result;
+    if (logMagnitude == 0) {
+      result = Fixed64Const::One;
+    } else if (BitScanReverse(exponentMagnitude) + BitScanReverse(logMagnitude) >= 62) {
+      // |exponent * log2(num)| >= 2^16: far outside the representable range
+      result = (exponent.value < 0) == (log < 0) ? Fixed64Const::Max
+                                                 : Fixed64Const::Zero;
+    } else {
+      result = Fixed64(FixLut::exp2((exponent.value * log) >> FixLut::PRECISION));
+    }
+
+    return negate ? -result : result;
+  }
+
+ private:
+  // |value| as an unsigned integer without a branch on the sign.
+  static uint64_t Magnitude(int64_t value) {
+    uint64_t sign = static_cast<uint64_t>(value >> 63);
+    return (static_cast<uint64_t>(value) ^ sign) - sign;
+  }
+
+  // log2(num) in Q30 for positive num.
+  static int64_t Log2Q30(Fixed64 num) {
+    return FixLut::log2(static_cast<uint64_t>(num.value)) -
+           (static_cast<int64_t>(FixLut::PRECISION) << 30);
+  }
 };
 }  // namespace Skynet
\ No newline at end of file
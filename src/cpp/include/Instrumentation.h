@@ -0,0 +1,143 @@
+#pragma once
+
+// Per entry point call counters for the instrumented build.
+//
+// With FIXED64_INSTRUMENTATION=1 every function listed in EntryPoints.h is
+// bound through Instrumented<>::call, which counts the call and, while timing
+// is switched on, adds its duration (and TSC cycles on x86-64) to the entry's
+// totals. Without it FIXED64_INSTRUMENTED_FUNCTION yields the plain function
+// pointer and nothing here is referenced from the hot path.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include "EntryPoints.h"
+
+#ifndef FIXED64_INSTRUMENTATION
+#define FIXED64_INSTRUMENTATION 0
+#endif
+
+namespace Skynet {
+
+enum class EntryPoint : uint32_t {
+#define FIXED64_ENTRY_POINT_ID(owner, name, fn) owner##_##name,
+  FIXED64_ENTRY_POINTS(FIXED64_ENTRY_POINT_ID)
+#undef FIXED64_ENTRY_POINT_ID
+      Count
+};
+
+struct EntryPointStats {
+  uint64_t calls = 0;
+  uint64_t nanoseconds = 0;
+  // Only counted where a cycle counter is available (x86-64 native builds)
+  uint64_t cycles = 0;
+};
+
+class Instrumentation {
+ public:
+  static constexpr size_t kEntryPointCount =
+      static_cast<size_t>(EntryPoint::Count);
+
+  static constexpr bool enabled() { return FIXED64_INSTRUMENTATION != 0; }
+
+  // "Owner.name" as bound to JS, e.g. "Vector3.rotateY"
+  static constexpr const char *name(EntryPoint id) {
+    return _names[static_cast<size_t>(id)];
+  }
+
+  static EntryPointStats &stats(EntryPoint id) {
+    return _stats[static_cast<size_t>(id)];
+  }
+
+  static void reset() {
+    for (auto &stats : _stats) {
+      stats = EntryPointStats();
+    }
+  }
+
+  static bool timing() { return _timing; }
+
+  static void setTiming(bool enabled) { _timing = enabled; }
+
+  static uint64_t nowNs() {
+#ifdef __EMSCRIPTEN__
+    return static_cast<uint64_t>(emscripten_get_now() * 1e6);
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+  }
+
+  static uint64_t cycles() {
+#if !defined(__EMSCRIPTEN__) && defined(__x86_64__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+  }
+
+ private:
+  static constexpr const char *_names[kEntryPointCount] = {
+#define FIXED64_ENTRY_POINT_NAME(owner, name, fn) #owner "." #name,
+      FIXED64_ENTRY_POINTS(FIXED64_ENTRY_POINT_NAME)
+#undef FIXED64_ENTRY_POINT_NAME
+  };
+
+  static inline EntryPointStats _stats[kEntryPointCount];
+  static inline bool _timing = false;
+};
+
+// Adds the time between construction and destruction to an entry's totals
+class EntryPointTimer {
+ public:
+  explicit EntryPointTimer(EntryPointStats &stats)
+      : _stats(stats),
+        _startNs(Instrumentation::nowNs()),
+        _startCycles(Instrumentation::cycles()) {}
+
+  ~EntryPointTimer() {
+    _stats.cycles += Instrumentation::cycles() - _startCycles;
+    _stats.nanoseconds += Instrumentation::nowNs() - _startNs;
+  }
+
+ private:
+  EntryPointStats &_stats;
+  uint64_t _startNs;
+  uint64_t _startCycles;
+};
+
+template <EntryPoint Id, auto Function>
+struct Instrumented;
+
+template <EntryPoint Id, typename R, typename... Args, R (*Function)(Args...)>
+struct Instrumented<Id, Function> {
+  static R call(Args... args) {
+    EntryPointStats &stats = Instrumentation::stats(Id);
+    ++stats.calls;
+    if (!Instrumentation::timing()) {
+      return Function(std::forward<Args>(args)...);
+    }
+    EntryPointTimer timer(stats);
+    return Function(std::forward<Args>(args)...);
+  }
+};
+
+}  // namespace Skynet
+
+// Function pointer for an entry of EntryPoints.h, counted when instrumented;
+// bindings use FIXED64_ENTRY_FUNCTION from Recorder.h, which wraps this one
+#if FIXED64_INSTRUMENTATION
+#define FIXED64_INSTRUMENTED_FUNCTION(owner, name, fn) \
+  (&::Skynet::Instrumented<::Skynet::EntryPoint::owner##_##name, fn>::call)
+#else
+#define FIXED64_INSTRUMENTED_FUNCTION(owner, name, fn) (fn)
+#endif
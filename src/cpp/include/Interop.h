@@ -2,11 +2,18 @@
 
 #include <array>
 #include <cstddef>  // for size_t
-#include <iostream>
+#include <cstdint>
 
 #include "ArraySize.h"
 #include "Fixed64.h"
 
+// With FIXED64_RECORDING=1 the arrays remember how many leading slots native
+// code touched since the last resetTouched(), so the recorder (Recorder.h)
+// only has to log the slots a call actually used.
+#ifndef FIXED64_RECORDING
+#define FIXED64_RECORDING 0
+#endif
+
 namespace Skynet {
 
 template <typename T, size_t kMaxSize>
@@ -17,23 +24,63 @@ class InteropArray {
 
   T &operator[](size_t index) {
     // If index is out of range, return the last element
-    return data[index > kMaxSize ? kMaxSize : index];
+    index = index > kMaxSize ? kMaxSize : index;
+    touch(index + 1);
+    return data[index];
   }
 
   const T &operator[](size_t index) const {
     // If index is out of range, return the last element
-    return data[index > kMaxSize ? kMaxSize : index];
+    index = index > kMaxSize ? kMaxSize : index;
+    touch(index + 1);
+    return data[index];
+  }
+
+  // Marks the first `count` slots as used, for code working on data directly
+  void touch(size_t count) const {
+#if FIXED64_RECORDING
+    count = count > kMaxSize + 1 ? kMaxSize + 1 : count;
+    _touched = count > _touched ? count : _touched;
+#else
+    (void)count;
+#endif
+  }
+
+  // Marks the first `count` slots as written by native code, e.g. text it
+  // formats, so the recorder logs them as outputs
+  void touchWritten(size_t count) {
+#if FIXED64_RECORDING
+    count = count > kMaxSize + 1 ? kMaxSize + 1 : count;
+    _written = count > _written ? count : _written;
+#else
+    (void)count;
+#endif
+  }
+
+  size_t touched() const { return _touched; }
+
+  size_t written() const { return _written; }
+
+  void resetTouched() {
+    _touched = 0;
+    _written = 0;
   }
 
   // Get the raw array
   T *getRawArray() { return data.data(); }
 
   const T *getRawArray() const { return data.data(); }
+
+ private:
+  mutable size_t _touched = 0;
+  size_t _written = 0;
 };
 
 // Specific type aliases
 using InteropParamArray = InteropArray<Skynet::Fixed64Param, 255>;
 using InteropUint32ParamArray = InteropArray<uint32_t, 255>;
+// Text exchanged with JS, e.g. decimal strings
+using InteropCharArray = InteropArray<char, 4095>;
 
 class InteropReturnArray {
  public:
@@ -43,53 +90,97 @@ class InteropReturnArray {
   std::array<uint32_t, kMaxSize + 1> uarray;
 
   Skynet::Fixed64Param &operator[](size_t index) {
-    if (index > kMaxFixed64ParamSize) return array[kMaxFixed64ParamSize];
+    if (index > kMaxFixed64ParamSize) index = kMaxFixed64ParamSize;
+#if FIXED64_RECORDING
+    _touched = index + 1 > _touched ? index + 1 : _touched;
+#endif
     return array[index];
   }
 
-  void clear() { uarray[0] = 0; }
+  void clear() {
+    uarray[0] = 0;
+#if FIXED64_RECORDING
+    _uint32Touched = true;
+#endif
+  }
 
   void push_back(uint32_t value) {
     if (uarray[0] < kMaxSize) {
       uarray[uarray[0] + 1] = value;
       ++uarray[0];
     }
+#if FIXED64_RECORDING
+    _uint32Touched = true;
+#endif
   }
 
   uint32_t uint32ArrayLen() const { return uarray[0]; }
 
   bool full() const { return uarray[0] == kMaxSize; }
+
+  // Slots of `array` written since resetTouched(), and whether uarray was
+  // cleared or appended to; only tracked with FIXED64_RECORDING
+  size_t touched() const { return _touched; }
+
+  bool uint32Touched() const { return _uint32Touched; }
+
+  void resetTouched() {
+    _touched = 0;
+    _uint32Touched = false;
+  }
+
+ private:
+  size_t _touched = 0;
+  bool _uint32Touched = false;
+};
+
+// All interop arrays of one SimContext (SimContext.h)
+struct InteropArrays {
+  InteropParamArray param;
+  InteropReturnArray ret;
+  InteropUint32ParamArray uint32Param;
+  InteropCharArray chars;
 };
 
-extern InteropParamArray interopParamArray;
-extern InteropReturnArray interopReturnArray;
-extern InteropUint32ParamArray interopUint32ParamArray;
+// The arrays of the SimContext bound to the calling thread
+extern constinit thread_local InteropArrays *boundInteropArrays;
 
-inline InteropParamArray &getInteropParamArray() { return interopParamArray; }
+inline InteropParamArray &getInteropParamArray() {
+  return boundInteropArrays->param;
+}
 inline InteropUint32ParamArray &getInteropUint32ParamArray() {
-  return interopUint32ParamArray;
+  return boundInteropArrays->uint32Param;
+}
+
+inline InteropCharArray &getInteropCharArray() {
+  return boundInteropArrays->chars;
 }
 
 inline InteropReturnArray &getInteropReturnArray() {
-  return interopReturnArray;
+  return boundInteropArrays->ret;
 }
 
 // Get the internal array address of InteropParamArray
 inline uintptr_t getInteropParamArrayAddress() {
-  return reinterpret_cast<uintptr_t>(interopParamArray.data.data());
+  return reinterpret_cast<uintptr_t>(boundInteropArrays->param.data.data());
 }
 
 // Get the internal array address of InteropReturnArray
 inline uintptr_t getInteropReturnArrayAddress() {
-  return reinterpret_cast<uintptr_t>(interopReturnArray.array.data());
+  return reinterpret_cast<uintptr_t>(boundInteropArrays->ret.array.data());
 }
 
 // Get the address of uarray in InteropReturnArray
 inline uintptr_t getInteropReturnUint32ArrayAddress() {
-  return reinterpret_cast<uintptr_t>(interopReturnArray.uarray.data());
+  return reinterpret_cast<uintptr_t>(boundInteropArrays->ret.uarray.data());
 }
 
 inline uintptr_t getInteropUint32ParamArrayAddress() {
-  return reinterpret_cast<uintptr_t>(interopUint32ParamArray.data.data());
+  return reinterpret_cast<uintptr_t>(
+      boundInteropArrays->uint32Param.data.data());
+}
+
+inline uintptr_t getInteropCharArrayAddress() {
+  return reinterpret_cast<uintptr_t>(boundInteropArrays->chars.data.data());
 }
 }  // namespace Skynet
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+// Work-stealing thread pool for the batch kernels of the threaded build.
+//
+// parallelFor(count, grain, body) cuts [0, count) into chunks of `grain`
+// elements and gives every participant (the calling thread and each worker)
+// a contiguous share of them. A participant that runs out of chunks steals
+// the back half of another participant's share. The body is called with
+// [begin, end) of one chunk and must only write the outputs of that range.
+// This keeps the result independent of which thread ran which chunk. A
+// reduction keeps one partial result per chunk (index begin / grain) and
+// merges them in chunk order after the call, so it is deterministic too.
+//
+// With FIXED64_THREADS=0 (the default) parallelFor calls the body once,
+// inline, and no threads exist. In the threaded wasm build the workers are
+// emscripten pthreads, i.e. Node worker_threads or web workers sharing the
+// module's memory. Unless setWorkerCount() chose a count before, the first
+// parallel call starts FIXED64_THREAD_POOL_SIZE workers, at most one per
+// core besides the calling thread.
+
+#include <cstdint>
+#include <type_traits>
+
+#ifndef FIXED64_THREADS
+#define FIXED64_THREADS 0
+#endif
+
+#ifndef FIXED64_THREAD_POOL_SIZE
+#define FIXED64_THREAD_POOL_SIZE 8
+#endif
+
+namespace Skynet {
+
+class JobPool {
+ public:
+  static constexpr uint32_t kMaxWorkers = 63;
+
+  // Elements per chunk for the batch entry points; a batch of fewer than two
+  // chunks stays on the calling thread
+  static constexpr uint32_t kBatchGrain = 2048;
+
+  using Job = void (*)(void *context, uint32_t begin, uint32_t end);
+
+  static constexpr bool enabled() { return FIXED64_THREADS != 0; }
+
+  template <typename Body>
+  static void parallelFor(uint32_t count, uint32_t grain, Body &&body) {
+    if constexpr (enabled()) {
+      using Target = std::remove_reference_t<Body>;
+      run(
+          count, grain,
+          [](void *context, uint32_t begin, uint32_t end) {
+            (*static_cast<Target *>(context))(begin, end);
+          },
+          const_cast<void *>(static_cast<const void *>(&body)));
+    } else if (count > 0) {
+      body(0u, count);
+    }
+  }
+
+  static void run(uint32_t count, uint32_t grain, Job job, void *context);
+
+  // JS entry points. Joins the current workers and starts `count` new ones
+  // (at most kMaxWorkers); 0 runs every batch on the calling thread. A no-op
+  // without FIXED64_THREADS.
+  static void setWorkerCount(uint32_t count);
+
+  static uint32_t workerCount();
+};
+
+}  // namespace Skynet
@@ -0,0 +1,13 @@
+#pragma once
+
+// Plane the 2D collision tests project Vector3s onto. XY belongs to
+// TwoDimensional worlds and XZ to ThreeDimensional ones (SimContext.h).
+// Rect and Vector3 take it as a template parameter, so a loop over many
+// shapes has no per-call branch on the world type; withWorldPlane() in
+// SimContext.h picks the instantiation once for the bound context.
+
+namespace Skynet {
+
+enum class Plane { XY, XZ };
+
+}  // namespace Skynet
@@ -0,0 +1,531 @@
+#pragma once
+
+// Opt-in recording of the calls made through the JS bindings, to reproduce
+// lockstep desyncs and to replay real traffic natively (see Replay.h).
+//
+// With FIXED64_RECORDING=1 every entry point of EntryPoints.h is bound
+// through Recorded<>::call. While a recording runs, each call appends one
+// record to a byte ring buffer that drops the oldest records when full:
+//
+//   entry id | arguments | param slots | uint32 param slots | chars
+//            | result | return slots | uint32 return array | written chars
+//
+// Only the interop slots the call touched are logged (see Interop.h); chars
+// are logged as inputs when read and as outputs when written.
+// Integers are LEB128 varints, zigzag encoded when signed; raw Fixed64 values
+// count as signed, and doubles are stored as their 8 little-endian bytes.
+// Arguments of type uintptr_t are addresses into wasm memory. That memory is
+// not part of the log, so the replayer skips those calls.
+//
+// Log layout, as returned by Recorder::writeLog():
+//
+//   "F64R" | version u8 | math version u8 | entry table digest u64
+//          | dropped records u64 | (record size varint | record)*
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Instrumentation.h"
+#include "Interop.h"
+#include "Snapshot.h"
+#include "StateHash.h"
+
+#ifndef FIXED64_MATH_VERSION
+#define FIXED64_MATH_VERSION 1
+#endif
+
+namespace Skynet {
+
+// Appends to a fixed buffer; stops writing and reports overflow() once full
+class RecordWriter {
+ public:
+  constexpr RecordWriter(uint8_t *data, size_t capacity)
+      : _data(data), _capacity(capacity) {}
+
+  // The fixed-size puts store bytes directly; a memcpy call per value would
+  // cost more than the encoding
+  void putByte(uint8_t value) {
+    if (reserve(1)) {
+      _data[_size++] = value;
+    }
+  }
+
+  void putVarint(uint64_t value) {
+    if (reserve(Snapshot::kMaxVarintSize)) {
+      _size += Snapshot::writeVarint(value, _data + _size);
+    }
+  }
+
+  void putSigned(int64_t value) { putVarint(Snapshot::zigzag(value)); }
+
+  void putDouble(double value) {
+    if (reserve(8)) {
+      uint64_t bits = std::bit_cast<uint64_t>(value);
+      for (int i = 0; i < 8; ++i) {
+        _data[_size++] = static_cast<uint8_t>(bits >> (8 * i));
+      }
+    }
+  }
+
+  void putBytes(const void *data, size_t size) {
+    if (size > 0 && reserve(size)) {
+      std::memcpy(_data + _size, data, size);
+      _size += size;
+    }
+  }
+
+  const uint8_t *data() const { return _data; }
+
+  size_t size() const { return _size; }
+
+  bool overflow() const { return _overflow; }
+
+  void clear() {
+    _size = 0;
+    _overflow = false;
+  }
+
+ private:
+  bool reserve(size_t size) {
+    if (_capacity - _size < size) {
+      _overflow = true;
+    }
+    return !_overflow;
+  }
+
+  uint8_t *_data;
+  size_t _capacity;
+  size_t _size = 0;
+  bool _overflow = false;
+};
+
+// Reads what RecordWriter wrote; every getter returns false past the end
+class RecordReader {
+ public:
+  RecordReader(const uint8_t *data, size_t size) : _data(data), _size(size) {}
+
+  bool getByte(uint8_t &value) { return getBytes(&value, 1); }
+
+  bool getVarint(uint64_t &value) {
+    size_t read = Snapshot::readVarint(_data + _offset, _size - _offset, value);
+    _offset += read;
+    return read != 0;
+  }
+
+  bool getSigned(int64_t &value) {
+    uint64_t encoded;
+    if (!getVarint(encoded)) {
+      return false;
+    }
+    value = Snapshot::unzigzag(encoded);
+    return true;
+  }
+
+  bool getDouble(double &value) {
+    uint8_t bytes[8];
+    if (!getBytes(bytes, sizeof(bytes))) {
+      return false;
+    }
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i) {
+      bits |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    value = std::bit_cast<double>(bits);
+    return true;
+  }
+
+  bool getBytes(void *out, size_t size) {
+    if (_size - _offset < size) {
+      return false;
+    }
+    std::memcpy(out, _data + _offset, size);
+    _offset += size;
+    return true;
+  }
+
+  bool skip(size_t size) {
+    if (_size - _offset < size) {
+      return false;
+    }
+    _offset += size;
+    return true;
+  }
+
+  const uint8_t *position() const { return _data + _offset; }
+
+  size_t remaining() const { return _size - _offset; }
+
+ private:
+  const uint8_t *_data;
+  size_t _size;
+  size_t _offset = 0;
+};
+
+// Encoding of argument and result types
+template <typename T>
+struct RecordCodec {
+  static_assert(std::is_arithmetic_v<T>, "unsupported entry point type");
+
+  static void write(RecordWriter &out, T value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      out.putByte(value ? 1 : 0);
+    } else if constexpr (std::is_floating_point_v<T>) {
+      out.putDouble(value);
+    } else if constexpr (std::is_signed_v<T>) {
+      out.putSigned(value);
+    } else {
+      out.putVarint(value);
+    }
+  }
+
+  static bool read(RecordReader &in, T &value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      uint8_t byte;
+      if (!in.getByte(byte)) {
+        return false;
+      }
+      value = byte != 0;
+      return true;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      double decoded;
+      if (!in.getDouble(decoded)) {
+        return false;
+      }
+      value = static_cast<T>(decoded);
+      return true;
+    } else if constexpr (std::is_signed_v<T>) {
+      int64_t decoded;
+      if (!in.getSigned(decoded)) {
+        return false;
+      }
+      value = static_cast<T>(decoded);
+      return true;
+    } else {
+      uint64_t decoded;
+      if (!in.getVarint(decoded)) {
+        return false;
+      }
+      value = static_cast<T>(decoded);
+      return true;
+    }
+  }
+
+  static std::string describe(T value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      return value ? "true" : "false";
+    } else {
+      return std::to_string(value);
+    }
+  }
+};
+
+template <>
+struct RecordCodec<std::string> {
+  static void write(RecordWriter &out, const std::string &value) {
+    out.putVarint(value.size());
+    out.putBytes(value.data(), value.size());
+  }
+
+  static bool read(RecordReader &in, std::string &value) {
+    uint64_t size;
+    if (!in.getVarint(size) || size > in.remaining()) {
+      return false;
+    }
+    const char *text = reinterpret_cast<const char *>(in.position());
+    value.assign(text, text + size);
+    return in.skip(size);
+  }
+
+  static std::string describe(const std::string &value) {
+    return "\"" + value + "\"";
+  }
+};
+
+// The interop state around a call, shared by the recorder and the replayer
+class RecordIo {
+ public:
+  static void resetTouched() {
+    getInteropParamArray().resetTouched();
+    getInteropUint32ParamArray().resetTouched();
+    getInteropCharArray().resetTouched();
+    getInteropReturnArray().resetTouched();
+  }
+
+  static void writeInputs(RecordWriter &out) {
+    const InteropParamArray &params = getInteropParamArray();
+    out.putVarint(params.touched());
+    for (size_t i = 0; i < params.touched(); ++i) {
+      const Fixed64Param &param = params.data[i];
+      out.putByte(param.isRaw ? 1 : 0);
+      if (param.isRaw) {
+        out.putDouble(param.raw);
+      } else {
+        out.putSigned(rawValue(param));
+      }
+    }
+    const InteropUint32ParamArray &uint32Params = getInteropUint32ParamArray();
+    out.putVarint(uint32Params.touched());
+    for (size_t i = 0; i < uint32Params.touched(); ++i) {
+      out.putVarint(uint32Params.data[i]);
+    }
+    const InteropCharArray &chars = getInteropCharArray();
+    out.putVarint(chars.touched());
+    out.putBytes(chars.data.data(), chars.touched());
+  }
+
+  static bool readInputs(RecordReader &in) {
+    uint64_t count;
+    InteropParamArray &params = getInteropParamArray();
+    if (!in.getVarint(count) || count > params.data.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      Fixed64Param &param = params.data[i];
+      uint8_t isRaw;
+      if (!in.getByte(isRaw)) {
+        return false;
+      }
+      param.isRaw = isRaw != 0;
+      if (param.isRaw) {
+        if (!in.getDouble(param.raw)) {
+          return false;
+        }
+      } else {
+        int64_t value;
+        if (!in.getSigned(value)) {
+          return false;
+        }
+        param = static_cast<Fixed64Param>(Fixed64(value));
+      }
+    }
+    InteropUint32ParamArray &uint32Params = getInteropUint32ParamArray();
+    if (!in.getVarint(count) || count > uint32Params.data.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      uint64_t value;
+      if (!in.getVarint(value)) {
+        return false;
+      }
+      uint32Params.data[i] = static_cast<uint32_t>(value);
+    }
+    InteropCharArray &chars = getInteropCharArray();
+    return in.getVarint(count) && count <= chars.data.size() &&
+           in.getBytes(chars.data.data(), count);
+  }
+
+  // Return slots, the uint32 return array and the written chars, after the
+  // result (if any)
+  static void writeOutputs(RecordWriter &out) {
+    InteropReturnArray &returns = getInteropReturnArray();
+    out.putVarint(returns.touched());
+    for (size_t i = 0; i < returns.touched(); ++i) {
+      out.putSigned(rawValue(returns.array[i]));
+    }
+    out.putByte(returns.uint32Touched() ? 1 : 0);
+    if (returns.uint32Touched()) {
+      out.putVarint(returns.uint32ArrayLen());
+      for (uint32_t i = 0; i < returns.uint32ArrayLen(); ++i) {
+        out.putVarint(returns.uarray[i + 1]);
+      }
+    }
+    const InteropCharArray &chars = getInteropCharArray();
+    out.putVarint(chars.written());
+    out.putBytes(chars.data.data(), chars.written());
+  }
+
+  // Readable form of writeOutputs(), for divergence reports
+  static std::string describeOutputs(RecordReader &in) {
+    std::string text = "returns [";
+    uint64_t count;
+    if (!in.getVarint(count)) {
+      return "<truncated>";
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+      int64_t value;
+      if (!in.getSigned(value)) {
+        return text + "<truncated>";
+      }
+      char buffer[FixedDecimal::kMaxLength];
+      FixedDecimal::format(value, buffer, sizeof(buffer),
+                           FixedDecimal::kMaxDigits);
+      text += i > 0 ? ", " : "";
+      text += std::to_string(value);
+      text += " (";
+      text += buffer;
+      text += ")";
+    }
+    text += "]";
+    uint8_t uint32Touched;
+    if (!in.getByte(uint32Touched)) {
+      return text + " <truncated>";
+    }
+    if (uint32Touched) {
+      text += " uint32 [";
+      if (!in.getVarint(count)) {
+        return text + "<truncated>";
+      }
+      for (uint64_t i = 0; i < count; ++i) {
+        uint64_t value;
+        if (!in.getVarint(value)) {
+          return text + "<truncated>";
+        }
+        text += i > 0 ? ", " : "";
+        text += std::to_string(value);
+      }
+      text += "]";
+    }
+    if (!in.getVarint(count) || count > in.remaining()) {
+      return text + " <truncated>";
+    }
+    if (count > 0) {
+      const char *chars = reinterpret_cast<const char *>(in.position());
+      text += " chars \"" + std::string(chars, count) + "\"";
+      in.skip(count);
+    }
+    return text;
+  }
+
+ private:
+  static int64_t rawValue(const Fixed64Param &param) {
+    return static_cast<int64_t>(param.high) << 32 |
+           static_cast<int64_t>(param.low);
+  }
+};
+
+class Recorder {
+ public:
+  static constexpr uint8_t kMagic[4] = {'F', '6', '4', 'R'};
+  // 2: records end with the written chars
+  static constexpr uint8_t kVersion = 2;
+  static constexpr size_t kHeaderSize = 4 + 1 + 1 + 8 + 8;
+  static constexpr size_t kDefaultCapacity = 1 << 20;
+  // Upper bound of one record: every interop slot touched, plus arguments
+  static constexpr size_t kMaxRecordSize = 16384;
+
+  static constexpr bool enabled() { return FIXED64_RECORDING != 0; }
+
+  // Smallest ring, enough for any record size prefix
+  static constexpr size_t kMinCapacity = Snapshot::kMaxVarintSize;
+
+  // Starts a new recording into a ring of `capacity` bytes, at least
+  // kMinCapacity
+  static void start(size_t capacity = kDefaultCapacity);
+
+  static void stop() { _active = false; }
+
+  static bool active() { return _active; }
+
+  static size_t recordCount() { return _records; }
+
+  // Records lost to the ring wrapping around, or larger than the ring
+  static uint64_t droppedCount() { return _dropped; }
+
+  // Size of the log writeLog() produces
+  static size_t logSize() { return kHeaderSize + _used; }
+
+  // Writes the header and the records in call order. Returns the size, or 0
+  // if `capacity` is smaller than logSize().
+  static size_t writeLog(uint8_t *out, size_t capacity);
+
+  // XXH64 of the "Owner.name" list, identifying the entry id mapping
+  static uint64_t entryTableDigest() {
+    StateHash hash;
+    for (size_t i = 0; i < Instrumentation::kEntryPointCount; ++i) {
+      const char *name = Instrumentation::name(static_cast<EntryPoint>(i));
+      hash.update(name, std::strlen(name) + 1);
+    }
+    return hash.digest();
+  }
+
+  // Used by Recorded<>: the scratch record for the current call
+  static RecordWriter &beginRecord(EntryPoint id) {
+    _scratch.clear();
+    _scratch.putVarint(static_cast<uint32_t>(id));
+    return _scratch;
+  }
+
+  static void commitRecord();
+
+  // JS entry points; the log is copied to `out` in wasm memory
+  static void startWrapper(uint32_t capacity) { start(capacity); }
+  static uint32_t logSizeWrapper() { return static_cast<uint32_t>(logSize()); }
+  static uint32_t writeLogWrapper(uintptr_t out, uint32_t capacity) {
+    return static_cast<uint32_t>(
+        writeLog(reinterpret_cast<uint8_t *>(out), capacity));
+  }
+  static uint32_t recordCountWrapper() {
+    return static_cast<uint32_t>(recordCount());
+  }
+  static double droppedCountWrapper() {
+    return static_cast<double>(droppedCount());
+  }
+
+ private:
+  // Copies into / out of the ring at `offset`, wrapping at its end
+  static void ringWrite(size_t offset, const uint8_t *data, size_t size);
+  static void ringRead(size_t offset, uint8_t *out, size_t size);
+  static void dropOldest();
+
+  // Offsets stay below twice the ring size, so no division is needed
+  static size_t wrap(size_t offset) {
+    return offset >= _ring.size() ? offset - _ring.size() : offset;
+  }
+
+  static inline std::vector<uint8_t> _ring;
+  static inline size_t _head = 0;
+  static inline size_t _used = 0;
+  static inline size_t _records = 0;
+  static inline uint64_t _dropped = 0;
+  static inline bool _active = false;
+  // Records are encoded behind room for their size prefix
+  static inline uint8_t _scratchData[Snapshot::kMaxVarintSize + kMaxRecordSize];
+  static inline RecordWriter _scratch{_scratchData + Snapshot::kMaxVarintSize,
+                                      kMaxRecordSize};
+};
+
+template <EntryPoint Id, auto Function>
+struct Recorded;
+
+template <EntryPoint Id, typename R, typename... Args, R (*Function)(Args...)>
+struct Recorded<Id, Function> {
+  static R call(Args... args) {
+    if (!Recorder::active()) {
+      return Function(std::forward<Args>(args)...);
+    }
+    RecordWriter &record = Recorder::beginRecord(Id);
+    (RecordCodec<std::decay_t<Args>>::write(record, args), ...);
+    RecordIo::resetTouched();
+    if constexpr (std::is_void_v<R>) {
+      Function(std::forward<Args>(args)...);
+      RecordIo::writeInputs(record);
+      RecordIo::writeOutputs(record);
+      Recorder::commitRecord();
+    } else {
+      R result = Function(std::forward<Args>(args)...);
+      RecordIo::writeInputs(record);
+      RecordCodec<std::decay_t<R>>::write(record, result);
+      RecordIo::writeOutputs(record);
+      Recorder::commitRecord();
+      return result;
+    }
+  }
+};
+
+}  // namespace Skynet
+
+// Function pointer to bind for an entry of EntryPoints.h
+#if FIXED64_RECORDING
+#define FIXED64_ENTRY_FUNCTION(owner, name, fn)                              \
+  (&::Skynet::Recorded<::Skynet::EntryPoint::owner##_##name,                 \
+                       FIXED64_INSTRUMENTED_FUNCTION(owner, name, fn)>::call)
+#else
+#define FIXED64_ENTRY_FUNCTION(owner, name, fn) \
+  FIXED64_INSTRUMENTED_FUNCTION(owner, name, fn)
+#endif
@@ -1,15 +1,17 @@
 #pragma once
 #include "Fixed64.h"
+#include "SimContext.h"
 #include "Vector2.h"
 #include "Vector3.h"
 
-enum EBattleWorldType { TwoDimensional, ThreeDimensional };
-
-extern EBattleWorldType WorldType;
-
 using namespace Skynet;
 
 class Rect {
+  struct Uninitialized {};
+
+  // For onPlane(), which initializes the rect right after
+  explicit Rect(Uninitialized) {}
+
  public:
   Vector2 _center;
   Vector2 _direction;
@@ -103,15 +105,27 @@ class Rect {
     init(center, width, height, direction);
   }
 
+  template <Plane P>
+  static Rect onPlane(const Vector3 &center, const Fixed64 &width,
+                      const Fixed64 &height, const Vector3 &direction) {
+    Rect rect(Uninitialized{});
+    rect.init<P>(center, width, height, direction);
+    return rect;
+  }
+
+  // The Vector3 overloads project onto the plane of the bound context's world
+  // type; the templated ones onto P, without looking at the context
   void init(const Vector3 &center, const Fixed64 &width, const Fixed64 &height,
             const Vector3 &direction) {
-    if (WorldType == TwoDimensional) {
-      _center = Vector2(center._x, center._y);
-      _direction = Vector2(direction._x, direction._y);
-    } else {
-      _center = Vector2(center._x, center._z);
-      _direction = Vector2(direction._x, direction._z);
-    }
+    withWorldPlane(
+        [&]<Plane P>() { init<P>(center, width, height, direction); });
+  }
+
+  template <Plane P>
+  void init(const Vector3 &center, const Fixed64 &width, const Fixed64 &height,
+            const Vector3 &direction) {
+    _center = Vector2(center._x, center.planeY<P>());
+    _direction = Vector2(direction._x, direction.planeY<P>());
 
     _width = width;
     _height = height;
@@ -131,18 +145,13 @@ class Rect {
   }
 
   bool overlapsWithCircle(const Vector3 &center, const Fixed64 &radius) const {
-    Vector2 center2D;
-
-    // Convert 3D center to 2D
-    if (WorldType == TwoDimensional) {
-      center2D._x = center._x;
-      center2D._y = center._y;
-    } else {
-      center2D._x = center._x;
-      center2D._y = center._z;
-    }
+    return withWorldPlane(
+        [&]<Plane P>() { return overlapsWithCircle<P>(center, radius); });
+  }
 
-    return overlapsWithCircle(center2D, radius);
+  template <Plane P>
+  bool overlapsWithCircle(const Vector3 &center, const Fixed64 &radius) const {
+    return overlapsWithCircle(Vector2(center._x, center.planeY<P>()), radius);
   }
 
   bool overlapsWithCircle(const Vector2 &center, const Fixed64 &radius) const {
@@ -167,15 +176,12 @@ class Rect {
   }
 
   bool containsPoint(const Vector3 &point) const {
-    Vector2 tempVec;
+    return withWorldPlane([&]<Plane P>() { return containsPoint<P>(point); });
+  }
 
-    if (WorldType == TwoDimensional) {
-      tempVec._x = point._x;
-      tempVec._y = point._y;
-    } else {
-      tempVec._x = point._x;
-      tempVec._y = point._z;
-    }
+  template <Plane P>
+  bool containsPoint(const Vector3 &point) const {
+    Vector2 tempVec(point._x, point.planeY<P>());
 
     tempVec = tempVec - _corn1;
     Fixed64 proj1 = Vector2::dot(tempVec, _axis1);
@@ -216,7 +222,26 @@ class Rect {
                Vector3(direction._x, direction._y, 0));
   }
 
+  // JS entry points; these use the bound context's world type, the OnPlane
+  // ones are exported per plane (overlapsWithCircleXY, ...XZ)
   static bool overlapsWithCircle(bool returnDistSquared);
   static bool overlapsWithRect();
   static bool containsPoint();
+
+  template <Plane P>
+  static bool overlapsWithCircleOnPlane(bool returnDistSquared);
+  template <Plane P>
+  static bool overlapsWithRectOnPlane();
+  template <Plane P>
+  static bool containsPointOnPlane();
+
+  // Indices of the circles overlapping the rect of params 0-7, as a view into
+  // the tick arena (TickArena.h). The circles are `count` raw Fixed64 center
+  // coordinates and radii; false if the tick arena is too small.
+  static bool queryCircles(uintptr_t xs, uintptr_t ys, uintptr_t zs,
+                           uintptr_t radii, uint32_t count);
+  // queryCircles() on native columns, `z` nullptr for circles at z = 0
+  static bool queryCircleColumns(const int64_t *x, const int64_t *y,
+                                 const int64_t *z, const int64_t *r,
+                                 uint32_t count);
 };
\ No newline at end of file
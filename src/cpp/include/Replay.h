@@ -0,0 +1,275 @@
+#pragma once
+
+// Native re-execution of a Recorder log (Recorder.h).
+//
+// Every record restores the interop slots its call read, calls the entry
+// point with the recorded arguments and encodes the outputs the same way the
+// recorder did; the first record whose bytes differ is reported with its
+// arguments and both outputs. Calls taking wasm addresses are skipped, as the
+// memory behind them is not in the log, but calls depending on state they
+// left behind (e.g. StateHash digests) still compare as long as the replay
+// runs against the same build flavor. SimContext.bind is skipped too, so a
+// recording of several contexts replays against the calling thread's one.
+//
+// Replayer::run() optionally times every call, which turns a recording of
+// real traffic into a native performance replay (see Fixed64Replay).
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include "Arena.h"
+#include "EntityTable.h"
+#include "Fixed64Native.h"
+#include "JobPool.h"
+#include "Recorder.h"
+#include "Rect.h"
+#include "Sector.h"
+#include "SimContext.h"
+#include "Snapshot.h"
+#include "StateHash.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+namespace Skynet {
+
+enum class ReplayStatus {
+  // Every executed record matched
+  Ok,
+  Diverged,
+  // Bad magic, unsupported version or a different entry point table
+  BadHeader,
+  // A record ended early or holds an unknown entry id
+  Malformed,
+};
+
+struct ReplayReport {
+  ReplayStatus status = ReplayStatus::Ok;
+  size_t records = 0;
+  size_t executed = 0;
+  // Calls with wasm address arguments
+  size_t skipped = 0;
+  size_t divergences = 0;
+  // First divergence (or the malformed record)
+  size_t index = 0;
+  EntryPoint entry = EntryPoint::Count;
+  std::string arguments;
+  std::string expected;
+  std::string actual;
+};
+
+// Per call scratch shared with the ReplayCall functions
+struct ReplayContext {
+  RecordWriter actual;
+  EntryPointStats *stats;
+  ReplayReport &report;
+};
+
+enum class ReplayOutcome { Match, Diverged, Skipped, Malformed };
+
+template <auto Function>
+struct ReplayCall;
+
+template <typename R, typename... Args, R (*Function)(Args...)>
+struct ReplayCall<Function> {
+  using Arguments = std::tuple<std::decay_t<Args>...>;
+
+  // Also true for calls returning an address (SimContext.create), whose
+  // result differs from run to run
+  static constexpr bool kUsesAddresses =
+      std::is_same_v<std::decay_t<R>, uintptr_t> ||
+      (std::is_same_v<std::decay_t<Args>, uintptr_t> || ...);
+
+  static ReplayOutcome run(RecordReader &in, ReplayContext &context) {
+    Arguments args;
+    bool read = std::apply(
+        [&](auto &...arg) {
+          return (RecordCodec<std::decay_t<decltype(arg)>>::read(in, arg) &&
+                  ...);
+        },
+        args);
+    if (!read || !RecordIo::readInputs(in)) {
+      return ReplayOutcome::Malformed;
+    }
+    if constexpr (kUsesAddresses) {
+      return ReplayOutcome::Skipped;
+    } else {
+      RecordIo::resetTouched();
+      RecordWriter &actual = context.actual;
+      actual.clear();
+      uint64_t start = context.stats ? Instrumentation::nowNs() : 0;
+      if constexpr (std::is_void_v<R>) {
+        std::apply(Function, args);
+      } else {
+        R result = std::apply(Function, args);
+        RecordCodec<std::decay_t<R>>::write(actual, result);
+      }
+      if (context.stats) {
+        context.stats->nanoseconds += Instrumentation::nowNs() - start;
+      }
+      RecordIo::writeOutputs(actual);
+      if (actual.size() == in.remaining() &&
+          std::memcmp(actual.data(), in.position(), actual.size()) == 0) {
+        return ReplayOutcome::Match;
+      }
+      if (context.report.divergences > 0) {
+        return ReplayOutcome::Diverged;
+      }
+      context.report.arguments = describeArguments(args);
+      RecordReader expected(in.position(), in.remaining());
+      context.report.expected = describeOutputs(expected);
+      RecordReader replayed(actual.data(), actual.size());
+      context.report.actual = describeOutputs(replayed);
+      return ReplayOutcome::Diverged;
+    }
+  }
+
+ private:
+  static std::string describeArguments(const Arguments &args) {
+    std::string text;
+    std::apply(
+        [&](const auto &...arg) {
+          ((text += text.empty() ? "" : ", ",
+            text += RecordCodec<std::decay_t<decltype(arg)>>::describe(arg)),
+           ...);
+        },
+        args);
+    return "(" + text + ")";
+  }
+
+  static std::string describeOutputs(RecordReader &in) {
+    std::string text;
+    if constexpr (!std::is_void_v<R>) {
+      std::decay_t<R> result;
+      if (!RecordCodec<std::decay_t<R>>::read(in, result)) {
+        return "<truncated>";
+      }
+      text = "result " + RecordCodec<std::decay_t<R>>::describe(result) + ", ";
+    }
+    return text + RecordIo::describeOutputs(in);
+  }
+};
+
+class Replayer {
+ public:
+  Replayer(const uint8_t *log, size_t size) : _log(log), _size(size) {
+    if (size < Recorder::kHeaderSize ||
+        std::memcmp(log, Recorder::kMagic, sizeof(Recorder::kMagic)) != 0) {
+      _error = "not a Fixed64 recording";
+    } else if (log[4] != Recorder::kVersion) {
+      _error = "unsupported recording version";
+    } else if (readUint64(log + 6) != Recorder::entryTableDigest()) {
+      _error = "recorded with a different entry point table";
+    } else if (log[5] != FIXED64_MATH_VERSION) {
+      // Not fatal: replaying against another math version is how its
+      // differences are found
+      _warning = "recorded with a different FIXED64_MATH_VERSION";
+    }
+  }
+
+  // Why the header was rejected, or nullptr
+  const char *error() const { return _error; }
+
+  // Set when the log is replayable but comes from a different build flavor
+  const char *warning() const { return _warning; }
+
+  uint8_t mathVersion() const { return _error ? 0 : _log[5]; }
+
+  // Records the recorder dropped before the first one in the log
+  uint64_t droppedCount() const { return _error ? 0 : readUint64(_log + 14); }
+
+  // Replays every record in order, by default stopping at the first
+  // divergence. With `stats` (indexed by EntryPoint), counts and times each
+  // executed call.
+  ReplayReport run(EntryPointStats *stats = nullptr,
+                   bool stopAtDivergence = true) const {
+    ReplayReport report;
+    if (_error) {
+      report.status = ReplayStatus::BadHeader;
+      return report;
+    }
+    static uint8_t scratch[Recorder::kMaxRecordSize];
+    RecordReader log(_log + Recorder::kHeaderSize,
+                     _size - Recorder::kHeaderSize);
+    while (log.remaining() > 0) {
+      size_t index = report.records++;
+      uint64_t size;
+      uint64_t id;
+      if (!log.getVarint(size) || size > log.remaining()) {
+        return malformed(report, index, EntryPoint::Count);
+      }
+      RecordReader record(log.position(), size);
+      log.skip(size);
+      if (!record.getVarint(id) || id >= Instrumentation::kEntryPointCount) {
+        return malformed(report, index, EntryPoint::Count);
+      }
+      EntryPoint entry = static_cast<EntryPoint>(id);
+      EntryPointStats *entryStats = stats ? &stats[id] : nullptr;
+      ReplayContext context{RecordWriter(scratch, sizeof(scratch)), entryStats,
+                            report};
+      switch (kFunctions[id](record, context)) {
+        case ReplayOutcome::Match:
+          ++report.executed;
+          if (entryStats) {
+            ++entryStats->calls;
+          }
+          break;
+        case ReplayOutcome::Skipped:
+          ++report.skipped;
+          break;
+        case ReplayOutcome::Diverged:
+          ++report.executed;
+          if (entryStats) {
+            ++entryStats->calls;
+          }
+          if (report.divergences++ == 0) {
+            report.status = ReplayStatus::Diverged;
+            report.index = index;
+            report.entry = entry;
+          }
+          if (stopAtDivergence) {
+            return report;
+          }
+          break;
+        case ReplayOutcome::Malformed:
+          return malformed(report, index, entry);
+      }
+    }
+    return report;
+  }
+
+ private:
+  using Function = ReplayOutcome (*)(RecordReader &, ReplayContext &);
+
+  static constexpr Function kFunctions[Instrumentation::kEntryPointCount] = {
+#define FIXED64_REPLAY_FUNCTION(owner, name, fn) &ReplayCall<fn>::run,
+      FIXED64_ENTRY_POINTS(FIXED64_REPLAY_FUNCTION)
+#undef FIXED64_REPLAY_FUNCTION
+  };
+
+  static ReplayReport &malformed(ReplayReport &report, size_t index,
+                                 EntryPoint entry) {
+    report.status = ReplayStatus::Malformed;
+    report.index = index;
+    report.entry = entry;
+    return report;
+  }
+
+  static uint64_t readUint64(const uint8_t *data) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+      value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+  }
+
+  const uint8_t *_log;
+  size_t _size;
+  const char *_error = nullptr;
+  const char *_warning = nullptr;
+};
+
+}  // namespace Skynet
@@ -61,5 +61,13 @@ class Sector {
   }
 
   bool static overlapsWithCircle();
+
+  // Indices of the circles overlapping the sector of params 0-7, as a view
+  // into the tick arena, see Rect::queryCircles
+  static bool queryCircles(uintptr_t xs, uintptr_t ys, uintptr_t zs,
+                           uintptr_t radii, uint32_t count);
+  static bool queryCircleColumns(const int64_t *x, const int64_t *y,
+                                 const int64_t *z, const int64_t *r,
+                                 uint32_t count);
 };
 }  // namespace Skynet
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+// Per-simulation state behind the entry points.
+//
+// A SimContext owns everything an entry point reads or writes besides its
+// arguments: the interop arrays JS marshals through, the world type of the
+// Rect tests, the StateHash stream and the tick arena (TickArena.h). Code,
+// LUTs, the JobPool, the recorder and the instrumentation counters stay
+// process-wide. Every thread has one bound context, the default context until
+// bind() picks another. One process or wasm instance can therefore host many
+// matches. A native server gives each match thread its own context, and a
+// single-threaded host binds the context of the match it is about to step.
+//
+// JS creates contexts with SimContext.create(), which returns the context's
+// address in module memory. SimContext.bind(address) binds one (0 for the
+// default) and SimContext.destroy(address) frees it. All contexts share one
+// layout, so the interop addresses of a context are its address plus the
+// offsets measured on the default context (see bindFixed64Context in
+// Fixed64WasmLoader). A context must not be destroyed while another thread
+// has it bound.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Interop.h"
+#include "Plane.h"
+#include "StateHash.h"
+#include "TickArena.h"
+
+namespace Skynet {
+
+enum EBattleWorldType { TwoDimensional, ThreeDimensional };
+
+class SimContext {
+ public:
+  InteropArrays interop;
+  // Plane of the Rect tests: XY for TwoDimensional, XZ for ThreeDimensional
+  EBattleWorldType worldType = TwoDimensional;
+  StateHash stateHash;
+  TickArena tickArena;
+
+  // The context bound to the calling thread
+  static SimContext &current() { return *_current; }
+
+  // Binds `context` to the calling thread, nullptr for the default context
+  static void bind(SimContext *context) {
+    _current = context ? context : _default;
+    boundInteropArrays = &_current->interop;
+  }
+
+  static SimContext &defaultContext() { return *_default; }
+
+  // Makes `context` the default and binds it to the calling thread. Threads
+  // that never bound a context keep the built-in default.
+  static void setDefault(SimContext &context) {
+    _default = &context;
+    bind(&context);
+  }
+
+  // Memory behind create() and destroy() and behind Arena::create(), malloc
+  // and free unless replaced; the Node addon hands it out from its heap
+  using Allocate = void *(*)(size_t size);
+  using Release = void (*)(void *memory);
+  static void setAllocator(Allocate allocate, Release release);
+  static void *allocate(size_t size);
+  static void release(void *memory);
+
+  static SimContext *create();
+
+  // Rebinds the default context first if `context` is bound to the calling
+  // thread. The default context itself is never destroyed.
+  static void destroy(SimContext *context);
+
+  // JS entry points, contexts passed as addresses
+  static uintptr_t createWrapper();
+  static void destroyWrapper(uintptr_t context);
+  static void bindWrapper(uintptr_t context);
+  static uintptr_t currentWrapper();
+  static void setWorldType(uint32_t type);
+  static uint32_t worldTypeWrapper();
+  static bool reserveTickArena(uint32_t capacity);
+  static void beginTick();
+  static uintptr_t tickArenaWrapper();
+  static uint32_t tickArenaUsed();
+  static uint32_t tickArenaPeak();
+  static uint32_t tickArenaOverflows();
+  static void resetTickArenaStats();
+
+ private:
+  static SimContext *_default;
+  static constinit thread_local SimContext *_current;
+};
+
+// Calls body.template operator()<P>() with the plane of the bound context's
+// world type, e.g. withWorldPlane([&]<Plane P>() { return test<P>(); })
+template <typename Body>
+decltype(auto) withWorldPlane(Body &&body) {
+  if (SimContext::current().worldType == TwoDimensional) {
+    return body.template operator()<Plane::XY>();
+  }
+  return body.template operator()<Plane::XZ>();
+}
+
+}  // namespace Skynet
@@ -0,0 +1,298 @@
+#pragma once
+
+// Versioned binary snapshot of raw Fixed64 columns.
+//
+// Layout (version 1), all multi-byte integers little-endian:
+//
+//   "F64S" | version u8 | column*
+//   column: mode u8 | count varint | [reference digest u64] | value varint*
+//
+// Values are stored as zigzag LEB128 varints of
+//   Absolute:   the raw value
+//   Sequential: the difference to the previous value of the column
+//   Reference:  the difference to the same index of a reference column, e.g.
+//               the previous snapshot; the column then carries the XXH64
+//               digest of the reference so a decoder cannot apply the delta
+//               to the wrong baseline.
+// Decoding is exact: every mode reproduces the raw values bit for bit.
+// Vectors are stored as one column per component.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "StateHash.h"
+
+namespace Skynet {
+
+enum class SnapshotMode : uint8_t { Absolute = 0, Sequential = 1, Reference = 2 };
+
+// Negative results of the JS entry points
+enum class SnapshotStatus : int32_t {
+  Ok = 0,
+  BufferTooSmall = -1,
+  BadMagic = -2,
+  UnsupportedVersion = -3,
+  Truncated = -4,
+  BadMode = -5,
+  ReferenceRequired = -6,
+  ReferenceMismatch = -7,
+  // The column holds more values than an int32 result can report
+  CountTooLarge = -8,
+};
+
+class Snapshot {
+ public:
+  static constexpr uint8_t kMagic[4] = {'F', '6', '4', 'S'};
+  static constexpr uint8_t kVersion = 1;
+  static constexpr size_t kHeaderSize = 5;
+  static constexpr size_t kMaxVarintSize = 10;
+
+  // Upper bound of the encoded size of a snapshot with one column
+  static constexpr size_t maxEncodedSize(size_t count) {
+    return kHeaderSize + 1 + kMaxVarintSize + 8 + count * kMaxVarintSize;
+  }
+
+  static uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^
+           static_cast<uint64_t>(value >> 63);
+  }
+
+  static int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>((value >> 1) ^ (0 - (value & 1)));
+  }
+
+  // Writes at most kMaxVarintSize bytes, returns the number written
+  static size_t writeVarint(uint64_t value, uint8_t *out) {
+    size_t size = 0;
+    while (value >= 0x80) {
+      out[size++] = static_cast<uint8_t>(value) | 0x80;
+      value >>= 7;
+    }
+    out[size++] = static_cast<uint8_t>(value);
+    return size;
+  }
+
+  // Returns the number of bytes read, 0 if the input ends early or the
+  // varint is longer than kMaxVarintSize
+  static size_t readVarint(const uint8_t *in, size_t size, uint64_t &value) {
+    value = 0;
+    size_t limit = size < kMaxVarintSize ? size : kMaxVarintSize;
+    for (size_t i = 0; i < limit; ++i) {
+      value |= static_cast<uint64_t>(in[i] & 0x7F) << (7 * i);
+      if ((in[i] & 0x80) == 0) {
+        return i + 1;
+      }
+    }
+    return 0;
+  }
+
+  // JS entry points for single-column snapshots. Addresses point into wasm
+  // memory, `reference` may be 0 unless mode is Reference. encode returns
+  // the snapshot size in bytes, decode the number of values, and both return
+  // a negative SnapshotStatus on failure.
+  static int32_t encode(uintptr_t values, uint32_t count, uint32_t mode,
+                        uintptr_t reference, uintptr_t out, uint32_t capacity);
+  static int32_t decode(uintptr_t in, uint32_t size, uintptr_t reference,
+                        uint32_t referenceCount, uintptr_t out,
+                        uint32_t capacity);
+  // Number of values in the first column, or a negative SnapshotStatus
+  static int32_t decodedCount(uintptr_t in, uint32_t size);
+  static uint32_t maxEncodedSizeWrapper(uint32_t count) {
+    return static_cast<uint32_t>(maxEncodedSize(count));
+  }
+};
+
+class SnapshotWriter {
+ public:
+  SnapshotWriter(uint8_t *out, size_t capacity)
+      : _out(out), _capacity(capacity) {
+    if (capacity < Snapshot::kHeaderSize) {
+      _status = SnapshotStatus::BufferTooSmall;
+      return;
+    }
+    std::memcpy(_out, Snapshot::kMagic, sizeof(Snapshot::kMagic));
+    _out[4] = Snapshot::kVersion;
+    _size = Snapshot::kHeaderSize;
+  }
+
+  // `reference` must hold `count` values when mode is Reference
+  SnapshotStatus writeColumn(const int64_t *values, size_t count,
+                             SnapshotMode mode,
+                             const int64_t *reference = nullptr) {
+    if (_status != SnapshotStatus::Ok) {
+      return _status;
+    }
+    if (mode == SnapshotMode::Reference && reference == nullptr) {
+      return _status = SnapshotStatus::ReferenceRequired;
+    }
+
+    uint8_t header[1 + Snapshot::kMaxVarintSize + 8];
+    size_t headerSize = 0;
+    header[headerSize++] = static_cast<uint8_t>(mode);
+    headerSize += Snapshot::writeVarint(count, header + headerSize);
+    if (mode == SnapshotMode::Reference) {
+      uint64_t digest = StateHash::hashRaw(reference, count);
+      for (int i = 0; i < 8; ++i) {
+        header[headerSize++] = static_cast<uint8_t>(digest >> (8 * i));
+      }
+    }
+    if (!append(header, headerSize)) {
+      return _status;
+    }
+
+    int64_t previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+      int64_t base = mode == SnapshotMode::Sequential  ? previous
+                     : mode == SnapshotMode::Reference ? reference[i]
+                                                       : 0;
+      // Wrapping difference, undone by the wrapping sum in the reader
+      uint64_t delta = static_cast<uint64_t>(values[i]) -
+                       static_cast<uint64_t>(base);
+      uint64_t encoded = Snapshot::zigzag(static_cast<int64_t>(delta));
+      if (_capacity - _size >= Snapshot::kMaxVarintSize) {
+        _size += Snapshot::writeVarint(encoded, _out + _size);
+      } else {
+        uint8_t varint[Snapshot::kMaxVarintSize];
+        if (!append(varint, Snapshot::writeVarint(encoded, varint))) {
+          return _status;
+        }
+      }
+      previous = values[i];
+    }
+    return _status;
+  }
+
+  SnapshotStatus status() const { return _status; }
+
+  size_t size() const { return _size; }
+
+ private:
+  bool append(const uint8_t *data, size_t size) {
+    if (_capacity - _size < size) {
+      _status = SnapshotStatus::BufferTooSmall;
+      return false;
+    }
+    std::memcpy(_out + _size, data, size);
+    _size += size;
+    return true;
+  }
+
+  uint8_t *_out;
+  size_t _capacity;
+  size_t _size = 0;
+  SnapshotStatus _status = SnapshotStatus::Ok;
+};
+
+class SnapshotReader {
+ public:
+  SnapshotReader(const uint8_t *in, size_t size) : _in(in), _size(size) {
+    if (size < Snapshot::kHeaderSize) {
+      _status = SnapshotStatus::Truncated;
+    } else if (std::memcmp(in, Snapshot::kMagic, sizeof(Snapshot::kMagic)) !=
+               0) {
+      _status = SnapshotStatus::BadMagic;
+    } else if (in[4] != Snapshot::kVersion) {
+      _status = SnapshotStatus::UnsupportedVersion;
+    } else {
+      _offset = Snapshot::kHeaderSize;
+    }
+  }
+
+  bool atEnd() const {
+    return _status != SnapshotStatus::Ok || _offset == _size;
+  }
+
+  // Number of values in the next column, at most INT32_MAX; -1 on error
+  int64_t nextColumnCount() {
+    uint64_t count;
+    if (_status != SnapshotStatus::Ok ||
+        _offset >= _size ||
+        Snapshot::readVarint(_in + _offset + 1, _size - _offset - 1, count) ==
+            0) {
+      if (_status == SnapshotStatus::Ok) {
+        _status = SnapshotStatus::Truncated;
+      }
+      return -1;
+    }
+    if (count > static_cast<uint64_t>(INT32_MAX)) {
+      return fail(SnapshotStatus::CountTooLarge);
+    }
+    return static_cast<int64_t>(count);
+  }
+
+  // Reads the next column into out; `reference` must hold referenceCount
+  // values for Reference columns. Returns the number of values read, -1 on
+  // error (see status()).
+  int64_t readColumn(int64_t *out, size_t capacity,
+                     const int64_t *reference = nullptr,
+                     size_t referenceCount = 0) {
+    int64_t count = nextColumnCount();
+    if (count < 0) {
+      return -1;
+    }
+    uint8_t mode = _in[_offset];
+    if (mode > static_cast<uint8_t>(SnapshotMode::Reference)) {
+      return fail(SnapshotStatus::BadMode);
+    }
+    uint64_t unused;
+    size_t offset =
+        _offset + 1 + Snapshot::readVarint(_in + _offset + 1,
+                                           _size - _offset - 1, unused);
+    if (static_cast<uint64_t>(count) > capacity) {
+      return fail(SnapshotStatus::BufferTooSmall);
+    }
+
+    if (mode == static_cast<uint8_t>(SnapshotMode::Reference)) {
+      if (reference == nullptr) {
+        return fail(SnapshotStatus::ReferenceRequired);
+      }
+      if (_size - offset < 8) {
+        return fail(SnapshotStatus::Truncated);
+      }
+      uint64_t digest = 0;
+      for (int i = 0; i < 8; ++i) {
+        digest |= static_cast<uint64_t>(_in[offset + i]) << (8 * i);
+      }
+      offset += 8;
+      if (referenceCount != static_cast<uint64_t>(count) ||
+          StateHash::hashRaw(reference, referenceCount) != digest) {
+        return fail(SnapshotStatus::ReferenceMismatch);
+      }
+    }
+
+    uint64_t previous = 0;
+    for (int64_t i = 0; i < count; ++i) {
+      uint64_t encoded;
+      size_t read = Snapshot::readVarint(_in + offset, _size - offset, encoded);
+      if (read == 0) {
+        return fail(SnapshotStatus::Truncated);
+      }
+      offset += read;
+      uint64_t base =
+          mode == static_cast<uint8_t>(SnapshotMode::Sequential) ? previous
+          : mode == static_cast<uint8_t>(SnapshotMode::Reference)
+              ? static_cast<uint64_t>(reference[i])
+              : 0;
+      previous = base + static_cast<uint64_t>(Snapshot::unzigzag(encoded));
+      out[i] = static_cast<int64_t>(previous);
+    }
+    _offset = offset;
+    return count;
+  }
+
+  SnapshotStatus status() const { return _status; }
+
+ private:
+  int64_t fail(SnapshotStatus status) {
+    _status = status;
+    return -1;
+  }
+
+  const uint8_t *_in;
+  size_t _size;
+  size_t _offset = 0;
+  SnapshotStatus _status = SnapshotStatus::Ok;
+};
+
+}  // namespace Skynet
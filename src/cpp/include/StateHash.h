@@ -0,0 +1,181 @@
+#pragma once
+
+// Streaming 64-bit state hash (XXH64) for lockstep desync checks.
+//
+// Input is consumed as little-endian 64-bit lanes, so a raw Fixed64 column
+// hashes to the same value on every platform. digest() does not finalize the
+// state: a session can keep one running hash and take a digest every tick,
+// or reset() with a per-tick seed and hash only that tick's state.
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Fixed64.h"
+#include "Interop.h"
+
+namespace Skynet {
+
+class StateHash {
+ public:
+  explicit StateHash(uint64_t seed = 0) { reset(seed); }
+
+  void reset(uint64_t seed = 0) {
+    _lanes[0] = seed + kPrime1 + kPrime2;
+    _lanes[1] = seed + kPrime2;
+    _lanes[2] = seed;
+    _lanes[3] = seed - kPrime1;
+    _seed = seed;
+    _length = 0;
+    _bufferSize = 0;
+  }
+
+  void update(const void *data, size_t size) {
+    const uint8_t *input = static_cast<const uint8_t *>(data);
+    _length += size;
+
+    if (_bufferSize + size < sizeof(_buffer)) {
+      std::memcpy(_buffer + _bufferSize, input, size);
+      _bufferSize += size;
+      return;
+    }
+    if (_bufferSize > 0) {
+      size_t fill = sizeof(_buffer) - _bufferSize;
+      std::memcpy(_buffer + _bufferSize, input, fill);
+      consumeStripe(_buffer);
+      input += fill;
+      size -= fill;
+      _bufferSize = 0;
+    }
+    for (; size >= sizeof(_buffer); size -= sizeof(_buffer)) {
+      consumeStripe(input);
+      input += sizeof(_buffer);
+    }
+    std::memcpy(_buffer, input, size);
+    _bufferSize = size;
+  }
+
+  void update(Fixed64 value) { updateRaw(&value.value, 1); }
+
+  // `count` raw Fixed64 values, e.g. one column of a component table
+  void updateRaw(const int64_t *values, size_t count) {
+    if constexpr (std::endian::native == std::endian::little) {
+      update(values, count * sizeof(int64_t));
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        uint64_t value = toLittleEndian(static_cast<uint64_t>(values[i]));
+        update(&value, sizeof(value));
+      }
+    }
+  }
+
+  uint64_t digest() const {
+    uint64_t hash;
+    if (_length >= sizeof(_buffer)) {
+      hash = std::rotl(_lanes[0], 1) + std::rotl(_lanes[1], 7) +
+             std::rotl(_lanes[2], 12) + std::rotl(_lanes[3], 18);
+      for (uint64_t lane : _lanes) {
+        hash = (hash ^ round(0, lane)) * kPrime1 + kPrime4;
+      }
+    } else {
+      hash = _seed + kPrime5;
+    }
+    hash += _length;
+
+    const uint8_t *tail = _buffer;
+    size_t size = _bufferSize;
+    for (; size >= 8; size -= 8, tail += 8) {
+      hash ^= round(0, read64(tail));
+      hash = std::rotl(hash, 27) * kPrime1 + kPrime4;
+    }
+    if (size >= 4) {
+      hash ^= static_cast<uint64_t>(read32(tail)) * kPrime1;
+      hash = std::rotl(hash, 23) * kPrime2 + kPrime3;
+      size -= 4;
+      tail += 4;
+    }
+    for (; size > 0; --size, ++tail) {
+      hash ^= *tail * kPrime5;
+      hash = std::rotl(hash, 11) * kPrime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+  // One-shot hash of a raw Fixed64 column
+  static uint64_t hashRaw(const int64_t *values, size_t count,
+                          uint64_t seed = 0) {
+    StateHash hash(seed);
+    hash.updateRaw(values, count);
+    return hash.digest();
+  }
+
+  // JS entry points, operating on the shared hasher. 64-bit seeds and
+  // digests cross as high/low uint32 pairs; digests are returned in the
+  // uint32 return array as [2, high, low].
+  static void resetWrapper(uint32_t seedHigh, uint32_t seedLow);
+  // Hashes `count` Fixed64 values from the interop parameter array
+  static void updateParams(uint32_t count);
+  static void updateBytes(uintptr_t data, uint32_t size);
+  static void updateColumn(uintptr_t values, uint32_t count);
+  static void updateVector2Columns(uintptr_t xs, uintptr_t ys, uint32_t count);
+  static void updateVector3Columns(uintptr_t xs, uintptr_t ys, uintptr_t zs,
+                                   uint32_t count);
+  static void digestWrapper();
+
+ private:
+  static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+  static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+  static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+  static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+  static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+  static uint64_t toLittleEndian(uint64_t value) {
+    if constexpr (std::endian::native == std::endian::little) {
+      return value;
+    } else {
+      return __builtin_bswap64(value);
+    }
+  }
+
+  static uint64_t read64(const uint8_t *data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return toLittleEndian(value);
+  }
+
+  static uint32_t read32(const uint8_t *data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    if constexpr (std::endian::native == std::endian::little) {
+      return value;
+    } else {
+      return __builtin_bswap32(value);
+    }
+  }
+
+  static uint64_t round(uint64_t lane, uint64_t input) {
+    lane += input * kPrime2;
+    return std::rotl(lane, 31) * kPrime1;
+  }
+
+  void consumeStripe(const uint8_t *stripe) {
+    for (int i = 0; i < 4; ++i) {
+      _lanes[i] = round(_lanes[i], read64(stripe + i * 8));
+    }
+  }
+
+  uint64_t _lanes[4];
+  uint64_t _seed;
+  uint64_t _length;
+  uint8_t _buffer[32];
+  size_t _bufferSize;
+};
+
+}  // namespace Skynet
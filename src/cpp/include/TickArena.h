@@ -0,0 +1,139 @@
+#pragma once
+
+// Per-tick scratch memory of a SimContext.
+//
+// Query results (hit lists and the like) and native temporaries of a tick are
+// taken from the context's tick arena instead of std::vector, so the gameplay
+// hot path never calls malloc or free. SimContext.beginTick() frees all of
+// them at once. The block is reserved outside the tick with
+// SimContext.reserveTickArena(capacity). A request that does not fit gets
+// nothing and counts as an overflow. peak() is the high-water mark of the
+// requests themselves, failed ones included, so a block of peak() bytes fits
+// every tick seen so far.
+//
+// Results reach JS as views: writeView() stores the offset of the result in
+// the arena and its element count in return uint32 slots 0 and 1, and JS
+// reads them at SimContext.tickArena() + offset, e.g. through a view over the
+// whole arena kept for good in a FIXED64_HEAP_SIZE build (see Arena.h).
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Arena.h"
+#include "Interop.h"
+
+namespace Skynet {
+
+class TickArena {
+ public:
+  TickArena() = default;
+  TickArena(const TickArena &) = delete;
+  TickArena &operator=(const TickArena &) = delete;
+  ~TickArena() { Arena::destroy(_arena); }
+
+  // Replaces the block by one of `capacity` bytes, keeping the old one if
+  // the memory is not available. Frees everything allocated this tick.
+  bool reserve(size_t capacity) {
+    Arena *arena = Arena::create(capacity);
+    if (!arena) {
+      return false;
+    }
+    Arena::destroy(_arena);
+    _arena = arena;
+    return true;
+  }
+
+  // Ends the previous tick and frees everything
+  void begin() {
+    if (_arena) {
+      _arena->reset();
+    }
+  }
+
+  // Room for `count` elements, nullptr (and an overflow) if it does not fit.
+  // Either way the request counts toward peak() at its full size, before
+  // any shrink().
+  template <typename T>
+  T *allocate(size_t count) {
+    size_t size = count > SIZE_MAX / sizeof(T) ? SIZE_MAX : count * sizeof(T);
+    size_t used = this->used();
+    size_t start = (used + Arena::kAlignment - 1) & ~(Arena::kAlignment - 1);
+    size_t end = start < used || size > SIZE_MAX - start ? SIZE_MAX
+                                                         : start + size;
+    _peak = end > _peak ? end : _peak;
+    T *block = _arena ? _arena->allocate<T>(count) : nullptr;
+    if (!block) {
+      ++_overflows;
+    }
+    return block;
+  }
+
+  // Gives back the end of the latest allocation, keeping its first `count`
+  // elements, e.g. a hit list allocated for the worst case
+  template <typename T>
+  void shrink(T *block, size_t count) {
+    _arena->rewind(offsetOf(block) + count * sizeof(T));
+  }
+
+  uint32_t offsetOf(const void *block) const {
+    return static_cast<uint32_t>(static_cast<const uint8_t *>(block) -
+                                 _arena->data());
+  }
+
+  // Publishes `count` elements at `block` (nullptr for none) as the result
+  // of the current call
+  template <typename T>
+  void writeView(const T *block, size_t count) {
+    InteropReturnArray &ret = getInteropReturnArray();
+    ret.clear();
+    ret.push_back(block ? offsetOf(block) : 0);
+    ret.push_back(block ? static_cast<uint32_t>(count) : 0);
+  }
+
+  // Publishes the indices i < count for which hit(i) holds. Allocates for the
+  // worst case, so false (and an empty view) if `count` indices do not fit.
+  template <typename Hit>
+  bool writeIndices(uint32_t count, Hit &&hit) {
+    uint32_t *indices = allocate<uint32_t>(count);
+    if (!indices) {
+      writeView<uint32_t>(nullptr, 0);
+      return false;
+    }
+    size_t hits = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+      if (hit(i)) {
+        indices[hits++] = i;
+      }
+    }
+    shrink(indices, hits);
+    writeView(indices, hits);
+    return true;
+  }
+
+  // Address of the block, 0 before reserve()
+  uintptr_t address() const {
+    return _arena ? reinterpret_cast<uintptr_t>(_arena->data()) : 0;
+  }
+
+  size_t capacity() const { return _arena ? _arena->capacity() : 0; }
+  size_t used() const { return _arena ? _arena->used() : 0; }
+
+  // Bytes the block needs for every request since resetStats(), i.e. the
+  // highest end of any request, aligned and unshrunk
+  size_t peak() const { return _peak; }
+
+  // Allocations that did not fit since resetStats()
+  uint32_t overflows() const { return _overflows; }
+
+  void resetStats() {
+    _peak = 0;
+    _overflows = 0;
+  }
+
+ private:
+  Arena *_arena = nullptr;
+  size_t _peak = 0;
+  uint32_t _overflows = 0;
+};
+
+}  // namespace Skynet
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <sstream>  // For toString conversion
-
 #include "Fixed64.h"
 #include "Fixed64Native.h"
 #include "FixedMath.h"
@@ -37,11 +35,10 @@ class Vector2 {
   void setWrapper();
 
   Vector2 &normalize() {
-    Fixed64 len = this->len();
-    if (len != Fixed64Const::Zero) {
-      _x = _x / len;
-      _y = _y / len;
-    }
+    Fixed64 components[2] = {_x, _y};
+    FixedMath::Normalize(components);
+    _x = components[0];
+    _y = components[1];
     return *this;
   }
 
@@ -57,12 +54,6 @@ class Vector2 {
     return Vector2(_x - other._x, _y - other._y);
   }
 
-  std::string toString() const {
-    std::stringstream ss;
-    ss << "{x: " << _x.toString() << ", y: " << _y.toString() << "}";
-    return ss.str();
-  }
-
   static Fixed64 dot(const Vector2 &vec1, const Vector2 &vec2) {
     return vec1._x * vec2._x + vec1._y * vec2._y;
   }
@@ -176,6 +167,7 @@ class Vector2 {
   }
 
   static void normalizeWrapper();
+  static void normalizeMany(uintptr_t xs, uintptr_t ys, uint32_t count);
   static void addWrapper();
   static void subWrapper();
   static void scalar();
@@ -187,12 +179,6 @@ inline Vector2 operator*(Fixed64 s, const Vector2 &vector) {
   return Vector2(s * vector.x(), s * vector.y());
 }
 
-inline std::ostream &operator<<(std::ostream &os, const Vector2 &vector) {
-  os << "(" << vector.x().toString() << "," << vector.y().toString() << ")";
-
-  return os;
-}
-
 inline Fixed64 abs(const Vector2 &vector) { return vector.len(); }
 
 inline Fixed64 absSq(const Vector2 &vector) { return vector * vector; }
@@ -202,11 +188,8 @@ inline Fixed64 det(const Vector2 &vector1, const Vector2 &vector2) {
 }
 
 inline Vector2 normalize(const Vector2 &vector) {
-  auto len = abs(vector);
-  if (len != Fixed64Const::Zero) {
-    return vector / len;
-  }
-  return vector;
+  Vector2 result = vector;
+  return result.normalize();
 }
 
 inline Vector2 getInteropVector2Param(size_t offset) {
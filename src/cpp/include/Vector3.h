@@ -1,10 +1,9 @@
 #pragma once
 
-#include <sstream>
-
 #include "Fixed64.h"
 #include "Fixed64Native.h"
 #include "Interop.h"
+#include "Plane.h"
 
 namespace Skynet {
 class Vector3 {
@@ -28,6 +27,16 @@ class Vector3 {
   Fixed64 y() const { return _y; }
   Fixed64 z() const { return _z; }
 
+  // Second coordinate of the projection onto P, the first being x
+  template <Plane P>
+  Fixed64 planeY() const {
+    if constexpr (P == Plane::XY) {
+      return _y;
+    } else {
+      return _z;
+    }
+  }
+
   Vector3(const Vector3 &other) : _x(other._x), _y(other._y), _z(other._z) {}
 
   bool isZero() const {
@@ -96,12 +105,11 @@ class Vector3 {
   Fixed64 length() const { return FixedMath::Sqrt(lengthSqr()); }
 
   void normalize() {
-    Fixed64 length = FixedMath::Sqrt(lengthSqr());
-    if (length != 0) {
-      _x = _x / length;
-      _y = _y / length;
-      _z = _z / length;
-    }
+    Fixed64 components[3] = {_x, _y, _z};
+    FixedMath::Normalize(components);
+    _x = components[0];
+    _y = components[1];
+    _z = components[2];
   }
 
   static Fixed64 lerpScalar(Fixed64 a, Fixed64 b, Fixed64 t) {
@@ -135,16 +143,12 @@ class Vector3 {
     }
   }
 
+  template <Plane P>
   static bool checkCircleOverlap(const Vector3 &center1, const Vector3 &center2,
                                  const Fixed64 &radius1, const Fixed64 &radius2,
-                                 bool is2D, Fixed64 *ptrDistSquared = nullptr) {
+                                 Fixed64 *ptrDistSquared = nullptr) {
     Fixed64 diffX = center1.x() - center2.x();
-    Fixed64 diffY;
-    if (is2D) {
-      diffY = center1.y() - center2.y();
-    } else {
-      diffY = center1.z() - center2.z();
-    }
+    Fixed64 diffY = center1.planeY<P>() - center2.planeY<P>();
 
     Fixed64 distSquared = diffX * diffX + diffY * diffY;
     Fixed64 radiusSum = radius1 + radius2;
@@ -154,19 +158,24 @@ class Vector3 {
     return distSquared <= radiusSum * radiusSum;
   }
 
+  static bool checkCircleOverlap(const Vector3 &center1, const Vector3 &center2,
+                                 const Fixed64 &radius1, const Fixed64 &radius2,
+                                 bool is2D, Fixed64 *ptrDistSquared = nullptr) {
+    return is2D ? checkCircleOverlap<Plane::XY>(center1, center2, radius1,
+                                                radius2, ptrDistSquared)
+                : checkCircleOverlap<Plane::XZ>(center1, center2, radius1,
+                                                radius2, ptrDistSquared);
+  }
+
+  template <Plane P>
   static bool checkRingCircleOverlap(const Vector3 &ringCenter,
                                      const Fixed64 &ringInnerRadius,
                                      const Fixed64 &ringOuterRadius,
                                      const Vector3 &circleCenter,
-                                     const Fixed64 &circleRadius, bool is2D,
+                                     const Fixed64 &circleRadius,
                                      Fixed64 *ptrDistSquared = nullptr) {
     Fixed64 diffX = ringCenter.x() - circleCenter.x();
-    Fixed64 diffY;
-    if (is2D) {
-      diffY = ringCenter.y() - circleCenter.y();
-    } else {
-      diffY = ringCenter.z() - circleCenter.z();
-    }
+    Fixed64 diffY = ringCenter.planeY<P>() - circleCenter.planeY<P>();
 
     Fixed64 distSquared = diffX * diffX + diffY * diffY;
     if (ptrDistSquared) {
@@ -199,6 +208,20 @@ class Vector3 {
     return isOverlap;
   }
 
+  static bool checkRingCircleOverlap(const Vector3 &ringCenter,
+                                     const Fixed64 &ringInnerRadius,
+                                     const Fixed64 &ringOuterRadius,
+                                     const Vector3 &circleCenter,
+                                     const Fixed64 &circleRadius, bool is2D,
+                                     Fixed64 *ptrDistSquared = nullptr) {
+    return is2D ? checkRingCircleOverlap<Plane::XY>(
+                      ringCenter, ringInnerRadius, ringOuterRadius,
+                      circleCenter, circleRadius, ptrDistSquared)
+                : checkRingCircleOverlap<Plane::XZ>(
+                      ringCenter, ringInnerRadius, ringOuterRadius,
+                      circleCenter, circleRadius, ptrDistSquared);
+  }
+
   static bool checkLineCircleIntersect(const Vector3 &point1,
                                        const Vector3 &point2,
                                        const Vector3 &center,
@@ -264,6 +287,8 @@ class Vector3 {
   static void div();
   static void scalar();
   static void normalizeWrapper();
+  static void normalizeMany(uintptr_t xs, uintptr_t ys, uintptr_t zs,
+                            uint32_t count);
   static void normalizedDirection();
   static void negative();
   static void distance();
@@ -277,6 +302,9 @@ class Vector3 {
   static void rotateZWrapper();
   static void lerp();
   static bool isCircleOverlaps(bool is2D, bool returnDistSquared);
+  // isCircleOverlaps on a fixed plane, exported as isCircleOverlapsXY/XZ
+  template <Plane P>
+  static bool isCircleOverlapsOnPlane(bool returnDistSquared);
   static Vector3 decayKnockbackVector(const Vector3 &vec, Fixed64 deltaTime,
                                       Fixed64 decaySpeed);
   static void decayKnockbackVectorWrapper();
@@ -0,0 +1,631 @@
+// NodeAddon.cpp
+// Fixed64Node: the core as a Node-API addon, for servers that would rather
+// run native code than the wasm build. The exports mirror the emscripten
+// module as far as the TS wrappers use it:
+//
+//   - the entry points of EntryPoints.h on objects named after their embind
+//     class (free functions on the module itself)
+//   - HEAP8 ... HEAPF64 views, _malloc, _free and getFixedHeapSize
+//   - the interop array addresses and Fixed64Param layout getters
+//   - Recorder, getStats, resetStats, setStatsTiming and isInstrumented
+//
+// The heap is a static block of FIXED64_NODE_HEAP_SIZE bytes exposed as one
+// external ArrayBuffer. Addresses are offsets into it, so uintptr_t arguments
+// are translated back into pointers and uintptr_t results into offsets. Every
+// address argument is checked before the call: HeapAccess knows how many
+// bytes each entry point reads or writes there, and a range that leaves the
+// heap throws a RangeError where wasm would trap. SimContexts, the default one
+// included, live in the heap, so their interop arrays are visible to JS like
+// in the wasm build. Embind's instance classes (Vector2 and Vector3 objects,
+// the registered vectors) are not part of the addon.
+//
+// The core is the same code as the wasm build and is compiled without FP
+// contraction, so results are bit-identical (Fixed64Determinism checks the
+// kernels). The heap is a process global: the addon can only be loaded once
+// per process, and a second load (e.g. from a worker thread) throws, which
+// makes the loader fall back to wasm.
+#include <node_api.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Arena.h"
+#include "EntityTable.h"
+#include "Fixed64Native.h"
+#include "JobPool.h"
+#include "NodeHeap.h"
+#include "Recorder.h"
+#include "Rect.h"
+#include "Sector.h"
+#include "SimContext.h"
+#include "Snapshot.h"
+#include "StateHash.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+using namespace Skynet;
+
+namespace {
+
+constexpr size_t kHeapSize = FIXED64_NODE_HEAP_SIZE;
+
+alignas(64) uint8_t heap[kHeapSize];
+
+uint8_t *heapBase() { return heap; }
+
+// The first block is left out, so that no allocation has address 0
+NodeHeap &nodeHeap() {
+  static NodeHeap instance(heapBase(), NodeHeap::kAlignment,
+                           kHeapSize - NodeHeap::kAlignment);
+  return instance;
+}
+
+void *allocateContext(size_t size) {
+  size_t offset = nodeHeap().allocate(size);
+  return offset ? heapBase() + offset : nullptr;
+}
+
+void releaseContext(void *memory) {
+  nodeHeap().release(static_cast<uint8_t *>(memory) - heapBase());
+}
+
+double heapOffset(uintptr_t address) {
+  return static_cast<double>(address - reinterpret_cast<uintptr_t>(heapBase()));
+}
+
+template <typename T>
+bool fromJs(napi_env env, napi_value value, T &out) {
+  if constexpr (std::is_same_v<T, uintptr_t>) {
+    // A heap address; JS numbers above 2^32 would be truncated, so they are
+    // read as doubles
+    double offset;
+    if (napi_get_value_double(env, value, &offset) != napi_ok ||
+        !(offset >= 0 && offset < static_cast<double>(kHeapSize))) {
+      return false;
+    }
+    // 0 is no address, as in wasm (SimContext.bind(0) binds the default)
+    out = offset == 0 ? 0
+                      : reinterpret_cast<uintptr_t>(heapBase()) +
+                            static_cast<size_t>(offset);
+    return true;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return napi_get_value_bool(env, value, &out) == napi_ok;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    double number;
+    bool ok = napi_get_value_double(env, value, &number) == napi_ok;
+    out = static_cast<T>(number);
+    return ok;
+  } else if constexpr (std::is_signed_v<T>) {
+    static_assert(sizeof(T) <= sizeof(int32_t));
+    int32_t number;
+    bool ok = napi_get_value_int32(env, value, &number) == napi_ok;
+    out = static_cast<T>(number);
+    return ok;
+  } else {
+    static_assert(sizeof(T) <= sizeof(uint32_t));
+    uint32_t number;
+    bool ok = napi_get_value_uint32(env, value, &number) == napi_ok;
+    out = static_cast<T>(number);
+    return ok;
+  }
+}
+
+// Whether `size` bytes at `address` lie in the heap. fromJs() already
+// checked that the address itself does; 0 only holds empty ranges.
+bool inHeap(uintptr_t address, uint64_t size) {
+  if (address == 0) {
+    return size == 0;
+  }
+  uint64_t offset = address - reinterpret_cast<uintptr_t>(heapBase());
+  return size <= kHeapSize - offset;
+}
+
+// An object passed by address, 0 for none
+template <typename T>
+bool objectInHeap(uintptr_t address) {
+  return address == 0 || inHeap(address, sizeof(T));
+}
+
+// The memory an entry point accesses through its address arguments, checked
+// with the arguments of each call. Entry points without address arguments
+// need no specialization; the others must have one.
+template <auto Function>
+struct HeapAccess {
+  template <typename... Args>
+  static bool check(const Args &...) {
+    static_assert(!(std::is_same_v<Args, uintptr_t> || ...),
+                  "address arguments need a HeapAccess specialization");
+    return true;
+  }
+};
+
+template <>
+struct HeapAccess<&Fixed64Native::parseFloatMany> {
+  static bool check(uintptr_t values, uint32_t count, uintptr_t out,
+                    uint32_t) {
+    return inHeap(values, count * uint64_t{8}) &&
+           inHeap(out, count * uint64_t{8});
+  }
+};
+
+template <>
+struct HeapAccess<&Fixed64Native::formatDecimalMany> {
+  static bool check(uintptr_t values, uint32_t count, uintptr_t out,
+                    uint32_t capacity, int, uint32_t) {
+    return inHeap(values, count * uint64_t{8}) && inHeap(out, capacity);
+  }
+};
+
+template <>
+struct HeapAccess<&Fixed64Native::parseDecimalMany> {
+  static bool check(uintptr_t text, uint32_t length, uint32_t, uintptr_t out,
+                    uint32_t capacity) {
+    return inHeap(text, length) && inHeap(out, capacity * uint64_t{8});
+  }
+};
+
+// ys, xs and out of the atan2 columns
+bool atan2ColumnsInHeap(uintptr_t ys, uintptr_t xs, uintptr_t out,
+                        uint32_t count, uint64_t outSize) {
+  return inHeap(ys, count * uint64_t{8}) && inHeap(xs, count * uint64_t{8}) &&
+         inHeap(out, count * outSize);
+}
+
+template <>
+struct HeapAccess<&Fixed64Native::atan2Many> {
+  static bool check(uintptr_t ys, uintptr_t xs, uintptr_t out,
+                    uint32_t count) {
+    return atan2ColumnsInHeap(ys, xs, out, count, 8);
+  }
+};
+
+template <>
+struct HeapAccess<&Fixed64Native::atan2DegMany> {
+  static bool check(uintptr_t ys, uintptr_t xs, uintptr_t out,
+                    uint32_t count) {
+    return atan2ColumnsInHeap(ys, xs, out, count, 8);
+  }
+};
+
+template <>
+struct HeapAccess<&Fixed64Native::atan2HeadingMany> {
+  static bool check(uintptr_t ys, uintptr_t xs, uintptr_t out,
+                    uint32_t count, int) {
+    return atan2ColumnsInHeap(ys, xs, out, count, 4);
+  }
+};
+
+template <>
+struct HeapAccess<&Vector2::normalizeMany> {
+  static bool check(uintptr_t xs, uintptr_t ys, uint32_t count) {
+    return inHeap(xs, count * uint64_t{8}) && inHeap(ys, count * uint64_t{8});
+  }
+};
+
+template <>
+struct HeapAccess<&Vector3::normalizeMany> {
+  static bool check(uintptr_t xs, uintptr_t ys, uintptr_t zs, uint32_t count) {
+    return inHeap(xs, count * uint64_t{8}) && inHeap(ys, count * uint64_t{8}) &&
+           inHeap(zs, count * uint64_t{8});
+  }
+};
+
+// Circle columns of the queries; zs is 0 for circles at z = 0
+bool circleColumnsInHeap(uintptr_t xs, uintptr_t ys, uintptr_t zs,
+                         uintptr_t radii, uint32_t count) {
+  uint64_t size = count * uint64_t{8};
+  return inHeap(xs, size) && inHeap(ys, size) &&
+         (zs == 0 || inHeap(zs, size)) && inHeap(radii, size);
+}
+
+template <>
+struct HeapAccess<&Rect::queryCircles> {
+  static bool check(uintptr_t xs, uintptr_t ys, uintptr_t zs, uintptr_t radii,
+                    uint32_t count) {
+    return circleColumnsInHeap(xs, ys, zs, radii, count);
+  }
+};
+
+template <>
+struct HeapAccess<&Sector::queryCircles> {
+  static bool check(uintptr_t xs, uintptr_t ys, uintptr_t zs, uintptr_t radii,
+                    uint32_t count) {
+    return circleColumnsInHeap(xs, ys, zs, radii, count);
+  }
+};
+
+template <>
+struct HeapAccess<&StateHash::updateBytes> {
+  static bool check(uintptr_t data, uint32_t size) {
+    return inHeap(data, size);
+  }
+};
+
+template <>
+struct HeapAccess<&StateHash::updateColumn> {
+  static bool check(uintptr_t values, uint32_t count) {
+    return inHeap(values, count * uint64_t{8});
+  }
+};
+
+template <>
+struct HeapAccess<&StateHash::updateVector2Columns> {
+  static bool check(uintptr_t xs, uintptr_t ys, uint32_t count) {
+    return inHeap(xs, count * uint64_t{8}) && inHeap(ys, count * uint64_t{8});
+  }
+};
+
+template <>
+struct HeapAccess<&StateHash::updateVector3Columns> {
+  static bool check(uintptr_t xs, uintptr_t ys, uintptr_t zs, uint32_t count) {
+    return inHeap(xs, count * uint64_t{8}) && inHeap(ys, count * uint64_t{8}) &&
+           inHeap(zs, count * uint64_t{8});
+  }
+};
+
+// The reference column is optional
+template <>
+struct HeapAccess<&Snapshot::encode> {
+  static bool check(uintptr_t values, uint32_t count, uint32_t,
+                    uintptr_t reference, uintptr_t out, uint32_t capacity) {
+    return inHeap(values, count * uint64_t{8}) &&
+           (reference == 0 || inHeap(reference, count * uint64_t{8})) &&
+           inHeap(out, capacity);
+  }
+};
+
+template <>
+struct HeapAccess<&Snapshot::decode> {
+  static bool check(uintptr_t in, uint32_t size, uintptr_t reference,
+                    uint32_t referenceCount, uintptr_t out,
+                    uint32_t capacity) {
+    return inHeap(in, size) &&
+           inHeap(reference, referenceCount * uint64_t{8}) &&
+           inHeap(out, capacity * uint64_t{8});
+  }
+};
+
+template <>
+struct HeapAccess<&Snapshot::decodedCount> {
+  static bool check(uintptr_t in, uint32_t size) { return inHeap(in, size); }
+};
+
+template <>
+struct HeapAccess<&Recorder::writeLogWrapper> {
+  static bool check(uintptr_t out, uint32_t capacity) {
+    return inHeap(out, capacity);
+  }
+};
+
+// Entry points taking an object created by their owner as first argument
+#define FIXED64_NODE_OBJECT_ACCESS(function, Type)              \
+  template <>                                                   \
+  struct HeapAccess<function> {                                 \
+    template <typename... Rest>                                 \
+    static bool check(uintptr_t object, const Rest &...) {      \
+      return objectInHeap<Type>(object);                        \
+    }                                                           \
+  };
+
+FIXED64_NODE_OBJECT_ACCESS(&SimContext::destroyWrapper, SimContext)
+FIXED64_NODE_OBJECT_ACCESS(&SimContext::bindWrapper, SimContext)
+FIXED64_NODE_OBJECT_ACCESS(&Arena::destroyWrapper, Arena)
+FIXED64_NODE_OBJECT_ACCESS(&Arena::allocateWrapper, Arena)
+FIXED64_NODE_OBJECT_ACCESS(&Arena::resetWrapper, Arena)
+FIXED64_NODE_OBJECT_ACCESS(&Arena::usedWrapper, Arena)
+FIXED64_NODE_OBJECT_ACCESS(&Arena::capacityWrapper, Arena)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::destroyWrapper, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::addColumnWrapper, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::spawnWrapper, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::despawnWrapper, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::rowOfWrapper, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::sizeWrapper, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::capacityWrapper, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::idsWrapper, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::columnWrapper, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::componentsWrapper, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::set, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::get, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::normalize, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::integrate, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::atan2, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::hash, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::queryRect, EntityTable)
+FIXED64_NODE_OBJECT_ACCESS(&EntityTable::querySector, EntityTable)
+#undef FIXED64_NODE_OBJECT_ACCESS
+
+template <typename T>
+napi_value toJs(napi_env env, const T &value) {
+  napi_value result = nullptr;
+  if constexpr (std::is_same_v<T, std::string>) {
+    napi_create_string_utf8(env, value.data(), value.size(), &result);
+  } else if constexpr (std::is_same_v<T, uintptr_t>) {
+    // A heap address, 0 stays 0 (e.g. a failed SimContext.create)
+    napi_create_double(env, value ? heapOffset(value) : 0, &result);
+  } else if constexpr (std::is_same_v<T, bool>) {
+    napi_get_boolean(env, value, &result);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    napi_create_double(env, value, &result);
+  } else if constexpr (std::is_signed_v<T>) {
+    static_assert(sizeof(T) <= sizeof(int32_t));
+    napi_create_int32(env, value, &result);
+  } else {
+    static_assert(sizeof(T) <= sizeof(uint32_t));
+    napi_create_uint32(env, value, &result);
+  }
+  return result;
+}
+
+napi_value undefined(napi_env env) {
+  napi_value result = nullptr;
+  napi_get_undefined(env, &result);
+  return result;
+}
+
+// A JS function calling Function, converting like embind does. Target is the
+// entry point Function wraps (instrumentation, recording), whose HeapAccess
+// applies.
+template <auto Function, auto Target = Function>
+struct NodeCall;
+
+template <typename R, typename... Args, R (*Function)(Args...), auto Target>
+struct NodeCall<Function, Target> {
+  static napi_value call(napi_env env, napi_callback_info info) {
+    constexpr size_t kArity = sizeof...(Args);
+    napi_value argv[kArity > 0 ? kArity : 1];
+    size_t argc = kArity;
+    if (napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr) !=
+        napi_ok) {
+      return nullptr;
+    }
+    if (argc < kArity) {
+      napi_throw_type_error(env, nullptr, "too few arguments");
+      return nullptr;
+    }
+    std::tuple<std::decay_t<Args>...> args;
+    bool ok = std::apply(
+        [&](auto &...arg) {
+          size_t index = 0;
+          return (fromJs(env, argv[index++], arg) && ...);
+        },
+        args);
+    if (!ok) {
+      napi_throw_type_error(env, nullptr, "invalid argument");
+      return nullptr;
+    }
+    bool inBounds = std::apply(
+        [](const auto &...arg) { return HeapAccess<Target>::check(arg...); },
+        args);
+    if (!inBounds) {
+      napi_throw_range_error(env, nullptr, "memory range outside the heap");
+      return nullptr;
+    }
+    if constexpr (std::is_void_v<R>) {
+      std::apply(Function, args);
+      return undefined(env);
+    } else {
+      return toJs(env, std::apply(Function, args));
+    }
+  }
+};
+
+bool define(napi_env env, napi_value object, const char *name,
+            napi_callback callback) {
+  napi_value function;
+  return napi_create_function(env, name, NAPI_AUTO_LENGTH, callback, nullptr,
+                              &function) == napi_ok &&
+         napi_set_named_property(env, object, name, function) == napi_ok;
+}
+
+// The object an entry point's owner maps to, created on first use
+napi_value owner(napi_env env, napi_value exports, const char *name) {
+  if (std::string(name) == "Module") {
+    return exports;
+  }
+  bool exists = false;
+  napi_value object;
+  napi_has_named_property(env, exports, name, &exists);
+  if (exists) {
+    napi_get_named_property(env, exports, name, &object);
+  } else {
+    napi_create_object(env, &object);
+    napi_set_named_property(env, exports, name, object);
+  }
+  return object;
+}
+
+uint32_t mallocWrapper(uint32_t size) {
+  return static_cast<uint32_t>(nodeHeap().allocate(size));
+}
+
+void freeWrapper(uintptr_t address) {
+  if (address != 0) {
+    nodeHeap().release(address - reinterpret_cast<uintptr_t>(heapBase()));
+  }
+}
+
+template <>
+struct HeapAccess<&freeWrapper> {
+  static bool check(uintptr_t address) { return inHeap(address, 0); }
+};
+
+int32_t getSizeOfFixed64Param() { return sizeof(Fixed64Param); }
+
+// The heap never grows, so JS may cache views over it
+double getFixedHeapSize() { return kHeapSize; }
+
+double interopParamArrayAddress() {
+  return heapOffset(getInteropParamArrayAddress());
+}
+
+double interopReturnArrayAddress() {
+  return heapOffset(getInteropReturnArrayAddress());
+}
+
+double interopReturnUint32ArrayAddress() {
+  return heapOffset(getInteropReturnUint32ArrayAddress());
+}
+
+double interopUint32ParamArrayAddress() {
+  return heapOffset(getInteropUint32ParamArrayAddress());
+}
+
+double interopCharArrayAddress() {
+  return heapOffset(getInteropCharArrayAddress());
+}
+
+void resetStats() { Instrumentation::reset(); }
+
+void setStatsTiming(bool enabled) { Instrumentation::setTiming(enabled); }
+
+bool isInstrumented() { return Instrumentation::enabled(); }
+
+bool isRecordingEnabled() { return Recorder::enabled(); }
+
+bool setNumber(napi_env env, napi_value object, const char *name,
+               double value) {
+  napi_value number;
+  return napi_create_double(env, value, &number) == napi_ok &&
+         napi_set_named_property(env, object, name, number) == napi_ok;
+}
+
+napi_value getFixed64ParamOffsets(napi_env env, napi_callback_info) {
+  napi_value offsets;
+  napi_create_object(env, &offsets);
+  setNumber(env, offsets, "isRaw", offsetof(Fixed64Param, isRaw));
+  setNumber(env, offsets, "raw", offsetof(Fixed64Param, raw));
+  setNumber(env, offsets, "high", offsetof(Fixed64Param, high));
+  setNumber(env, offsets, "low", offsetof(Fixed64Param, low));
+  return offsets;
+}
+
+// Same shape as getStats() in Bindings.cpp
+napi_value getStats(napi_env env, napi_callback_info) {
+  napi_value result;
+  napi_create_array(env, &result);
+  uint32_t length = 0;
+  for (size_t i = 0; i < Instrumentation::kEntryPointCount; ++i) {
+    EntryPoint id = static_cast<EntryPoint>(i);
+    const EntryPointStats &stats = Instrumentation::stats(id);
+    if (stats.calls == 0) {
+      continue;
+    }
+    napi_value entry;
+    napi_value name;
+    napi_create_object(env, &entry);
+    napi_create_string_utf8(env, Instrumentation::name(id), NAPI_AUTO_LENGTH,
+                            &name);
+    napi_set_named_property(env, entry, "name", name);
+    setNumber(env, entry, "calls", static_cast<double>(stats.calls));
+    setNumber(env, entry, "timeNs", static_cast<double>(stats.nanoseconds));
+    setNumber(env, entry, "cycles", static_cast<double>(stats.cycles));
+    napi_set_element(env, result, length++, entry);
+  }
+  return result;
+}
+
+bool defineHeapViews(napi_env env, napi_value exports) {
+  napi_value buffer;
+  if (napi_create_external_arraybuffer(env, heapBase(), kHeapSize, nullptr,
+                                       nullptr, &buffer) != napi_ok) {
+    return false;
+  }
+  struct View {
+    const char *name;
+    napi_typedarray_type type;
+    size_t elementSize;
+  };
+  constexpr View kViews[] = {
+      {"HEAP8", napi_int8_array, 1},
+      {"HEAPU8", napi_uint8_array, 1},
+      {"HEAP16", napi_int16_array, 2},
+      {"HEAPU16", napi_uint16_array, 2},
+      {"HEAP32", napi_int32_array, 4},
+      {"HEAPU32", napi_uint32_array, 4},
+      {"HEAPF32", napi_float32_array, 4},
+      {"HEAPF64", napi_float64_array, 8},
+      {"HEAP64", napi_bigint64_array, 8},
+      {"HEAPU64", napi_biguint64_array, 8},
+  };
+  for (const View &view : kViews) {
+    napi_value array;
+    if (napi_create_typedarray(env, view.type, kHeapSize / view.elementSize,
+                               buffer, 0, &array) != napi_ok ||
+        napi_set_named_property(env, exports, view.name, array) != napi_ok) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::atomic<bool> loaded{false};
+
+}  // namespace
+
+NAPI_MODULE_INIT() {
+  if (loaded.exchange(true)) {
+    napi_throw_error(env, nullptr,
+                     "Fixed64Node can only be loaded once per process");
+    return nullptr;
+  }
+  if (!defineHeapViews(env, exports)) {
+    napi_throw_error(env, nullptr,
+                     "Fixed64Node needs external ArrayBuffers for its heap");
+    return nullptr;
+  }
+
+  SimContext::setAllocator(&allocateContext, &releaseContext);
+  SimContext *context = SimContext::create();
+  if (!context) {
+    napi_throw_error(env, nullptr,
+                     "Fixed64Node has no heap left for its default context");
+    return nullptr;
+  }
+  SimContext::setDefault(*context);
+
+  bool ok = true;
+#define FIXED64_NODE_ENTRY_POINT(ownerName, name, fn)                  \
+  ok = ok && (kPlaceholderEntryPoint<fn> ||                            \
+              define(env, owner(env, exports, #ownerName), #name,      \
+                     &NodeCall<FIXED64_ENTRY_FUNCTION(ownerName, name, \
+                                                      fn),             \
+                               fn>::call));
+  FIXED64_ENTRY_POINTS(FIXED64_NODE_ENTRY_POINT)
+#undef FIXED64_NODE_ENTRY_POINT
+
+  // The recorder controls are not entry points, so they are never recorded
+  napi_value recorder = owner(env, exports, "Recorder");
+  ok = ok && define(env, recorder, "isEnabled", &NodeCall<&isRecordingEnabled>::call) &&
+       define(env, recorder, "start", &NodeCall<&Recorder::startWrapper>::call) &&
+       define(env, recorder, "stop", &NodeCall<&Recorder::stop>::call) &&
+       define(env, recorder, "isActive", &NodeCall<&Recorder::active>::call) &&
+       define(env, recorder, "recordCount", &NodeCall<&Recorder::recordCountWrapper>::call) &&
+       define(env, recorder, "droppedCount", &NodeCall<&Recorder::droppedCountWrapper>::call) &&
+       define(env, recorder, "logSize", &NodeCall<&Recorder::logSizeWrapper>::call) &&
+       define(env, recorder, "writeLog", &NodeCall<&Recorder::writeLogWrapper>::call);
+
+  ok = ok && define(env, exports, "_malloc", &NodeCall<&mallocWrapper>::call) &&
+       define(env, exports, "_free", &NodeCall<&freeWrapper>::call) &&
+       define(env, exports, "getSizeOfFixed64Param", &NodeCall<&getSizeOfFixed64Param>::call) &&
+       define(env, exports, "getFixed64ParamOffsets", &getFixed64ParamOffsets) &&
+       define(env, exports, "getFixedHeapSize", &NodeCall<&getFixedHeapSize>::call) &&
+       define(env, exports, "getInteropParamArrayAddress", &NodeCall<&interopParamArrayAddress>::call) &&
+       define(env, exports, "getInteropReturnArrayAddress", &NodeCall<&interopReturnArrayAddress>::call) &&
+       define(env, exports, "getInteropReturnUint32ArrayAddress", &NodeCall<&interopReturnUint32ArrayAddress>::call) &&
+       define(env, exports, "getInteropUint32ParamArrayAddress", &NodeCall<&interopUint32ParamArrayAddress>::call) &&
+       define(env, exports, "getInteropCharArrayAddress", &NodeCall<&interopCharArrayAddress>::call) &&
+       define(env, exports, "getStats", &getStats) &&
+       define(env, exports, "resetStats", &NodeCall<&resetStats>::call) &&
+       define(env, exports, "setStatsTiming", &NodeCall<&setStatsTiming>::call) &&
+       define(env, exports, "isInstrumented", &NodeCall<&isInstrumented>::call);
+  if (!ok) {
+    napi_throw_error(env, nullptr, "Fixed64Node failed to define its exports");
+    return nullptr;
+  }
+  return exports;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+// The memory behind the Node addon's _malloc/_free: a first-fit allocator
+// over a fixed region, working in offsets so that JS can use the results as
+// heap addresses. Blocks are 16-byte aligned and carry their size in a
+// 16-byte header; freed blocks are merged with free neighbours.
+//
+// JS allocates for the duration of one batch call (see Fixed64.esm.ts), so
+// the free list stays short and a linear search is enough.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+
+namespace Skynet {
+
+class NodeHeap {
+ public:
+  static constexpr size_t kAlignment = 16;
+
+  // `base` is where offsets are counted from, [begin, begin + size) the
+  // region handed out
+  NodeHeap(uint8_t *base, size_t begin, size_t size) : _base(base) {
+    size_t first = alignUp(begin);
+    if (begin + size > first + kAlignment) {
+      _free[first] = (begin + size - first) & ~(kAlignment - 1);
+    }
+  }
+
+  // Offset of the block, 0 when there is no room
+  size_t allocate(size_t size) {
+    size_t total = alignUp(size + kAlignment);
+    if (total < size) {
+      return 0;
+    }
+    for (auto it = _free.begin(); it != _free.end(); ++it) {
+      if (it->second < total) {
+        continue;
+      }
+      size_t block = it->first;
+      size_t rest = it->second - total;
+      _free.erase(it);
+      if (rest >= 2 * kAlignment) {
+        _free[block + total] = rest;
+      } else {
+        total += rest;
+      }
+      std::memcpy(_base + block, &total, sizeof(total));
+      return block + kAlignment;
+    }
+    return 0;
+  }
+
+  void release(size_t offset) {
+    if (offset < kAlignment) {
+      return;
+    }
+    size_t block = offset - kAlignment;
+    size_t size;
+    std::memcpy(&size, _base + block, sizeof(size));
+    auto next = _free.lower_bound(block);
+    if (next != _free.end() && block + size == next->first) {
+      size += next->second;
+      next = _free.erase(next);
+    }
+    if (next != _free.begin()) {
+      auto previous = std::prev(next);
+      if (previous->first + previous->second == block) {
+        previous->second += size;
+        return;
+      }
+    }
+    _free[block] = size;
+  }
+
+ private:
+  static size_t alignUp(size_t value) {
+    return (value + kAlignment - 1) & ~(kAlignment - 1);
+  }
+
+  uint8_t *_base;
+  // Free blocks, offset -> size in bytes including the header
+  std::map<size_t, size_t> _free;
+};
+
+}  // namespace Skynet
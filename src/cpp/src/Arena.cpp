@@ -0,0 +1,63 @@
+#include "Arena.h"
+
+#include <new>
+
+#include "SimContext.h"
+
+using namespace Skynet;
+
+namespace {
+
+// The block follows the Arena in the same allocation
+constexpr size_t kHeaderSize =
+    (sizeof(Arena) + Arena::kAlignment - 1) & ~(Arena::kAlignment - 1);
+
+Arena *arenaAt(uintptr_t address) { return reinterpret_cast<Arena *>(address); }
+
+}  // namespace
+
+Arena *Arena::create(size_t capacity) {
+  // kAlignment extra bytes absorb a misaligned allocation
+  if (capacity > SIZE_MAX - kHeaderSize - kAlignment) {
+    return nullptr;
+  }
+  void *memory = SimContext::allocate(kHeaderSize + capacity + kAlignment);
+  if (!memory) {
+    return nullptr;
+  }
+  uintptr_t block = reinterpret_cast<uintptr_t>(memory) + kHeaderSize;
+  block = (block + kAlignment - 1) & ~(kAlignment - 1);
+  return new (memory) Arena(reinterpret_cast<void *>(block), capacity);
+}
+
+void Arena::destroy(Arena *arena) {
+  if (arena) {
+    arena->~Arena();
+    SimContext::release(arena);
+  }
+}
+
+uintptr_t Arena::createWrapper(uint32_t capacity) {
+  return reinterpret_cast<uintptr_t>(create(capacity));
+}
+
+void Arena::destroyWrapper(uintptr_t arena) { destroy(arenaAt(arena)); }
+
+uintptr_t Arena::allocateWrapper(uintptr_t arena, uint32_t size) {
+  return arena ? reinterpret_cast<uintptr_t>(arenaAt(arena)->allocate(size))
+               : 0;
+}
+
+void Arena::resetWrapper(uintptr_t arena) {
+  if (arena) {
+    arenaAt(arena)->reset();
+  }
+}
+
+uint32_t Arena::usedWrapper(uintptr_t arena) {
+  return arena ? static_cast<uint32_t>(arenaAt(arena)->used()) : 0;
+}
+
+uint32_t Arena::capacityWrapper(uintptr_t arena) {
+  return arena ? static_cast<uint32_t>(arenaAt(arena)->capacity()) : 0;
+}
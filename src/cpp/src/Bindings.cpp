@@ -1,82 +1,142 @@
 // Bindings.cpp
 #include <emscripten/bind.h>
+#include <emscripten/val.h>
 
+#include "Arena.h"
+#include "EntityTable.h"
+#if !FIXED64_LEAN
+#include "Fixed64Format.h"
+#endif
+#include "JobPool.h"
 #include "Rect.h"
+#include "Recorder.h"
 #include "Sector.h"
+#include "SimContext.h"
+#include "Snapshot.h"
+#include "StateHash.h"
 #include "Vector3.h"
 
 using namespace emscripten;
 using namespace Skynet;
 
+// Binds the static entry points of EntryPoints.h on an embind class
+#define BIND_CLASS_ENTRY_POINT(owner, name, fn) \
+  binding.class_function(#name, FIXED64_ENTRY_FUNCTION(owner, name, fn));
+
+// Entry points called since the last resetStats(), as
+// [{name, calls, timeNs, cycles}]; always empty without instrumentation
+emscripten::val getStats() {
+  emscripten::val result = emscripten::val::array();
+  for (size_t i = 0; i < Instrumentation::kEntryPointCount; ++i) {
+    EntryPoint id = static_cast<EntryPoint>(i);
+    const EntryPointStats &stats = Instrumentation::stats(id);
+    if (stats.calls == 0) {
+      continue;
+    }
+    emscripten::val entry = emscripten::val::object();
+    entry.set("name", Instrumentation::name(id));
+    entry.set("calls", static_cast<double>(stats.calls));
+    entry.set("timeNs", static_cast<double>(stats.nanoseconds));
+    entry.set("cycles", static_cast<double>(stats.cycles));
+    result.call<void>("push", entry);
+  }
+  return result;
+}
+
+void resetStats() { Instrumentation::reset(); }
+
+void setStatsTiming(bool enabled) { Instrumentation::setTiming(enabled); }
+
+bool isInstrumented() { return Instrumentation::enabled(); }
+
+EMSCRIPTEN_BINDINGS(instrumentation_module) {
+  emscripten::function("getStats", &getStats);
+  emscripten::function("resetStats", &resetStats);
+  emscripten::function("setStatsTiming", &setStatsTiming);
+  emscripten::function("isInstrumented", &isInstrumented);
+}
+
+// The recorder controls are not entry points, so they are never recorded
+EMSCRIPTEN_BINDINGS(Recorder_module) {
+  class_<Recorder>("Recorder")
+      .class_function("isEnabled", &Recorder::enabled)
+      .class_function("start", &Recorder::startWrapper)
+      .class_function("stop", &Recorder::stop)
+      .class_function("isActive", &Recorder::active)
+      .class_function("recordCount", &Recorder::recordCountWrapper)
+      .class_function("droppedCount", &Recorder::droppedCountWrapper)
+      .class_function("logSize", &Recorder::logSizeWrapper)
+      .class_function("writeLog", &Recorder::writeLogWrapper);
+}
+
 EMSCRIPTEN_BINDINGS(vector2_bindings) {
-  emscripten::class_<Skynet::Vector2>("Vector2")
-      .constructor<>()
-      .constructor<float, float>()
-      .function("set", &Skynet::Vector2::setWrapper)
-      // Bind static functions
-      .class_function("add", &Skynet::Vector2::addWrapper)
-      .class_function("sub", &Skynet::Vector2::subWrapper)
-      .class_function("scalar", &Skynet::Vector2::scalar)
-      .class_function("normalize", &Skynet::Vector2::normalizeWrapper)
-      .class_function("len", &Skynet::Vector2::lenWrapper)
-      .class_function("dot", &Skynet::Vector2::dotWrapper)
-      // Bind non-static member functions
-      .function("toString", &Skynet::Vector2::toString)  // Corrected line
-      // Other bindings as necessary
-      ;
+  auto binding = emscripten::class_<Skynet::Vector2>("Vector2")
+                     .constructor<>()
+                     .constructor<float, float>()
+                     .function("set", &Skynet::Vector2::setWrapper);
+#if !FIXED64_LEAN
+  binding.function(
+      "toString",
+      select_overload<std::string(const Skynet::Vector2 &)>(&Skynet::toString));
+#endif
+  // Bind static functions
+  VECTOR2_ENTRY_POINTS(BIND_CLASS_ENTRY_POINT)
 
   emscripten::register_vector<Skynet::Vector2>("Vector2List");
 
   // Bind standalone functions
-  emscripten::function("abs", &Skynet::absWrapper);
-  emscripten::function("absSq", &Skynet::absSqWrapper);
-  emscripten::function("det", &Skynet::detWrapper);
-  emscripten::function("normalize", &Skynet::normalizeWrapper);
+#define BIND_FUNCTION_ENTRY_POINT(owner, name, fn) \
+  emscripten::function(#name, FIXED64_ENTRY_FUNCTION(owner, name, fn));
+  MODULE_ENTRY_POINTS(BIND_FUNCTION_ENTRY_POINT)
+#undef BIND_FUNCTION_ENTRY_POINT
 }
 
 EMSCRIPTEN_BINDINGS(vector3_module) {
   register_vector<double>("doubleVector");
 
-  class_<Vector3>("Vector3")
-      .constructor<>()
-      .function("set", &Vector3::set)
-      .function("copy", &Vector3::copy)
-      .class_function("cross", &Vector3::cross)
-      .class_function("dot", &Vector3::dotWrapper)
-      .class_function("add", &Vector3::add)
-      .class_function("sub", &Vector3::sub)
-      .class_function("mul", &Vector3::mul)
-      .class_function("div", &Vector3::div)
-      .class_function("scalar", &Vector3::scalar)
-      .class_function("normalize", &Vector3::normalizeWrapper)
-      .class_function("normalizedDirection", &Vector3::normalizedDirection)
-      .class_function("negative", &Vector3::negative)
-      .class_function("distance", &Vector3::distance)
-      .class_function("squaredDistance", &Vector3::squaredDistanceWrapper)
-      .class_function("rotateX", &Vector3::rotateXWrapper)
-      .class_function("rotateY", &Vector3::rotateYWrapper)
-      .class_function("rotateZ", &Vector3::rotateZWrapper)
-      .class_function("lerp", &Vector3::lerp)
-      .class_function("lengthSqr", &Vector3::lengthSqrWrapper)
-      .class_function("len", &Vector3::len)
-      .class_function("isCircleOverlaps", &Vector3::isCircleOverlaps)
-      .class_function("isLineCircleIntersect", &Vector3::isLineCircleIntersect)
-      .class_function("decayKnockbackVector",
-                      &Vector3::decayKnockbackVectorWrapper)
-      .class_function("velocityToForward", &Vector3::velocityToForward)
-      .class_function("moveForward", &Vector3::moveForwardWrapper)
-      .class_function("emptyCall", &Vector3::emptyCall);
+  auto binding = class_<Vector3>("Vector3")
+                     .constructor<>()
+                     .function("set", &Vector3::set)
+                     .function("copy", &Vector3::copy);
+  VECTOR3_ENTRY_POINTS(BIND_CLASS_ENTRY_POINT)
 }
 
 EMSCRIPTEN_BINDINGS(Rect_module) {
-  class_<Rect>("Rect")
-      .constructor<>()
-      .class_function("overlapsWithCircle", &Rect::overlapsWithCircle)
-      .class_function("overlapsWithRect", &Rect::overlapsWithRect)
-      .class_function("containsPoint", &Rect::containsPoint);
+  auto binding = class_<Rect>("Rect").constructor<>();
+  RECT_ENTRY_POINTS(BIND_CLASS_ENTRY_POINT)
 }
 
 EMSCRIPTEN_BINDINGS(Sector_module) {
-  class_<Sector>("Sector").constructor<>().class_function(
-      "overlapsWithCircle", &Sector::overlapsWithCircle);
+  auto binding = class_<Sector>("Sector").constructor<>();
+  SECTOR_ENTRY_POINTS(BIND_CLASS_ENTRY_POINT)
+}
+
+EMSCRIPTEN_BINDINGS(StateHash_module) {
+  auto binding = class_<StateHash>("StateHash");
+  STATE_HASH_ENTRY_POINTS(BIND_CLASS_ENTRY_POINT)
+}
+
+EMSCRIPTEN_BINDINGS(Snapshot_module) {
+  auto binding = class_<Snapshot>("Snapshot");
+  SNAPSHOT_ENTRY_POINTS(BIND_CLASS_ENTRY_POINT)
+}
+
+EMSCRIPTEN_BINDINGS(JobPool_module) {
+  auto binding = class_<JobPool>("JobPool");
+  JOB_POOL_ENTRY_POINTS(BIND_CLASS_ENTRY_POINT)
+}
+
+EMSCRIPTEN_BINDINGS(SimContext_module) {
+  auto binding = class_<SimContext>("SimContext");
+  SIM_CONTEXT_ENTRY_POINTS(BIND_CLASS_ENTRY_POINT)
+}
+
+EMSCRIPTEN_BINDINGS(Arena_module) {
+  auto binding = class_<Arena>("Arena");
+  ARENA_ENTRY_POINTS(BIND_CLASS_ENTRY_POINT)
+}
+
+EMSCRIPTEN_BINDINGS(EntityTable_module) {
+  auto binding = class_<EntityTable>("EntityTable");
+  ENTITY_TABLE_ENTRY_POINTS(BIND_CLASS_ENTRY_POINT)
 }
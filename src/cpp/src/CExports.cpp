@@ -0,0 +1,61 @@
+// CExports.cpp
+#include "CExports.h"
+
+#if FIXED64_C_EXPORTS
+
+#include <emscripten.h>
+
+#include <iterator>
+
+#include "Arena.h"
+#include "EntityTable.h"
+#include "Fixed64Native.h"
+#include "JobPool.h"
+#include "Recorder.h"
+#include "Rect.h"
+#include "Sector.h"
+#include "SimContext.h"
+#include "Snapshot.h"
+#include "StateHash.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+using namespace Skynet;
+
+namespace {
+
+template <auto Function>
+uintptr_t exportIndex() {
+  if constexpr (CExportable<Function>::value) {
+    // A wasm function pointer is its index in the function table
+    return reinterpret_cast<uintptr_t>(Function);
+  } else {
+    return 0;
+  }
+}
+
+const uintptr_t kExportTable[] = {
+#define FIXED64_C_EXPORT(owner, name, fn) \
+  kPlaceholderEntryPoint<fn>              \
+      ? 0                                 \
+      : exportIndex<FIXED64_ENTRY_FUNCTION(owner, name, fn)>(),
+    FIXED64_ENTRY_POINTS(FIXED64_C_EXPORT)
+#undef FIXED64_C_EXPORT
+};
+
+static_assert(std::size(kExportTable) == Instrumentation::kEntryPointCount);
+
+}  // namespace
+
+extern "C" {
+
+EMSCRIPTEN_KEEPALIVE const uintptr_t *fixed64_export_table() {
+  return kExportTable;
+}
+
+EMSCRIPTEN_KEEPALIVE uint32_t fixed64_export_count() {
+  return static_cast<uint32_t>(std::size(kExportTable));
+}
+}
+
+#endif
@@ -0,0 +1,264 @@
+#include "EntityTable.h"
+
+#include <new>
+
+#include "Fixed64Native.h"
+#include "JobPool.h"
+#include "Rect.h"
+#include "Sector.h"
+#include "SimContext.h"
+#include "Vector2.h"
+#include "Vector3.h"
+
+using namespace Skynet;
+
+namespace {
+
+// The id arrays follow the EntityTable in the same allocation
+constexpr size_t kHeaderSize =
+    (sizeof(EntityTable) + alignof(uint32_t) - 1) & ~(alignof(uint32_t) - 1);
+
+EntityTable *tableAt(uintptr_t address) {
+  return reinterpret_cast<EntityTable *>(address);
+}
+
+uintptr_t addressOf(const void *pointer) {
+  return reinterpret_cast<uintptr_t>(pointer);
+}
+
+// Circle queries need two or three position components and one radius
+bool isCircleColumns(const EntityTable &table, uint32_t position,
+                     uint32_t radius) {
+  uint32_t components = table.components(position);
+  return (components == 2 || components == 3) &&
+         table.components(radius) == 1;
+}
+
+}  // namespace
+
+EntityTable *EntityTable::create(uint32_t capacity) {
+  if (capacity == kNone ||
+      capacity > (SIZE_MAX - kHeaderSize) / (3 * sizeof(uint32_t))) {
+    return nullptr;
+  }
+  void *memory =
+      SimContext::allocate(kHeaderSize + 3 * sizeof(uint32_t) * capacity);
+  if (!memory) {
+    return nullptr;
+  }
+  uint32_t *ids = reinterpret_cast<uint32_t *>(
+      static_cast<uint8_t *>(memory) + kHeaderSize);
+  return new (memory)
+      EntityTable(capacity, ids, ids + capacity, ids + 2 * capacity);
+}
+
+void EntityTable::destroy(EntityTable *table) {
+  if (table) {
+    // The components of a column share the block of the first one
+    for (uint32_t column = 0; column < table->_columnCount; ++column) {
+      SimContext::release(table->_data[column][0]);
+    }
+    table->~EntityTable();
+    SimContext::release(table);
+  }
+}
+
+int32_t EntityTable::addColumn(uint32_t components) {
+  if (_columnCount == kMaxColumns || components == 0 ||
+      components > kMaxComponents ||
+      _capacity > SIZE_MAX / (kMaxComponents * sizeof(int64_t))) {
+    return -1;
+  }
+  size_t count = _capacity ? _capacity : 1;
+  int64_t *block = static_cast<int64_t *>(
+      SimContext::allocate(components * count * sizeof(int64_t)));
+  if (!block) {
+    return -1;
+  }
+  uint32_t column = _columnCount++;
+  _components[column] = components;
+  for (uint32_t c = 0; c < components; ++c) {
+    _data[column][c] = block + c * count;
+    for (uint32_t row = 0; row < _size; ++row) {
+      _data[column][c][row] = 0;
+    }
+  }
+  return static_cast<int32_t>(column);
+}
+
+uintptr_t EntityTable::createWrapper(uint32_t capacity) {
+  return addressOf(create(capacity));
+}
+
+void EntityTable::destroyWrapper(uintptr_t table) { destroy(tableAt(table)); }
+
+int32_t EntityTable::addColumnWrapper(uintptr_t table, uint32_t components) {
+  return table ? tableAt(table)->addColumn(components) : -1;
+}
+
+uint32_t EntityTable::spawnWrapper(uintptr_t table) {
+  return table ? tableAt(table)->spawn() : kNone;
+}
+
+bool EntityTable::despawnWrapper(uintptr_t table, uint32_t id) {
+  return table && tableAt(table)->despawn(id);
+}
+
+uint32_t EntityTable::rowOfWrapper(uintptr_t table, uint32_t id) {
+  return table ? tableAt(table)->rowOf(id) : kNone;
+}
+
+uint32_t EntityTable::sizeWrapper(uintptr_t table) {
+  return table ? tableAt(table)->size() : 0;
+}
+
+uint32_t EntityTable::capacityWrapper(uintptr_t table) {
+  return table ? tableAt(table)->capacity() : 0;
+}
+
+uintptr_t EntityTable::idsWrapper(uintptr_t table) {
+  return table ? addressOf(tableAt(table)->ids()) : 0;
+}
+
+uintptr_t EntityTable::columnWrapper(uintptr_t table, uint32_t column,
+                                     uint32_t component) {
+  return table ? addressOf(tableAt(table)->component(column, component)) : 0;
+}
+
+uint32_t EntityTable::componentsWrapper(uintptr_t table, uint32_t column) {
+  return table ? tableAt(table)->components(column) : 0;
+}
+
+bool EntityTable::set(uintptr_t table, uint32_t column, uint32_t id) {
+  if (!table) {
+    return false;
+  }
+  EntityTable &entities = *tableAt(table);
+  uint32_t row = entities.rowOf(id);
+  if (row == kNone || column >= entities._columnCount) {
+    return false;
+  }
+  auto &params = getInteropParamArray();
+  for (uint32_t c = 0; c < entities._components[column]; ++c) {
+    entities._data[column][c][row] = Fixed64(params[c]).value;
+  }
+  return true;
+}
+
+bool EntityTable::get(uintptr_t table, uint32_t column, uint32_t id) {
+  if (!table) {
+    return false;
+  }
+  const EntityTable &entities = *tableAt(table);
+  uint32_t row = entities.rowOf(id);
+  if (row == kNone || column >= entities._columnCount) {
+    return false;
+  }
+  auto &returnArray = getInteropReturnArray();
+  for (uint32_t c = 0; c < entities._components[column]; ++c) {
+    returnArray[c] =
+        static_cast<Fixed64Param>(Fixed64(entities._data[column][c][row]));
+  }
+  return true;
+}
+
+bool EntityTable::normalize(uintptr_t table, uint32_t column) {
+  if (!table) {
+    return false;
+  }
+  const EntityTable &entities = *tableAt(table);
+  switch (entities.components(column)) {
+    case 2:
+      Vector2::normalizeMany(addressOf(entities.component(column, 0)),
+                             addressOf(entities.component(column, 1)),
+                             entities._size);
+      return true;
+    case 3:
+      Vector3::normalizeMany(addressOf(entities.component(column, 0)),
+                             addressOf(entities.component(column, 1)),
+                             addressOf(entities.component(column, 2)),
+                             entities._size);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool EntityTable::integrate(uintptr_t table, uint32_t position,
+                            uint32_t velocity) {
+  if (!table) {
+    return false;
+  }
+  const EntityTable &entities = *tableAt(table);
+  uint32_t components = entities.components(position);
+  if (components == 0 || entities.components(velocity) != components) {
+    return false;
+  }
+  Fixed64 deltaTime(getInteropParamArray()[0]);
+  for (uint32_t c = 0; c < components; ++c) {
+    int64_t *p = entities._data[position][c];
+    const int64_t *v = entities._data[velocity][c];
+    JobPool::parallelFor(
+        entities._size, JobPool::kBatchGrain,
+        [&](uint32_t begin, uint32_t end) {
+          for (uint32_t i = begin; i < end; ++i) {
+            p[i] = (Fixed64(p[i]) + Fixed64(v[i]) * deltaTime).value;
+          }
+        });
+  }
+  return true;
+}
+
+bool EntityTable::atan2(uintptr_t table, uint32_t vector, uint32_t out) {
+  if (!table) {
+    return false;
+  }
+  const EntityTable &entities = *tableAt(table);
+  if (entities.components(vector) != 2 || entities.components(out) != 1) {
+    return false;
+  }
+  Fixed64Native::atan2Many(addressOf(entities.component(vector, 1)),
+                           addressOf(entities.component(vector, 0)),
+                           addressOf(entities.component(out, 0)),
+                           entities._size);
+  return true;
+}
+
+void EntityTable::hash(uintptr_t table) {
+  if (!table) {
+    return;
+  }
+  const EntityTable &entities = *tableAt(table);
+  StateHash &stateHash = SimContext::current().stateHash;
+  for (uint32_t column = 0; column < entities._columnCount; ++column) {
+    for (uint32_t c = 0; c < entities._components[column]; ++c) {
+      stateHash.updateRaw(entities._data[column][c], entities._size);
+    }
+  }
+}
+
+bool EntityTable::queryRect(uintptr_t table, uint32_t position,
+                            uint32_t radius) {
+  if (!table || !isCircleColumns(*tableAt(table), position, radius)) {
+    SimContext::current().tickArena.writeView<uint32_t>(nullptr, 0);
+    return false;
+  }
+  const EntityTable &entities = *tableAt(table);
+  return Rect::queryCircleColumns(
+      entities.component(position, 0), entities.component(position, 1),
+      entities.component(position, 2), entities.component(radius, 0),
+      entities._size);
+}
+
+bool EntityTable::querySector(uintptr_t table, uint32_t position,
+                              uint32_t radius) {
+  if (!table || !isCircleColumns(*tableAt(table), position, radius)) {
+    SimContext::current().tickArena.writeView<uint32_t>(nullptr, 0);
+    return false;
+  }
+  const EntityTable &entities = *tableAt(table);
+  return Sector::queryCircleColumns(
+      entities.component(position, 0), entities.component(position, 1),
+      entities.component(position, 2), entities.component(radius, 0),
+      entities._size);
+}
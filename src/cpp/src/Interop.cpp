@@ -1,7 +0,0 @@
-#include "Interop.h"
-
-namespace Skynet {
-InteropParamArray interopParamArray;
-InteropReturnArray interopReturnArray;
-InteropUint32ParamArray interopUint32ParamArray;
-}  // namespace Skynet
\ No newline at end of file
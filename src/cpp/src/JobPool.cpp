@@ -0,0 +1,258 @@
+#include "JobPool.h"
+
+#if FIXED64_THREADS
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Skynet;
+
+namespace {
+
+// Set on workers and on a caller inside run(), so that a body calling
+// parallelFor again runs inline instead of waiting for itself
+thread_local bool insideJob = false;
+
+// Chunks [next, end) of one participant that are not claimed yet, packed into
+// one word so that claiming the front and stealing the back are single CASes
+struct alignas(64) ChunkRange {
+  std::atomic<uint64_t> chunks{0};
+};
+
+constexpr uint64_t pack(uint32_t next, uint32_t end) {
+  return static_cast<uint64_t>(end) << 32 | next;
+}
+
+class Pool {
+ public:
+  ~Pool() { stopWorkers(); }
+
+  void setWorkerCount(uint32_t count) {
+    std::lock_guard<std::mutex> runLock(_runMutex);
+    startWorkers(std::min(count, JobPool::kMaxWorkers));
+  }
+
+  uint32_t workerCount() {
+    std::lock_guard<std::mutex> runLock(_runMutex);
+    return static_cast<uint32_t>(_workers.size());
+  }
+
+  void run(uint32_t count, uint32_t grain, JobPool::Job job, void *context) {
+    grain = std::max(grain, 1u);
+    uint32_t chunkCount = count / grain + (count % grain != 0);
+    if (chunkCount < 2 || insideJob) {
+      if (count > 0) {
+        job(context, 0, count);
+      }
+      return;
+    }
+
+    std::lock_guard<std::mutex> runLock(_runMutex);
+    if (!_configured) {
+      startWorkers(defaultWorkerCount());
+    }
+    if (_workers.empty()) {
+      insideJob = true;
+      job(context, 0, count);
+      insideJob = false;
+      return;
+    }
+
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      // Workers of the previous run may still be looking for chunks to steal
+      _idle.wait(lock, [this] { return _busy == 0; });
+      _job = job;
+      _context = context;
+      _count = count;
+      _grain = grain;
+      _participants = static_cast<uint32_t>(_workers.size()) + 1;
+      _remaining.store(chunkCount, std::memory_order_relaxed);
+      for (uint32_t slot = 0; slot < _participants; ++slot) {
+        uint64_t first = uint64_t{chunkCount} * slot / _participants;
+        uint64_t last = uint64_t{chunkCount} * (slot + 1) / _participants;
+        _ranges[slot].chunks.store(pack(static_cast<uint32_t>(first),
+                                        static_cast<uint32_t>(last)),
+                                   std::memory_order_relaxed);
+      }
+      ++_generation;
+    }
+    _wake.notify_all();
+
+    insideJob = true;
+    work(0);
+    insideJob = false;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this] {
+      return _remaining.load(std::memory_order_acquire) == 0;
+    });
+  }
+
+ private:
+  // FIXED64_THREAD_POOL_SIZE, but no more than one worker per other core
+  static uint32_t defaultWorkerCount() {
+    uint32_t count = std::min<uint32_t>(FIXED64_THREAD_POOL_SIZE,
+                                        JobPool::kMaxWorkers);
+    uint32_t cores = std::thread::hardware_concurrency();
+    return cores > 0 ? std::min(count, cores - 1) : count;
+  }
+
+  // Caller holds _runMutex
+  void startWorkers(uint32_t count) {
+    stopWorkers();
+    _configured = true;
+    for (uint32_t slot = 1; slot <= count; ++slot) {
+      _workers.emplace_back([this, slot, seen = _generation] {
+        workerLoop(slot, seen);
+      });
+    }
+  }
+
+  void stopWorkers() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stop = true;
+    }
+    _wake.notify_all();
+    for (std::thread &worker : _workers) {
+      worker.join();
+    }
+    _workers.clear();
+    _stop = false;
+  }
+
+  void workerLoop(uint32_t slot, uint64_t seen) {
+    insideJob = true;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+      _wake.wait(lock, [&] { return _stop || _generation != seen; });
+      if (_stop) {
+        return;
+      }
+      seen = _generation;
+      ++_busy;
+      lock.unlock();
+      work(slot);
+      lock.lock();
+      if (--_busy == 0) {
+        _idle.notify_all();
+      }
+    }
+  }
+
+  void work(uint32_t slot) {
+    do {
+      uint32_t chunk;
+      while (claim(slot, chunk)) {
+        uint32_t begin = chunk * _grain;
+        uint32_t end = std::min(_count - begin, _grain) + begin;
+        _job(_context, begin, end);
+        if (_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _idle.notify_all();
+        }
+      }
+    } while (steal(slot));
+  }
+
+  bool claim(uint32_t slot, uint32_t &chunk) {
+    std::atomic<uint64_t> &chunks = _ranges[slot].chunks;
+    uint64_t range = chunks.load(std::memory_order_acquire);
+    while (true) {
+      uint32_t next = static_cast<uint32_t>(range);
+      uint32_t end = static_cast<uint32_t>(range >> 32);
+      if (next >= end) {
+        return false;
+      }
+      if (chunks.compare_exchange_weak(range, pack(next + 1, end),
+                                       std::memory_order_acq_rel)) {
+        chunk = next;
+        return true;
+      }
+    }
+  }
+
+  // Moves the back half of the first non-empty share into `slot`'s, which is
+  // empty. A range value describes its share completely, so a CAS against a
+  // stale but equal value still takes chunks that are unclaimed.
+  bool steal(uint32_t slot) {
+    for (uint32_t i = 1; i < _participants; ++i) {
+      std::atomic<uint64_t> &victim =
+          _ranges[(slot + i) % _participants].chunks;
+      uint64_t range = victim.load(std::memory_order_acquire);
+      while (true) {
+        uint32_t next = static_cast<uint32_t>(range);
+        uint32_t end = static_cast<uint32_t>(range >> 32);
+        if (next >= end) {
+          break;
+        }
+        uint32_t middle = end - (end - next + 1) / 2;
+        if (victim.compare_exchange_weak(range, pack(next, middle),
+                                         std::memory_order_acq_rel)) {
+          _ranges[slot].chunks.store(pack(middle, end),
+                                     std::memory_order_release);
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Serializes run() and resizing
+  std::mutex _runMutex;
+  std::vector<std::thread> _workers;
+  bool _configured = false;
+
+  // Guards the fields below up to _busy; workers read the job after waking
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::condition_variable _idle;
+  uint64_t _generation = 0;
+  bool _stop = false;
+  uint32_t _busy = 0;
+  JobPool::Job _job = nullptr;
+  void *_context = nullptr;
+  uint32_t _count = 0;
+  uint32_t _grain = 1;
+  uint32_t _participants = 1;
+
+  std::atomic<uint32_t> _remaining{0};
+  // Slot 0 is the caller of run(), slot i worker i
+  ChunkRange _ranges[JobPool::kMaxWorkers + 1];
+};
+
+Pool &pool() {
+  static Pool instance;
+  return instance;
+}
+
+}  // namespace
+
+void JobPool::run(uint32_t count, uint32_t grain, Job job, void *context) {
+  pool().run(count, grain, job, context);
+}
+
+void JobPool::setWorkerCount(uint32_t count) { pool().setWorkerCount(count); }
+
+uint32_t JobPool::workerCount() { return pool().workerCount(); }
+
+#else
+
+using namespace Skynet;
+
+void JobPool::run(uint32_t count, uint32_t, Job job, void *context) {
+  if (count > 0) {
+    job(context, 0, count);
+  }
+}
+
+void JobPool::setWorkerCount(uint32_t) {}
+
+uint32_t JobPool::workerCount() { return 0; }
+
+#endif
@@ -0,0 +1,95 @@
+#include "Recorder.h"
+
+#include <algorithm>
+
+namespace Skynet {
+
+void Recorder::start(size_t capacity) {
+  // dropOldest() reads a whole size prefix from the ring
+  _ring.assign(std::max(capacity, kMinCapacity), 0);
+  _head = 0;
+  _used = 0;
+  _records = 0;
+  _dropped = 0;
+  _active = true;
+}
+
+void Recorder::commitRecord() {
+  // The size prefix goes into the headroom in front of the record, so the
+  // ring receives a single copy
+  size_t sizeLength = 1;
+  for (size_t size = _scratch.size(); size >= 0x80; size >>= 7) {
+    ++sizeLength;
+  }
+  size_t total = sizeLength + _scratch.size();
+  if (_scratch.overflow() || total > _ring.size()) {
+    ++_dropped;
+    return;
+  }
+  uint8_t *record = _scratchData + Snapshot::kMaxVarintSize - sizeLength;
+  Snapshot::writeVarint(_scratch.size(), record);
+  while (_ring.size() - _used < total) {
+    dropOldest();
+  }
+  ringWrite(wrap(_head + _used), record, total);
+  _used += total;
+  ++_records;
+}
+
+size_t Recorder::writeLog(uint8_t *out, size_t capacity) {
+  if (capacity < logSize()) {
+    return 0;
+  }
+  size_t offset = 0;
+  for (uint8_t byte : kMagic) {
+    out[offset++] = byte;
+  }
+  out[offset++] = kVersion;
+  out[offset++] = FIXED64_MATH_VERSION;
+  uint64_t digest = entryTableDigest();
+  for (int i = 0; i < 8; ++i) {
+    out[offset++] = static_cast<uint8_t>(digest >> (8 * i));
+  }
+  for (int i = 0; i < 8; ++i) {
+    out[offset++] = static_cast<uint8_t>(_dropped >> (8 * i));
+  }
+  if (_used > 0) {
+    ringRead(_head, out + offset, _used);
+  }
+  return offset + _used;
+}
+
+void Recorder::ringWrite(size_t offset, const uint8_t *data, size_t size) {
+  size_t first = std::min(size, _ring.size() - offset);
+  std::memcpy(_ring.data() + offset, data, first);
+  if (first < size) {
+    std::memcpy(_ring.data(), data + first, size - first);
+  }
+}
+
+void Recorder::ringRead(size_t offset, uint8_t *out, size_t size) {
+  size_t first = std::min(size, _ring.size() - offset);
+  std::memcpy(out, _ring.data() + offset, first);
+  std::memcpy(out + first, _ring.data(), size - first);
+}
+
+void Recorder::dropOldest() {
+  uint64_t recordSize;
+  size_t sizeLength;
+  if (_ring.size() - _head >= Snapshot::kMaxVarintSize) {
+    sizeLength = Snapshot::readVarint(_ring.data() + _head,
+                                      Snapshot::kMaxVarintSize, recordSize);
+  } else {
+    // The size prefix wraps around the end of the ring
+    uint8_t size[Snapshot::kMaxVarintSize];
+    ringRead(_head, size, sizeof(size));
+    sizeLength = Snapshot::readVarint(size, sizeof(size), recordSize);
+  }
+  size_t total = sizeLength + recordSize;
+  _head = wrap(_head + total);
+  _used -= total;
+  --_records;
+  ++_dropped;
+}
+
+}  // namespace Skynet
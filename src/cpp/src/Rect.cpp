@@ -1,8 +1,48 @@
 #include "Rect.h"
 
-EBattleWorldType WorldType = EBattleWorldType::TwoDimensional;
-
 bool Rect::overlapsWithCircle(bool returnDistSquared) {
+  return withWorldPlane([&]<Plane P>() {
+    return overlapsWithCircleOnPlane<P>(returnDistSquared);
+  });
+}
+
+bool Rect::overlapsWithRect() {
+  return withWorldPlane([]<Plane P>() { return overlapsWithRectOnPlane<P>(); });
+}
+
+bool Rect::containsPoint() {
+  return withWorldPlane([]<Plane P>() { return containsPointOnPlane<P>(); });
+}
+
+bool Rect::queryCircles(uintptr_t xs, uintptr_t ys, uintptr_t zs,
+                        uintptr_t radii, uint32_t count) {
+  return queryCircleColumns(reinterpret_cast<const int64_t *>(xs),
+                            reinterpret_cast<const int64_t *>(ys),
+                            reinterpret_cast<const int64_t *>(zs),
+                            reinterpret_cast<const int64_t *>(radii), count);
+}
+
+bool Rect::queryCircleColumns(const int64_t *x, const int64_t *y,
+                              const int64_t *z, const int64_t *r,
+                              uint32_t count) {
+  Vector3 rectCenter = getInteropVector3Param(0);
+  Fixed64 rectHalfWidth(getInteropParamArray()[3]);
+  Fixed64 rectHeight(getInteropParamArray()[4]);
+  Vector3 rectForward = getInteropVector3Param(5);
+  return withWorldPlane([&]<Plane P>() {
+    Rect rect = Rect::onPlane<P>(rectCenter, rectHalfWidth * 2, rectHeight,
+                                 rectForward);
+    return SimContext::current().tickArena.writeIndices(
+        count, [&](uint32_t i) {
+          Vector3 center(Fixed64(x[i]), Fixed64(y[i]),
+                         z ? Fixed64(z[i]) : Fixed64());
+          return rect.overlapsWithCircle<P>(center, Fixed64(r[i]));
+        });
+  });
+}
+
+template <Plane P>
+bool Rect::overlapsWithCircleOnPlane(bool returnDistSquared) {
   Vector3 rectCenter = getInteropVector3Param(0);
   Fixed64 rectHalfWidth(getInteropParamArray()[3]);
   Fixed64 rectHeight(getInteropParamArray()[4]);
@@ -10,8 +50,9 @@ bool Rect::overlapsWithCircle(bool returnDistSquared) {
   Vector3 circleCenter = getInteropVector3Param(8);
   Fixed64 circleRadius(getInteropParamArray()[11]);
 
-  Rect rect(rectCenter, rectHalfWidth * 2, rectHeight, rectForward);
-  bool ret = rect.overlapsWithCircle(circleCenter, circleRadius);
+  Rect rect = Rect::onPlane<P>(rectCenter, rectHalfWidth * 2, rectHeight,
+                               rectForward);
+  bool ret = rect.overlapsWithCircle<P>(circleCenter, circleRadius);
   if (returnDistSquared) {
     getInteropReturnArray()[0] = static_cast<Skynet::Fixed64Param>(
         (circleCenter - rectCenter).lengthSqr());
@@ -20,7 +61,8 @@ bool Rect::overlapsWithCircle(bool returnDistSquared) {
   return ret;
 }
 
-bool Rect::overlapsWithRect() {
+template <Plane P>
+bool Rect::overlapsWithRectOnPlane() {
   Vector3 rectCenter = getInteropVector3Param(0);
   Fixed64 rectHalfWidth(getInteropParamArray()[3]);
   Fixed64 rectHeight(getInteropParamArray()[4]);
@@ -29,21 +71,31 @@ bool Rect::overlapsWithRect() {
   Fixed64 otherRectHalfWidth(getInteropParamArray()[11]);
   Fixed64 otherRectHeight(getInteropParamArray()[12]);
   Vector3 otherRectForward = getInteropVector3Param(13);
-  Rect rect(rectCenter, rectHalfWidth * 2, rectHeight, rectForward);
-  Rect otherRect(otherRectCenter, otherRectHalfWidth * 2, otherRectHeight,
-                 otherRectForward);
+  Rect rect = Rect::onPlane<P>(rectCenter, rectHalfWidth * 2, rectHeight,
+                               rectForward);
+  Rect otherRect = Rect::onPlane<P>(otherRectCenter, otherRectHalfWidth * 2,
+                                    otherRectHeight, otherRectForward);
 
   return rect.overlapsWithRect(otherRect);
 }
 
-bool Rect::containsPoint() {
+template <Plane P>
+bool Rect::containsPointOnPlane() {
   Vector3 rectCenter = getInteropVector3Param(0);
   Fixed64 rectHalfWidth(getInteropParamArray()[3]);
   Fixed64 rectHeight(getInteropParamArray()[4]);
   Vector3 rectForward = getInteropVector3Param(5);
   Vector3 point = getInteropVector3Param(8);
 
-  Rect rect(rectCenter, rectHalfWidth * 2, rectHeight, rectForward);
+  Rect rect = Rect::onPlane<P>(rectCenter, rectHalfWidth * 2, rectHeight,
+                               rectForward);
+
+  return rect.containsPoint<P>(point);
+}
 
-  return rect.containsPoint(point);
-}
\ No newline at end of file
+template bool Rect::overlapsWithCircleOnPlane<Plane::XY>(bool);
+template bool Rect::overlapsWithCircleOnPlane<Plane::XZ>(bool);
+template bool Rect::overlapsWithRectOnPlane<Plane::XY>();
+template bool Rect::overlapsWithRectOnPlane<Plane::XZ>();
+template bool Rect::containsPointOnPlane<Plane::XY>();
+template bool Rect::containsPointOnPlane<Plane::XZ>();
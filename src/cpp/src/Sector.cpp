@@ -1,5 +1,7 @@
 #include "Sector.h"
 
+#include "SimContext.h"
+
 using namespace Skynet;
 
 bool Sector::overlapsWithCircle() {
@@ -15,4 +17,26 @@ bool Sector::overlapsWithCircle() {
   Fixed64 circleRadius(getInteropParamArray()[11]);
 
   return sector.overlapsWithCircle(circleCenter, circleRadius);
-}
\ No newline at end of file
+}
+
+bool Sector::queryCircles(uintptr_t xs, uintptr_t ys, uintptr_t zs,
+                          uintptr_t radii, uint32_t count) {
+  return queryCircleColumns(reinterpret_cast<const int64_t *>(xs),
+                            reinterpret_cast<const int64_t *>(ys),
+                            reinterpret_cast<const int64_t *>(zs),
+                            reinterpret_cast<const int64_t *>(radii), count);
+}
+
+bool Sector::queryCircleColumns(const int64_t *x, const int64_t *y,
+                                const int64_t *z, const int64_t *r,
+                                uint32_t count) {
+  Sector sector;
+  sector.init(getInteropVector3Param(0), getInteropVector3Param(3),
+              Fixed64(getInteropParamArray()[6]),
+              Fixed64(getInteropParamArray()[7]));
+  return SimContext::current().tickArena.writeIndices(count, [&](uint32_t i) {
+    Vector3 center(Fixed64(x[i]), Fixed64(y[i]),
+                   z ? Fixed64(z[i]) : Fixed64());
+    return sector.overlapsWithCircle(center, Fixed64(r[i]));
+  });
+}
@@ -0,0 +1,99 @@
+#include "SimContext.h"
+
+#include <cstdlib>
+#include <new>
+
+using namespace Skynet;
+
+namespace {
+
+// The default context until SimContext::setDefault() replaces it
+SimContext builtInContext;
+
+SimContext::Allocate allocateMemory = &std::malloc;
+SimContext::Release releaseMemory = &std::free;
+
+}  // namespace
+
+namespace Skynet {
+constinit thread_local InteropArrays *boundInteropArrays =
+    &builtInContext.interop;
+}  // namespace Skynet
+
+SimContext *SimContext::_default = &builtInContext;
+constinit thread_local SimContext *SimContext::_current = &builtInContext;
+
+void SimContext::setAllocator(Allocate allocate, Release release) {
+  allocateMemory = allocate;
+  releaseMemory = release;
+}
+
+void *SimContext::allocate(size_t size) { return allocateMemory(size); }
+
+void SimContext::release(void *memory) { releaseMemory(memory); }
+
+SimContext *SimContext::create() {
+  void *memory = allocateMemory(sizeof(SimContext));
+  return memory ? new (memory) SimContext() : nullptr;
+}
+
+void SimContext::destroy(SimContext *context) {
+  if (!context || context == _default || context == &builtInContext) {
+    return;
+  }
+  if (context == _current) {
+    bind(nullptr);
+  }
+  context->~SimContext();
+  releaseMemory(context);
+}
+
+uintptr_t SimContext::createWrapper() {
+  return reinterpret_cast<uintptr_t>(create());
+}
+
+void SimContext::destroyWrapper(uintptr_t context) {
+  destroy(reinterpret_cast<SimContext *>(context));
+}
+
+void SimContext::bindWrapper(uintptr_t context) {
+  bind(reinterpret_cast<SimContext *>(context));
+}
+
+uintptr_t SimContext::currentWrapper() {
+  return reinterpret_cast<uintptr_t>(&current());
+}
+
+// Anything but ThreeDimensional selects TwoDimensional
+void SimContext::setWorldType(uint32_t type) {
+  current().worldType =
+      type == ThreeDimensional ? ThreeDimensional : TwoDimensional;
+}
+
+uint32_t SimContext::worldTypeWrapper() { return current().worldType; }
+
+bool SimContext::reserveTickArena(uint32_t capacity) {
+  return current().tickArena.reserve(capacity);
+}
+
+void SimContext::beginTick() { current().tickArena.begin(); }
+
+uintptr_t SimContext::tickArenaWrapper() {
+  return current().tickArena.address();
+}
+
+uint32_t SimContext::tickArenaUsed() {
+  return static_cast<uint32_t>(current().tickArena.used());
+}
+
+// Saturates, e.g. after a request for more than 4 GiB
+uint32_t SimContext::tickArenaPeak() {
+  size_t peak = current().tickArena.peak();
+  return peak > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(peak);
+}
+
+uint32_t SimContext::tickArenaOverflows() {
+  return current().tickArena.overflows();
+}
+
+void SimContext::resetTickArenaStats() { current().tickArena.resetStats(); }
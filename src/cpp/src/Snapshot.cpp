@@ -0,0 +1,43 @@
+#include "Snapshot.h"
+
+using namespace Skynet;
+
+int32_t Snapshot::encode(uintptr_t values, uint32_t count, uint32_t mode,
+                         uintptr_t reference, uintptr_t out,
+                         uint32_t capacity) {
+  if (mode > static_cast<uint32_t>(SnapshotMode::Reference)) {
+    return static_cast<int32_t>(SnapshotStatus::BadMode);
+  }
+  SnapshotWriter writer(reinterpret_cast<uint8_t *>(out), capacity);
+  SnapshotStatus status =
+      writer.writeColumn(reinterpret_cast<const int64_t *>(values), count,
+                         static_cast<SnapshotMode>(mode),
+                         reinterpret_cast<const int64_t *>(reference));
+  if (status != SnapshotStatus::Ok) {
+    return static_cast<int32_t>(status);
+  }
+  return static_cast<int32_t>(writer.size());
+}
+
+int32_t Snapshot::decode(uintptr_t in, uint32_t size, uintptr_t reference,
+                         uint32_t referenceCount, uintptr_t out,
+                         uint32_t capacity) {
+  SnapshotReader reader(reinterpret_cast<const uint8_t *>(in), size);
+  int64_t count =
+      reader.readColumn(reinterpret_cast<int64_t *>(out), capacity,
+                        reinterpret_cast<const int64_t *>(reference),
+                        referenceCount);
+  if (count < 0) {
+    return static_cast<int32_t>(reader.status());
+  }
+  return static_cast<int32_t>(count);
+}
+
+int32_t Snapshot::decodedCount(uintptr_t in, uint32_t size) {
+  SnapshotReader reader(reinterpret_cast<const uint8_t *>(in), size);
+  int64_t count = reader.nextColumnCount();
+  if (count < 0) {
+    return static_cast<int32_t>(reader.status());
+  }
+  return static_cast<int32_t>(count);
+}
@@ -0,0 +1,47 @@
+#include "StateHash.h"
+
+#include "SimContext.h"
+
+using namespace Skynet;
+
+void StateHash::resetWrapper(uint32_t seedHigh, uint32_t seedLow) {
+  SimContext::current().stateHash.reset(static_cast<uint64_t>(seedHigh) << 32 | seedLow);
+}
+
+// Raw and number params both hash as their Fixed64 value, so a value
+// passed as 1.5 hashes like the same value passed as high/low.
+void StateHash::updateParams(uint32_t count) {
+  for (uint32_t i = 0; i < count; ++i) {
+    SimContext::current().stateHash.update(Fixed64(getInteropParamArray()[i]));
+  }
+}
+
+void StateHash::updateBytes(uintptr_t data, uint32_t size) {
+  SimContext::current().stateHash.update(reinterpret_cast<const void *>(data), size);
+}
+
+void StateHash::updateColumn(uintptr_t values, uint32_t count) {
+  SimContext::current().stateHash.updateRaw(reinterpret_cast<const int64_t *>(values), count);
+}
+
+// Columns are hashed one after the other: all x, then all y (then all z).
+void StateHash::updateVector2Columns(uintptr_t xs, uintptr_t ys,
+                                     uint32_t count) {
+  updateColumn(xs, count);
+  updateColumn(ys, count);
+}
+
+void StateHash::updateVector3Columns(uintptr_t xs, uintptr_t ys, uintptr_t zs,
+                                     uint32_t count) {
+  updateColumn(xs, count);
+  updateColumn(ys, count);
+  updateColumn(zs, count);
+}
+
+void StateHash::digestWrapper() {
+  uint64_t digest = SimContext::current().stateHash.digest();
+  InteropReturnArray &returnArray = getInteropReturnArray();
+  returnArray.clear();
+  returnArray.push_back(static_cast<uint32_t>(digest >> 32));
+  returnArray.push_back(static_cast<uint32_t>(digest));
+}
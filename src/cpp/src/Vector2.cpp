@@ -1,5 +1,7 @@
 #include "Vector2.h"
 
+#include "JobPool.h"
+
 using namespace Skynet;
 
 void Vector2::setWrapper() {
@@ -13,6 +15,21 @@ void Vector2::normalizeWrapper() {
   setInteropReturnArray(0, vector);
 }
 
+// Normalizes `count` vectors in place; xs and ys are columns of raw values.
+void Vector2::normalizeMany(uintptr_t xs, uintptr_t ys, uint32_t count) {
+  int64_t *x = reinterpret_cast<int64_t *>(xs);
+  int64_t *y = reinterpret_cast<int64_t *>(ys);
+  JobPool::parallelFor(
+      count, JobPool::kBatchGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+          Fixed64 components[2] = {Fixed64(x[i]), Fixed64(y[i])};
+          FixedMath::Normalize(components);
+          x[i] = components[0].value;
+          y[i] = components[1].value;
+        }
+      });
+}
+
 void Vector2::addWrapper() {
   Vector2 vector1 = getInteropVector2Param(0);
   Vector2 vector2 = getInteropVector2Param(2);
@@ -1,5 +1,7 @@
 #include "Vector3.h"
 
+#include "JobPool.h"
+
 using namespace Skynet;
 
 void Vector3::set() {
@@ -82,16 +84,30 @@ void Vector3::scalar() {
 // Vector normalization
 void Vector3::normalizeWrapper() {
   Vector3 vec = getInteropVector3Param(0);
-  Fixed64 length = FixedMath::Sqrt(vec.x() * vec.x() + vec.y() * vec.y() +
-                                   vec.z() * vec.z());
-  if (length != 0) {
-    vec._x = vec._x / length;
-    vec._y = vec._y / length;
-    vec._z = vec._z / length;
-  }
+  vec.normalize();
   setInteropReturnArray(0, vec);
 }
 
+// Normalizes `count` vectors in place; xs, ys and zs are columns of raw
+// values.
+void Vector3::normalizeMany(uintptr_t xs, uintptr_t ys, uintptr_t zs,
+                            uint32_t count) {
+  int64_t *x = reinterpret_cast<int64_t *>(xs);
+  int64_t *y = reinterpret_cast<int64_t *>(ys);
+  int64_t *z = reinterpret_cast<int64_t *>(zs);
+  JobPool::parallelFor(
+      count, JobPool::kBatchGrain, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+          Fixed64 components[3] = {Fixed64(x[i]), Fixed64(y[i]),
+                                   Fixed64(z[i])};
+          FixedMath::Normalize(components);
+          x[i] = components[0].value;
+          y[i] = components[1].value;
+          z[i] = components[2].value;
+        }
+      });
+}
+
 void Vector3::normalizedDirection() {
   Vector3 vec1 = getInteropVector3Param(0);
   Vector3 vec2 = getInteropVector3Param(3);
@@ -203,21 +219,30 @@ void Vector3::lerp() {
 }
 
 bool Vector3::isCircleOverlaps(bool is2D, bool returnDistSquared) {
+  return is2D ? isCircleOverlapsOnPlane<Plane::XY>(returnDistSquared)
+              : isCircleOverlapsOnPlane<Plane::XZ>(returnDistSquared);
+}
+
+template <Plane P>
+bool Vector3::isCircleOverlapsOnPlane(bool returnDistSquared) {
   Vector3 center1 = getInteropVector3Param(0);
   Vector3 center2 = getInteropVector3Param(3);
   Fixed64 radius1(getInteropParamArray()[6]);
   Fixed64 radius2(getInteropParamArray()[7]);
   if (returnDistSquared) {
     Fixed64 distSquared;
-    bool ret = checkCircleOverlap(center1, center2, radius1, radius2, is2D,
-                                  &distSquared);
+    bool ret = checkCircleOverlap<P>(center1, center2, radius1, radius2,
+                                     &distSquared);
     getInteropReturnArray()[0] = static_cast<Fixed64Param>(distSquared);
     return ret;
   }
 
-  return checkCircleOverlap(center1, center2, radius1, radius2, is2D);
+  return checkCircleOverlap<P>(center1, center2, radius1, radius2);
 }
 
+template bool Vector3::isCircleOverlapsOnPlane<Plane::XY>(bool);
+template bool Vector3::isCircleOverlapsOnPlane<Plane::XZ>(bool);
+
 bool Vector3::isLineCircleIntersect() {
   Vector3 point1 = getInteropVector3Param(0);
   Vector3 point2 = getInteropVector3Param(3);
@@ -1,12 +1,17 @@
 /* eslint-disable */
 // Fixed64.ts
-import { Fixed64Module, interopReturnArrayAddress, interopReturnUint32ArrayAddress, fixed64ParamOffsets, interopParamArrayAddress, sizeOfFixed64Param, interopParamUint32ArrayAddress } from './Fixed64WasmLoader.esm.js';
+import { Fixed64Module, Fixed64Exports, interopReturnArrayAddress, interopReturnUint32ArrayAddress, fixed64ParamOffsets, interopParamArrayAddress, sizeOfFixed64Param, interopParamUint32ArrayAddress, interopCharArrayAddress, bindFixed64Context, boundFixed64Context, fixed64InteropReady, initFixed64Interop, fixed64Heap, fixed64FixedHeapSize, Fixed64HeapViews } from './Fixed64WasmLoader.esm.js';
 import { Fixed64Param } from '../../dist/esm/Fixed64Native.js';
 
 export namespace Fixed64 {
     export type Constructor = typeof Fixed64;
     export type Instance = Fixed64;
     export type Value = string | number | Fixed64 | { x?: string };
+    export type EntryPointStats = { name: string, calls: number, timeNs: number, cycles: number };
+    /** A value of `Fixed64.Rounding` */
+    export type Rounding = 0 | 1 | 2 | 3 | 255;
+    /** A value of `Fixed64.WorldType` */
+    export type WorldType = 0 | 1;
 }
 
 const tempHighLow: { high: number, low: number } = { high: 0, low: 0 };
@@ -26,6 +31,28 @@ export class Fixed64 {
     public static readonly Infinity = Fixed64.createFromHighLow(0x7FFFFFFF, 0xFFFFFFFF);
     public static readonly NegInfinity = Fixed64.createFromHighLow(-2147483648, 1);
 
+    /** Rounding of number to Fixed64 conversions, see FixedConvert.h */
+    public static readonly Rounding = {
+        /** Towards negative infinity */
+        Floor: 0,
+        /** Towards zero */
+        Truncate: 1,
+        /** To the nearest value, halfway cases away from zero */
+        Nearest: 2,
+        /** Floor as computed before FIXED64_MATH_VERSION 2, which rounds some tiny negative numbers up to 0 */
+        LegacyFloor: 3,
+        /** What `new Fixed64(n)` uses: LegacyFloor in math version 1 builds, Floor from version 2 */
+        Default: 255,
+    } as const;
+
+    /** Plane of the Rect tests, see SimContext.h */
+    public static readonly WorldType = {
+        /** Vector3 x and y */
+        TwoDimensional: 0,
+        /** Vector3 x and z */
+        ThreeDimensional: 1,
+    } as const;
+
     private static readonly ONE: number = 65536;
 
     /**
@@ -34,7 +61,7 @@ export class Fixed64 {
      *  value - The value to create the Decimal instance from, can be a `string`, `number`, `Fixed64`, or an object with an optional `x` property.
      *      * - `new Fixed64(1.1)` creates a Decimal instance from a number.
      * - `new Fixed64('-0.5')` creates a Decimal instance from a string.
-     * Note: When creating a Decimal instance from a `Number` type's special values (`NaN`, `Infinity`, `-Infinity`), the result will be `new Fixed64(0)`.
+     * Note: When creating a Decimal instance from `NaN` the result will be `new Fixed64(0)`; `Infinity`, `-Infinity` and other numbers outside the Fixed64 range saturate to the largest and smallest raw values.
      */
     public constructor(value: Fixed64.Value) {
         this.set(value);
@@ -134,20 +161,24 @@ export class Fixed64 {
     }
 
     public static prepareInteropParamArray(...decimals: (Fixed64 | Fixed64Param)[]): void {
+        if (!fixed64InteropReady) {
+            initFixed64Interop();
+        }
+        const heap = fixed64Heap();
         function setInteropParam(index: number, value: Fixed64Param): void {
             const offset = index * sizeOfFixed64Param;
             const address = interopParamArrayAddress + offset;
 
             // Update boolean value
-            Fixed64Module.HEAP32[(address + fixed64ParamOffsets.isRaw) >> 2] = value.isRaw ? 1 : 0;
+            heap.i32[(address + fixed64ParamOffsets.isRaw) >> 2] = value.isRaw ? 1 : 0;
             if (value.isRaw) {
                 // Update double-precision floating-point number
-                Fixed64Module.HEAPF64[(address + fixed64ParamOffsets.raw) >> 3] = value.raw;
+                heap.f64[(address + fixed64ParamOffsets.raw) >> 3] = value.raw;
             }
             else {
                 // Update integer
-                Fixed64Module.HEAP32[(address + fixed64ParamOffsets.high) >> 2] = value.high;
-                Fixed64Module.HEAPU32[(address + fixed64ParamOffsets.low) >> 2] = value.low;
+                heap.i32[(address + fixed64ParamOffsets.high) >> 2] = value.high;
+                heap.u32[(address + fixed64ParamOffsets.low) >> 2] = value.low;
             }
         }
 
@@ -162,19 +193,27 @@ export class Fixed64 {
     }
 
     public static prepareInteropParamUint32Array(params: number[]): void {
+        if (!fixed64InteropReady) {
+            initFixed64Interop();
+        }
+        const heapU32 = fixed64Heap().u32;
         for (let index = 0; index < params.length; index++) {
             const valueAddress = interopParamUint32ArrayAddress + index * 4;
-            Fixed64Module.HEAPU32[valueAddress >> 2] = params[index];
+            heapU32[valueAddress >> 2] = params[index];
         }
     }
 
     public static getInteropReturn(index: number, out?: Fixed64): Fixed64 {
+        if (!fixed64InteropReady) {
+            initFixed64Interop();
+        }
         const offset = index * sizeOfFixed64Param;
         const address = interopReturnArrayAddress + offset;
 
         // Read integer
-        const high = Fixed64Module.HEAP32[(address + fixed64ParamOffsets.high) >> 2];
-        const low = Fixed64Module.HEAPU32[(address + fixed64ParamOffsets.low) >> 2];
+        const heap = fixed64Heap();
+        const high = heap.i32[(address + fixed64ParamOffsets.high) >> 2];
+        const low = heap.u32[(address + fixed64ParamOffsets.low) >> 2];
 
         if (out) {
             out.isRaw = false;
@@ -190,18 +229,420 @@ export class Fixed64 {
     }
 
     public static getInteropReturnUint32ArrayLength(): number {
-        const length = Fixed64Module.HEAPU32[interopReturnUint32ArrayAddress >> 2];
+        if (!fixed64InteropReady) {
+            initFixed64Interop();
+        }
+        const length = fixed64Heap().u32[interopReturnUint32ArrayAddress >> 2];
         return length;
     }
 
     public static getInteropReturnUint32ArrayValue(index: number): number {
+        if (!fixed64InteropReady) {
+            initFixed64Interop();
+        }
         const offset = (1 + index) * 4;
         const valueAddress = interopReturnUint32ArrayAddress + offset;
 
-        const value = Fixed64Module.HEAPU32[valueAddress >> 2];
+        const value = fixed64Heap().u32[valueAddress >> 2];
         return value;
     }
 
+    // State hashing (XXH64) for desync checks. Updates go to the bound context's native hasher;
+    // `hashDigest()` does not end the stream, so a digest can be taken every tick.
+    public static hashReset(seed: bigint = 0n): void {
+        Fixed64Exports.StateHash.reset(Number((seed >> 32n) & 0xFFFFFFFFn), Number(seed & 0xFFFFFFFFn));
+    }
+
+    public static hashUpdate(...values: Fixed64.Value[]): void {
+        // toFixed64Param reuses a pool of 16 params, so marshal at most 16 values per call
+        for (let start = 0; start < values.length; start += 16) {
+            const chunk = values.slice(start, start + 16);
+            Fixed64.prepareInteropParamArray(...chunk.map(value => Fixed64.toFixed64Param(value)));
+            Fixed64Exports.StateHash.updateParams(chunk.length);
+        }
+    }
+
+    /**
+     * Hashes `count` raw Fixed64 values (little-endian int64) stored at `address` in the wasm heap,
+     * e.g. a component column allocated with `_malloc`.
+     */
+    public static hashUpdateColumn(address: number, count: number): void {
+        Fixed64Exports.StateHash.updateColumn(address, count);
+    }
+
+    public static hashDigest(): bigint {
+        Fixed64Exports.StateHash.digest();
+        const high = Fixed64.getInteropReturnUint32ArrayValue(0);
+        const low = Fixed64.getInteropReturnUint32ArrayValue(1);
+        return (BigInt(high) << 32n) | BigInt(low);
+    }
+
+    // Snapshots: exact binary encoding of Fixed64 columns, see Snapshot.h for the format
+    private static mallocColumn(values: Fixed64.Value[]): number {
+        const address = Fixed64Module._malloc(Math.max(values.length, 1) * 8);
+        try {
+            for (let index = 0; index < values.length; index++) {
+                const param = Fixed64.toFixed64Param(values[index]);
+                const { high, low } = param.isRaw ? Fixed64.parseNumber(param.raw) : param;
+                // Little-endian int64: low word first
+                Fixed64Module.HEAPU32[(address >> 2) + index * 2] = low;
+                Fixed64Module.HEAP32[(address >> 2) + index * 2 + 1] = high;
+            }
+        } catch (error) {
+            Fixed64Module._free(address);
+            throw error;
+        }
+        return address;
+    }
+
+    /**
+     * Encodes `values` as a snapshot. With `reference` (e.g. the previous tick, same length) only the
+     * differences are stored, which typically takes 1-3 bytes per value instead of 4-9.
+     */
+    public static encodeSnapshot(values: Fixed64.Value[], reference?: Fixed64.Value[]): Uint8Array {
+        if (reference && reference.length !== values.length) {
+            throw new Error('encodeSnapshot: reference must have as many values as values');
+        }
+        const capacity = Fixed64Exports.Snapshot.maxEncodedSize(values.length);
+        const out = Fixed64Module._malloc(capacity);
+        let valuesAddress = 0;
+        let referenceAddress = 0;
+        try {
+            valuesAddress = Fixed64.mallocColumn(values);
+            referenceAddress = reference ? Fixed64.mallocColumn(reference) : 0;
+            const size = Fixed64Exports.Snapshot.encode(valuesAddress, values.length, reference ? 2 : 0, referenceAddress, out, capacity);
+            if (size < 0) {
+                throw new Error(`encodeSnapshot failed with status ${size}`);
+            }
+            return Fixed64Module.HEAPU8.slice(out, out + size);
+        } finally {
+            Fixed64Module._free(out);
+            if (valuesAddress) {
+                Fixed64Module._free(valuesAddress);
+            }
+            if (referenceAddress) {
+                Fixed64Module._free(referenceAddress);
+            }
+        }
+    }
+
+    /** Decodes a snapshot from `encodeSnapshot`; `reference` must be the column it was encoded against. */
+    public static decodeSnapshot(bytes: Uint8Array, reference?: Fixed64.Value[]): Fixed64[] {
+        const input = Fixed64Module._malloc(Math.max(bytes.length, 1));
+        Fixed64Module.HEAPU8.set(bytes, input);
+        let referenceAddress = 0;
+        let out = 0;
+        try {
+            referenceAddress = reference ? Fixed64.mallocColumn(reference) : 0;
+            const count = Fixed64Exports.Snapshot.decodedCount(input, bytes.length);
+            if (count < 0) {
+                throw new Error(`decodeSnapshot failed with status ${count}`);
+            }
+            out = Fixed64Module._malloc(Math.max(count, 1) * 8);
+            const decoded = Fixed64Exports.Snapshot.decode(input, bytes.length, referenceAddress, reference ? reference.length : 0, out, count);
+            if (decoded < 0) {
+                throw new Error(`decodeSnapshot failed with status ${decoded}`);
+            }
+            const result: Fixed64[] = new Array(decoded);
+            for (let index = 0; index < decoded; index++) {
+                const low = Fixed64Module.HEAPU32[(out >> 2) + index * 2];
+                const high = Fixed64Module.HEAP32[(out >> 2) + index * 2 + 1];
+                result[index] = Fixed64.createFromHighLow(high, low);
+            }
+            return result;
+        } finally {
+            Fixed64Module._free(input);
+            if (referenceAddress) {
+                Fixed64Module._free(referenceAddress);
+            }
+            if (out) {
+                Fixed64Module._free(out);
+            }
+        }
+    }
+
+    // Instrumentation, only populated by builds configured with FIXED64_INSTRUMENTATION
+    public static isInstrumented(): boolean {
+        return Fixed64Module.isInstrumented();
+    }
+
+    /**
+     * Entry points called since the last `resetStats()`, e.g. `{ name: 'Vector3.rotateY', calls: 120, timeNs: 0, cycles: 0 }`.
+     * `timeNs` is only accumulated while `setStatsTiming(true)` is in effect. Read and reset once per frame for per-frame call histograms.
+     */
+    public static getStats(): Fixed64.EntryPointStats[] {
+        return Fixed64Module.getStats();
+    }
+
+    public static resetStats(): void {
+        Fixed64Module.resetStats();
+    }
+
+    public static setStatsTiming(enabled: boolean): void {
+        Fixed64Module.setStatsTiming(enabled);
+    }
+
+    /**
+     * Worker threads that share the batch kernels (the `*Many` entry points, `fromFloat64Array`) in builds configured with
+     * FIXED64_THREADS; 0 runs them on the calling thread. Results do not depend on the count.
+     */
+    public static setWorkerCount(count: number): void {
+        Fixed64Exports.JobPool.setWorkerCount(count);
+    }
+
+    /** 0 in single-threaded builds, and in threaded builds before the first large batch unless set */
+    public static workerCount(): number {
+        return Fixed64Exports.JobPool.workerCount();
+    }
+
+    // Simulation contexts, see SimContext.h
+    /**
+     * Creates a context with its own interop arrays, world type and StateHash stream, e.g. one per match hosted by
+     * this module. Returns its handle, or 0 when the module is out of memory.
+     */
+    public static createContext(): number {
+        return Fixed64Exports.SimContext.create();
+    }
+
+    /** Runs every later call against `context`, 0 for the default context */
+    public static useContext(context: number): void {
+        if (context !== boundFixed64Context) {
+            bindFixed64Context(context);
+        }
+    }
+
+    /** The bound context, 0 for the default one */
+    public static currentContext(): number {
+        return boundFixed64Context;
+    }
+
+    /** Frees `context`; the default context is bound again if it was in use */
+    public static destroyContext(context: number): void {
+        if (context === 0) {
+            return;
+        }
+        if (context === boundFixed64Context) {
+            bindFixed64Context(0);
+        }
+        Fixed64Exports.SimContext.destroy(context);
+    }
+
+    /** World type of the bound context, TwoDimensional unless set */
+    public static setWorldType(worldType: Fixed64.WorldType): void {
+        Fixed64Exports.SimContext.setWorldType(worldType);
+    }
+
+    public static worldType(): Fixed64.WorldType {
+        return Fixed64Exports.SimContext.worldType() as Fixed64.WorldType;
+    }
+
+    // Heap and arenas, see Arena.h
+    /**
+     * Views over the whole heap. With a fixed heap (`fixedHeapSize() > 0`) they never detach, so they and views
+     * derived from them, e.g. `new Int32Array(heap.u8.buffer, address, count)`, can be kept for good. Otherwise
+     * only until the next call that allocates.
+     */
+    public static heap(): Fixed64HeapViews {
+        return fixed64Heap();
+    }
+
+    /** Size of the heap in builds where it never grows (FIXED64_HEAP_SIZE, the Node addon), 0 otherwise */
+    public static fixedHeapSize(): number {
+        return fixed64FixedHeapSize;
+    }
+
+    /**
+     * Reserves `capacity` bytes for `allocateFromArena`, e.g. the batch buffers of a tick, and returns the arena's
+     * address, 0 if the heap is exhausted. Create arenas up front: allocating from one never grows the heap.
+     */
+    public static createArena(capacity: number): number {
+        return Fixed64Exports.Arena.create(capacity);
+    }
+
+    /** Address of `size` bytes from `arena`, aligned to 16 bytes; 0 when the arena is full */
+    public static allocateFromArena(arena: number, size: number): number {
+        return Fixed64Exports.Arena.allocate(arena, size);
+    }
+
+    /** Frees everything allocated from `arena`, e.g. at the start of a tick */
+    public static resetArena(arena: number): void {
+        Fixed64Exports.Arena.reset(arena);
+    }
+
+    /** Bytes allocated from `arena` since its last reset, alignment included */
+    public static arenaUsed(arena: number): number {
+        return Fixed64Exports.Arena.used(arena);
+    }
+
+    public static destroyArena(arena: number): void {
+        Fixed64Exports.Arena.destroy(arena);
+    }
+
+    // Tick arena, see TickArena.h
+    /**
+     * Replaces the bound context's tick arena by one of `capacity` bytes; false (keeping the old one) if the heap is
+     * exhausted. Call outside the tick, sized from `tickArenaStats().peak`.
+     */
+    public static reserveTickArena(capacity: number): boolean {
+        return Fixed64Exports.SimContext.reserveTickArena(capacity);
+    }
+
+    /** Frees the previous tick's query results and native temporaries; call at the start of every tick */
+    public static beginTick(): void {
+        Fixed64Exports.SimContext.beginTick();
+    }
+
+    /**
+     * The result of the last tick arena query, e.g. `Rect.queryCircles`, as indices into its input. The view is
+     * valid until the next `beginTick()` and, unless the heap is fixed, until the next call that allocates.
+     */
+    public static tickResult(): Uint32Array {
+        const offset = Fixed64.getInteropReturnUint32ArrayValue(0);
+        const length = Fixed64.getInteropReturnUint32ArrayValue(1);
+        const address = Fixed64Exports.SimContext.tickArena() + offset;
+        return new Uint32Array(fixed64Heap().u8.buffer, address, length);
+    }
+
+    /**
+     * Bytes used this tick, the bytes the arena needs for every request (failed and worst-case ones included)
+     * and the requests that did not fit, since the last `resetTickArenaStats()`. A nonzero `overflows` means queries
+     * came back empty: reserve at least `peak`.
+     */
+    public static tickArenaStats(): { used: number, peak: number, overflows: number } {
+        return {
+            used: Fixed64Exports.SimContext.tickArenaUsed(),
+            peak: Fixed64Exports.SimContext.tickArenaPeak(),
+            overflows: Fixed64Exports.SimContext.tickArenaOverflows(),
+        };
+    }
+
+    public static resetTickArenaStats(): void {
+        Fixed64Exports.SimContext.resetTickArenaStats();
+    }
+
+    // Entity tables, see EntityTable.h
+    /**
+     * A table of up to `capacity` entities in module memory, 0 if the heap is exhausted. Add its columns with
+     * `addEntityColumn` before the first tick; spawning never allocates.
+     */
+    public static createEntityTable(capacity: number): number {
+        return Fixed64Exports.EntityTable.create(capacity);
+    }
+
+    public static destroyEntityTable(table: number): void {
+        Fixed64Exports.EntityTable.destroy(table);
+    }
+
+    /** Adds a zeroed column of 1 (Fixed64), 2 (Vector2) or 3 (Vector3) components; returns its index, -1 on failure */
+    public static addEntityColumn(table: number, components: number): number {
+        return Fixed64Exports.EntityTable.addColumn(table, components);
+    }
+
+    /** Id of a new entity with all columns zero, 0xffffffff if the table is full. Ids of despawned entities are reused. */
+    public static spawnEntity(table: number): number {
+        return Fixed64Exports.EntityTable.spawn(table);
+    }
+
+    /** Removes the entity; the last row moves into its place, so rows (not ids) of other entities can change */
+    public static despawnEntity(table: number, id: number): boolean {
+        return Fixed64Exports.EntityTable.despawn(table, id);
+    }
+
+    /** Row of entity `id`, 0xffffffff if it does not exist */
+    public static entityRow(table: number, id: number): number {
+        return Fixed64Exports.EntityTable.rowOf(table, id);
+    }
+
+    public static entityCount(table: number): number {
+        return Fixed64Exports.EntityTable.size(table);
+    }
+
+    /**
+     * The id of each row, e.g. to map the rows of `tickResult()` after `EntityTable.queryRect` to entities. The
+     * view covers the whole capacity, so it stays valid while entities spawn; only the first `entityCount` ids
+     * are live.
+     */
+    public static entityIds(table: number): Uint32Array {
+        const address = Fixed64Exports.EntityTable.ids(table);
+        if (!address) {
+            throw new Error('entityIds: unknown table');
+        }
+        return new Uint32Array(fixed64Heap().u8.buffer, address, Fixed64Exports.EntityTable.capacity(table));
+    }
+
+    /**
+     * One component of a column as raw Fixed64 values, low and high 32 bits per row, without copying. The view
+     * covers the whole capacity and only the first `entityCount` rows are live; like `heap()` it survives heap
+     * growth only with a fixed heap.
+     */
+    public static entityColumn(table: number, column: number, component: number = 0): Int32Array {
+        const address = Fixed64Exports.EntityTable.column(table, column, component);
+        if (!address) {
+            throw new Error(`entityColumn: unknown table, column ${column} or component ${component}`);
+        }
+        return new Int32Array(fixed64Heap().u8.buffer, address, 2 * Fixed64Exports.EntityTable.capacity(table));
+    }
+
+    /** Writes the components of one entity's column; false for unknown ids or columns */
+    public static setEntityValue(table: number, column: number, id: number, ...values: Fixed64[]): boolean {
+        const components = Fixed64Exports.EntityTable.components(table, column);
+        if (components === 0) {
+            return false;
+        }
+        if (values.length !== components) {
+            throw new Error(`setEntityValue: column ${column} takes ${components} values, got ${values.length}`);
+        }
+        Fixed64.prepareInteropParamArray(...values);
+        return Fixed64Exports.EntityTable.set(table, column, id);
+    }
+
+    /** Components of one entity's column, empty for unknown ids or columns */
+    public static getEntityValue(table: number, column: number, id: number, components: number): Fixed64[] {
+        if (!Fixed64Exports.EntityTable.get(table, column, id)) {
+            return [];
+        }
+        return Array.from({ length: components }, (_, index) => Fixed64.getInteropReturn(index));
+    }
+
+    /** position += velocity * deltaTime for every entity; false if the columns do not match */
+    public static integrateEntities(table: number, position: number, velocity: number, deltaTime: Fixed64): boolean {
+        Fixed64.prepareInteropParamArray(deltaTime);
+        return Fixed64Exports.EntityTable.integrate(table, position, velocity);
+    }
+
+    // Recording, only available in builds configured with FIXED64_RECORDING
+    public static isRecordingBuild(): boolean {
+        return Fixed64Module.Recorder.isEnabled();
+    }
+
+    /**
+     * Starts recording every bound call into a ring buffer of `capacity` bytes; once it is full the oldest calls
+     * are dropped. Replay the result of `takeRecording()` with the native Fixed64Replay tool to find the first call
+     * whose result differs, e.g. between two peers of a desynced session.
+     */
+    public static startRecording(capacity: number = 1 << 20): void {
+        if (!Fixed64Module.Recorder.isEnabled()) {
+            throw new Error('startRecording: the module was built without FIXED64_RECORDING');
+        }
+        Fixed64Module.Recorder.start(capacity);
+    }
+
+    public static stopRecording(): void {
+        Fixed64Module.Recorder.stop();
+    }
+
+    /** The calls recorded since `startRecording()` as a log for Fixed64Replay, oldest first. */
+    public static takeRecording(): Uint8Array {
+        const capacity = Fixed64Module.Recorder.logSize();
+        const out = Fixed64Module._malloc(capacity);
+        try {
+            const size = Fixed64Module.Recorder.writeLog(out, capacity);
+            return Fixed64Module.HEAPU8.slice(out, out + size);
+        } finally {
+            Fixed64Module._free(out);
+        }
+    }
+
     // Utility Functions
     // ToNumber
     public toNumberSafe(): number {
@@ -209,7 +650,7 @@ export class Fixed64 {
             return this.raw;
         }
         Fixed64.prepareInteropParamArray(this);
-        return Fixed64Module.Fixed64Native.toNumber();
+        return Fixed64Exports.Fixed64Native.toNumber();
     }
 
     public get highLow(): [number, number] {
@@ -283,6 +724,49 @@ export class Fixed64 {
         return this.toNumber().toString();
     }
 
+    /**
+     * Exact decimal text of the raw value, rounded to at most `digits` (0-16) fractional digits with trailing
+     * zeros dropped. With 5 or more digits, `Fixed64.fromDecimalString` reproduces the raw value.
+     */
+    public toDecimalString(digits: number = 5): string {
+        if (!fixed64InteropReady) {
+            initFixed64Interop();
+        }
+        Fixed64.prepareInteropParamArray(this.values());
+        const length = Fixed64Exports.Fixed64Native.formatDecimal(digits);
+        const heapU8 = fixed64Heap().u8;
+        let text = '';
+        for (let index = 0; index < length; index++) {
+            text += String.fromCharCode(heapU8[interopCharArrayAddress + index]);
+        }
+        return text;
+    }
+
+    /**
+     * Parses decimal text such as '-12.5' or '1e-3', rounding to the nearest raw value. Leading whitespace is
+     * skipped; trailing characters and non-ASCII text are rejected.
+     */
+    public static fromDecimalString(text: string, out?: Fixed64): Fixed64 {
+        if (text.length > 4096) {
+            throw new Error('fromDecimalString: text is too long');
+        }
+        if (!fixed64InteropReady) {
+            initFixed64Interop();
+        }
+        const heapU8 = fixed64Heap().u8;
+        for (let index = 0; index < text.length; index++) {
+            const code = text.charCodeAt(index);
+            if (code > 0x7f) {
+                throw new Error(`fromDecimalString: invalid or out of range value '${text}'`);
+            }
+            heapU8[interopCharArrayAddress + index] = code;
+        }
+        if (!Fixed64Exports.Fixed64Native.parseDecimal(text.length)) {
+            throw new Error(`fromDecimalString: invalid or out of range value '${text}'`);
+        }
+        return Fixed64.getInteropReturn(0, out);
+    }
+
     // Basic Arithmetic Operations
 
     /**
@@ -392,7 +876,7 @@ export class Fixed64 {
         }
 
         Fixed64.prepareInteropParamArray(this, bFixed64);
-        Fixed64Module.Fixed64Native.mul();
+        Fixed64Exports.Fixed64Native.mul();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -402,7 +886,7 @@ export class Fixed64 {
             return out?.set(this) || this;
         }
         Fixed64.prepareInteropParamArray(this, nFixed64);
-        Fixed64Module.Fixed64Native.div();
+        Fixed64Exports.Fixed64Native.div();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -420,7 +904,7 @@ export class Fixed64 {
     public mod(b: Fixed64.Value, out?: Fixed64): Fixed64 {
         const bFixed64 = Fixed64.toFixed64Param(b);
         Fixed64.prepareInteropParamArray(this, bFixed64);
-        Fixed64Module.Fixed64Native.mod();
+        Fixed64Exports.Fixed64Native.mod();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -434,7 +918,7 @@ export class Fixed64 {
 
     public square(out?: Fixed64): Fixed64 {
         Fixed64.prepareInteropParamArray(this);
-        Fixed64Module.Fixed64Native.square();
+        Fixed64Exports.Fixed64Native.square();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -444,20 +928,134 @@ export class Fixed64 {
      */
     public pow2(out?: Fixed64): Fixed64 {
         Fixed64.prepareInteropParamArray(this);
-        Fixed64Module.Fixed64Native.pow2();
+        Fixed64Exports.Fixed64Native.pow2();
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    /**
+     * Raises this value to an integer power by repeated squaring.
+     * A negative exponent returns the reciprocal of the positive power.
+     */
+    public powInt(exponent: number, out?: Fixed64): Fixed64 {
+        Fixed64.prepareInteropParamArray(this);
+        Fixed64Exports.Fixed64Native.powInt(exponent);
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    // Bit Operations on the raw 64-bit value
+    // Count leading zeroes, 64 for zero
+    public clz(): number {
+        Fixed64.prepareInteropParamArray(this);
+        return Fixed64Exports.Fixed64Native.clz();
+    }
+
+    // Count trailing zeroes, 64 for zero
+    public ctz(): number {
+        Fixed64.prepareInteropParamArray(this);
+        return Fixed64Exports.Fixed64Native.ctz();
+    }
+
+    // Number of set bits
+    public popcount(): number {
+        Fixed64.prepareInteropParamArray(this);
+        return Fixed64Exports.Fixed64Native.popcount();
+    }
+
+    /**
+     * Returns floor(log2(this)) for positive values, -2147483648 otherwise.
+     */
+    public log2Int(): number {
+        Fixed64.prepareInteropParamArray(this);
+        return Fixed64Exports.Fixed64Native.log2Int();
+    }
+
+    /**
+     * Splits this value into mantissa * 2^exponent with |mantissa| in [1, 2).
+     * Zero yields a zero mantissa and exponent.
+     */
+    public frexp(out?: Fixed64): { mantissa: Fixed64, exponent: number } {
+        Fixed64.prepareInteropParamArray(this);
+        const exponent = Fixed64Exports.Fixed64Native.frexp();
+        return { mantissa: Fixed64.getInteropReturn(0, out), exponent };
+    }
+
+    /**
+     * Calculates e raised to the power of a.
+     */
+    public static exp(a: Fixed64.Value, out?: Fixed64): Fixed64 {
+        const aFixed64 = Fixed64.toFixed64Param(a);
+        Fixed64.prepareInteropParamArray(aFixed64);
+        Fixed64Exports.Fixed64Native.exp();
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    public exp(out?: Fixed64): Fixed64 {
+        Fixed64.prepareInteropParamArray(this);
+        Fixed64Exports.Fixed64Native.exp();
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    /**
+     * Base-2 logarithm, NaN for values that are not positive.
+     */
+    public static log2(a: Fixed64.Value, out?: Fixed64): Fixed64 {
+        const aFixed64 = Fixed64.toFixed64Param(a);
+        Fixed64.prepareInteropParamArray(aFixed64);
+        Fixed64Exports.Fixed64Native.log2();
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    public log2(out?: Fixed64): Fixed64 {
+        Fixed64.prepareInteropParamArray(this);
+        Fixed64Exports.Fixed64Native.log2();
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    /**
+     * Natural logarithm, NaN for values that are not positive.
+     */
+    public static ln(a: Fixed64.Value, out?: Fixed64): Fixed64 {
+        const aFixed64 = Fixed64.toFixed64Param(a);
+        Fixed64.prepareInteropParamArray(aFixed64);
+        Fixed64Exports.Fixed64Native.ln();
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    public ln(out?: Fixed64): Fixed64 {
+        Fixed64.prepareInteropParamArray(this);
+        Fixed64Exports.Fixed64Native.ln();
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    /**
+     * Raises a to the power b. Integer exponents are exact while the result
+     * fits; a negative base with a fractional exponent yields NaN.
+     */
+    public static pow(a: Fixed64.Value, b: Fixed64.Value, out?: Fixed64): Fixed64 {
+        const aFixed64 = Fixed64.toFixed64Param(a);
+        const bFixed64 = Fixed64.toFixed64Param(b);
+        Fixed64.prepareInteropParamArray(aFixed64, bFixed64);
+        Fixed64Exports.Fixed64Native.pow();
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    public pow(exponent: Fixed64.Value, out?: Fixed64): Fixed64 {
+        const exponentFixed64 = Fixed64.toFixed64Param(exponent);
+        Fixed64.prepareInteropParamArray(this, exponentFixed64);
+        Fixed64Exports.Fixed64Native.pow();
         return Fixed64.getInteropReturn(0, out);
     }
 
     public static sqrt(a: Fixed64.Value, out?: Fixed64): Fixed64 {
         const aFixed64 = Fixed64.toFixed64Param(a);
         Fixed64.prepareInteropParamArray(aFixed64);
-        Fixed64Module.Fixed64Native.sqrt();
+        Fixed64Exports.Fixed64Native.sqrt();
         return Fixed64.getInteropReturn(0, out);
     }
 
     public sqrt(out?: Fixed64): Fixed64 {
         Fixed64.prepareInteropParamArray(this);
-        Fixed64Module.Fixed64Native.sqrt();
+        Fixed64Exports.Fixed64Native.sqrt();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -519,39 +1117,39 @@ export class Fixed64 {
     public static ceil(a: Fixed64.Value, out?: Fixed64): Fixed64 {
         const aFixed64 = Fixed64.toFixed64Param(a);
         Fixed64.prepareInteropParamArray(aFixed64);
-        Fixed64Module.Fixed64Native.ceil();
+        Fixed64Exports.Fixed64Native.ceil();
         return Fixed64.getInteropReturn(0, out);
     }
 
     public ceil(out?: Fixed64): Fixed64 {
         Fixed64.prepareInteropParamArray(this);
-        Fixed64Module.Fixed64Native.ceil();
+        Fixed64Exports.Fixed64Native.ceil();
         return Fixed64.getInteropReturn(0, out);
     }
 
     public static floor(a: Fixed64.Value, out?: Fixed64): Fixed64 {
         const aFixed64 = Fixed64.toFixed64Param(a);
         Fixed64.prepareInteropParamArray(aFixed64);
-        Fixed64Module.Fixed64Native.floor();
+        Fixed64Exports.Fixed64Native.floor();
         return Fixed64.getInteropReturn(0, out);
     }
 
     public floor(out?: Fixed64): Fixed64 {
         Fixed64.prepareInteropParamArray(this);
-        Fixed64Module.Fixed64Native.floor();
+        Fixed64Exports.Fixed64Native.floor();
         return Fixed64.getInteropReturn(0, out);
     }
 
     public static round(a: Fixed64.Value, out?: Fixed64): Fixed64 {
         const aFixed64 = Fixed64.toFixed64Param(a);
         Fixed64.prepareInteropParamArray(aFixed64);
-        Fixed64Module.Fixed64Native.round();
+        Fixed64Exports.Fixed64Native.round();
         return Fixed64.getInteropReturn(0, out);
     }
 
     public round(out?: Fixed64): Fixed64 {
         Fixed64.prepareInteropParamArray(this);
-        Fixed64Module.Fixed64Native.round();
+        Fixed64Exports.Fixed64Native.round();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -560,7 +1158,7 @@ export class Fixed64 {
     public static cos(a: Fixed64.Value, out?: Fixed64): Fixed64 {
         const aFixed64 = Fixed64.toFixed64Param(a);
         Fixed64.prepareInteropParamArray(aFixed64);
-        Fixed64Module.Fixed64Native.cos();
+        Fixed64Exports.Fixed64Native.cos();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -568,7 +1166,7 @@ export class Fixed64 {
     public static sin(a: Fixed64.Value, out?: Fixed64): Fixed64 {
         const aFixed64 = Fixed64.toFixed64Param(a);
         Fixed64.prepareInteropParamArray(aFixed64);
-        Fixed64Module.Fixed64Native.sin();
+        Fixed64Exports.Fixed64Native.sin();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -576,7 +1174,7 @@ export class Fixed64 {
     public static tan(a: Fixed64.Value, out?: Fixed64): Fixed64 {
         const aFixed64 = Fixed64.toFixed64Param(a);
         Fixed64.prepareInteropParamArray(aFixed64);
-        Fixed64Module.Fixed64Native.tan();
+        Fixed64Exports.Fixed64Native.tan();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -584,7 +1182,7 @@ export class Fixed64 {
     public static acos(a: Fixed64.Value, out?: Fixed64): Fixed64 {
         const aFixed64 = Fixed64.toFixed64Param(a);
         Fixed64.prepareInteropParamArray(aFixed64);
-        Fixed64Module.Fixed64Native.acos();
+        Fixed64Exports.Fixed64Native.acos();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -592,7 +1190,7 @@ export class Fixed64 {
     public static asin(a: Fixed64.Value, out?: Fixed64): Fixed64 {
         const aFixed64 = Fixed64.toFixed64Param(a);
         Fixed64.prepareInteropParamArray(aFixed64);
-        Fixed64Module.Fixed64Native.asin();
+        Fixed64Exports.Fixed64Native.asin();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -600,7 +1198,7 @@ export class Fixed64 {
     public static atan(a: Fixed64.Value, out?: Fixed64): Fixed64 {
         const aFixed64 = Fixed64.toFixed64Param(a);
         Fixed64.prepareInteropParamArray(aFixed64);
-        Fixed64Module.Fixed64Native.atan();
+        Fixed64Exports.Fixed64Native.atan();
         return Fixed64.getInteropReturn(0, out);
     }
 
@@ -609,10 +1207,30 @@ export class Fixed64 {
         const yFixed64 = Fixed64.toFixed64Param(y);
         const xFixed64 = Fixed64.toFixed64Param(x);
         Fixed64.prepareInteropParamArray(yFixed64, xFixed64);
-        Fixed64Module.Fixed64Native.atan2();
+        Fixed64Exports.Fixed64Native.atan2();
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    // Inverse Tangent of y/x in degrees
+    public static atan2Deg(y: Fixed64.Value, x: Fixed64.Value, out?: Fixed64): Fixed64 {
+        const yFixed64 = Fixed64.toFixed64Param(y);
+        const xFixed64 = Fixed64.toFixed64Param(x);
+        Fixed64.prepareInteropParamArray(yFixed64, xFixed64);
+        Fixed64Exports.Fixed64Native.atan2Deg();
         return Fixed64.getInteropReturn(0, out);
     }
 
+    /**
+     * Direction of (x, y) quantized to 2^bits steps per turn, counter-clockwise from +x.
+     * bits = 3 gives the octant; bits is clamped to 1-16. Suited for compact network encoding of facings.
+     */
+    public static atan2Heading(y: Fixed64.Value, x: Fixed64.Value, bits: number): number {
+        const yFixed64 = Fixed64.toFixed64Param(y);
+        const xFixed64 = Fixed64.toFixed64Param(x);
+        Fixed64.prepareInteropParamArray(yFixed64, xFixed64);
+        return Fixed64Exports.Fixed64Native.atan2Heading(bits);
+    }
+
     public static clamp(a: Fixed64.Value, min: Fixed64.Value, max: Fixed64.Value, out?: Fixed64): Fixed64 {
         if (!out) {
             out = new Fixed64(a);
@@ -634,21 +1252,21 @@ export class Fixed64 {
     // Maximum
     public static max(...args: Fixed64.Value[]): Fixed64 {
         Fixed64.prepareInteropParamArray(...args.map(arg => Fixed64.toFixed64Param(arg)));
-        Fixed64Module.Fixed64Native.max(args.length);
+        Fixed64Exports.Fixed64Native.max(args.length);
         return Fixed64.getInteropReturn(0);
     }
 
     // Minimum
     public static min(...args: Fixed64.Value[]): Fixed64 {
         Fixed64.prepareInteropParamArray(...args.map(arg => Fixed64.toFixed64Param(arg)));
-        Fixed64Module.Fixed64Native.min(args.length);
+        Fixed64Exports.Fixed64Native.min(args.length);
         return Fixed64.getInteropReturn(0);
     }
 
     // Sum
     public static sum(...args: Fixed64.Value[]): Fixed64 {
         Fixed64.prepareInteropParamArray(...args.map(arg => Fixed64.toFixed64Param(arg)));
-        Fixed64Module.Fixed64Native.sum(args.length);
+        Fixed64Exports.Fixed64Native.sum(args.length);
         return Fixed64.getInteropReturn(0);
     }
 
@@ -668,7 +1286,7 @@ export class Fixed64 {
     */
     public isFinite(): boolean {
         Fixed64.prepareInteropParamArray(this);
-        return Fixed64Module.Fixed64Native.isFinite();
+        return Fixed64Exports.Fixed64Native.isFinite();
     }
 
     /** 
@@ -677,7 +1295,7 @@ export class Fixed64 {
     */
     public isNaN(): boolean {
         Fixed64.prepareInteropParamArray(this);
-        return Fixed64Module.Fixed64Native.isNaN();
+        return Fixed64Exports.Fixed64Native.isNaN();
     }
 
     /** 
@@ -686,7 +1304,7 @@ export class Fixed64 {
     */
     public isInfinity(): boolean {
         Fixed64.prepareInteropParamArray(this);
-        return Fixed64Module.Fixed64Native.isInfinity();
+        return Fixed64Exports.Fixed64Native.isInfinity();
     }
 
     // Is Zero
@@ -750,10 +1368,34 @@ export class Fixed64 {
     }
 
     public static parseFloat(n: number, out?: Fixed64): Fixed64 {
-        Fixed64Module.Fixed64Native.parseFloat(n);
+        Fixed64Exports.Fixed64Native.parseFloat(n);
         return Fixed64.getInteropReturn(0, out);
     }
 
+    /** Converts `n` exactly with the given rounding. NaN becomes 0; infinities and out of range values saturate. */
+    public static parseFloatRounded(n: number, rounding: Fixed64.Rounding, out?: Fixed64): Fixed64 {
+        Fixed64Exports.Fixed64Native.parseFloatRounded(n, rounding);
+        return Fixed64.getInteropReturn(0, out);
+    }
+
+    /**
+     * Converts a whole column of numbers, e.g. imported level data or physics configs, in one call.
+     * Returns the raw Fixed64 values (value * 65536) as 64-bit integers.
+     */
+    public static fromFloat64Array(values: Float64Array, rounding: Fixed64.Rounding = Fixed64.Rounding.Default): BigInt64Array {
+        const size = Math.max(values.length, 1) * 8;
+        const address = Fixed64Module._malloc(size);
+        const out = Fixed64Module._malloc(size);
+        try {
+            Fixed64Module.HEAPF64.set(values, address >> 3);
+            Fixed64Exports.Fixed64Native.parseFloatMany(address, values.length, out, rounding);
+            return new BigInt64Array(Fixed64Module.HEAPU8.buffer, out, values.length).slice();
+        } finally {
+            Fixed64Module._free(out);
+            Fixed64Module._free(address);
+        }
+    }
+
     /**
      * Note: This method performs calculations by converting internal values to native JavaScript numbers, which may lead to inconsistencies in calculation results across different platforms' CPUs.
      * Therefore, it is strictly forbidden to use this method in combat systems where cross-platform result consistency is required.
@@ -1,37 +1,175 @@
 // Fixed64WasmLoader.ts
 import MainModuleFactory from '../../dist/esm/Fixed64Native.js';
+import { Fixed64EntryPoints, bindFixed64Embind, bindFixed64Exports } from './Fixed64Exports.js';
 
 export let Fixed64Module: any;
+/** Which build backs Fixed64Module: the wasm module or the Node-API addon (see NodeNativeLoader.ts) */
+export let fixed64Backend: Fixed64Backend;
+/** The entry points, as plain wasm functions in FIXED64_C_EXPORTS builds and embind functions otherwise */
+export let Fixed64Exports: Fixed64EntryPoints;
 export let interopParamArrayAddress: number;
 export let interopParamUint32ArrayAddress: number;
 export let interopReturnArrayAddress: number;
 export let interopReturnUint32ArrayAddress: number;
+export let interopCharArrayAddress: number;
 export let sizeOfFixed64Param: number;
 export let fixed64ParamOffsets: any;
+/** Whether the interop addresses and the Fixed64Param layout above have been read, see initFixed64Interop() */
+export let fixed64InteropReady = false;
+/** Address of the SimContext bound by bindFixed64Context, 0 for the default one */
+export let boundFixed64Context = 0;
+/** Size of the heap in builds where it never grows (FIXED64_HEAP_SIZE, the Node addon), 0 otherwise */
+export let fixed64FixedHeapSize = 0;
 
-type LoadWasmFileFunction = () => Promise<Uint8Array>;
-export async function loadFixed64Wasm(loadWasmFile: LoadWasmFileFunction): Promise<any> {
+/** Views over the whole heap, see fixed64Heap() */
+export type Fixed64HeapViews = { u8: Uint8Array, i32: Int32Array, u32: Uint32Array, f64: Float64Array };
+let heapViews: Fixed64HeapViews;
+
+// Interop array offsets within a SimContext, the same for every context
+let defaultContextAddress: number;
+let interopOffsets: number[];
+
+export type Fixed64Backend = 'wasm' | 'native';
+
+/**
+ * The compiled wasm module behind Fixed64Module. Worker threads that receive it (it can be posted like any
+ * message) load with `loadFixed64Wasm(async () => module)` and skip compiling the binary again.
+ */
+export let fixed64WasmModule: WebAssembly.Module | undefined;
+
+/** Returns the wasm binary, or a module compiled from it, e.g. by compileWasmFromWeb() */
+type LoadWasmFileFunction = () => Promise<Uint8Array | WebAssembly.Module>;
+
+export type Fixed64LoadOptions = {
+    /**
+     * Bytes of wasm memory to reserve before the runtime starts. Allocations within them never grow the heap, so
+     * views over it stay attached. Builds with FIXED64_HEAP_SIZE have exactly that much memory and reject more.
+     */
+    initialMemory?: number;
+};
+
+export async function loadFixed64Wasm(loadWasmFile: LoadWasmFileFunction, options: Fixed64LoadOptions = {}): Promise<any> {
     if (!Fixed64Module) {
         const wasmData = await loadWasmFile();
-        Fixed64Module = await initWasm(MainModuleFactory, wasmData);
-        interopParamArrayAddress = Fixed64Module.getInteropParamArrayAddress();
-        interopParamUint32ArrayAddress = Fixed64Module.getInteropUint32ParamArrayAddress();
-        interopReturnArrayAddress = Fixed64Module.getInteropReturnArrayAddress();
-        interopReturnUint32ArrayAddress = Fixed64Module.getInteropReturnUint32ArrayAddress();
-        sizeOfFixed64Param = Fixed64Module.getSizeOfFixed64Param();
-        fixed64ParamOffsets = Fixed64Module.getFixed64ParamOffsets();
+        initFixed64Module(await initWasm(MainModuleFactory, wasmData, options.initialMemory ?? 0), 'wasm');
     }
     return Fixed64Module;
 }
 
-function initWasm(wasmFactory: any, wasmData: Uint8Array): Promise<any> {
+/** Installs an instantiated module, wasm or the Node addon, as Fixed64Module */
+export function initFixed64Module(module: any, backend: Fixed64Backend): any {
+    Fixed64Module = module;
+    fixed64Backend = backend;
+    Fixed64Exports = bindEntryPoints(Fixed64Module);
+    fixed64InteropReady = false;
+    boundFixed64Context = 0;
+    fixed64FixedHeapSize = module.getFixedHeapSize?.() ?? 0;
+    heapViews = createHeapViews();
+    return Fixed64Module;
+}
+
+/**
+ * Views over the whole heap. With a fixed heap (fixed64FixedHeapSize) they are created once and never detach, so
+ * callers may keep them and views derived from them. Otherwise they are recreated whenever the heap has grown.
+ */
+export function fixed64Heap(): Fixed64HeapViews {
+    if (fixed64FixedHeapSize === 0 && heapViews.u8.buffer !== Fixed64Module.HEAPU8.buffer) {
+        heapViews = createHeapViews();
+    }
+    return heapViews;
+}
+
+function createHeapViews(): Fixed64HeapViews {
+    return { u8: Fixed64Module.HEAPU8, i32: Fixed64Module.HEAP32, u32: Fixed64Module.HEAPU32, f64: Fixed64Module.HEAPF64 };
+}
+
+/**
+ * Reads the interop addresses and the Fixed64Param layout. The first call of each getter costs far more than later
+ * ones, so loading leaves this to the first Fixed64 call that goes through the interop arrays.
+ */
+export function initFixed64Interop(): void {
+    interopParamArrayAddress = Fixed64Module.getInteropParamArrayAddress();
+    interopParamUint32ArrayAddress = Fixed64Module.getInteropUint32ParamArrayAddress();
+    interopReturnArrayAddress = Fixed64Module.getInteropReturnArrayAddress();
+    interopReturnUint32ArrayAddress = Fixed64Module.getInteropReturnUint32ArrayAddress();
+    interopCharArrayAddress = Fixed64Module.getInteropCharArrayAddress();
+    sizeOfFixed64Param = Fixed64Module.getSizeOfFixed64Param();
+    fixed64ParamOffsets = Fixed64Module.getFixed64ParamOffsets();
+    defaultContextAddress = Fixed64Exports.SimContext.current();
+    interopOffsets = [
+        interopParamArrayAddress,
+        interopParamUint32ArrayAddress,
+        interopReturnArrayAddress,
+        interopReturnUint32ArrayAddress,
+        interopCharArrayAddress,
+    ].map(address => address - defaultContextAddress);
+    fixed64InteropReady = true;
+}
+
+/**
+ * Binds a SimContext created by Fixed64.createContext() (0 for the default one) and points the
+ * interop addresses at its arrays. Every later call runs against that context until the next bind.
+ */
+export function bindFixed64Context(context: number): void {
+    if (!fixed64InteropReady) {
+        initFixed64Interop();
+    }
+    Fixed64Exports.SimContext.bind(context);
+    boundFixed64Context = context;
+    const base = context || defaultContextAddress;
+    [
+        interopParamArrayAddress,
+        interopParamUint32ArrayAddress,
+        interopReturnArrayAddress,
+        interopReturnUint32ArrayAddress,
+        interopCharArrayAddress,
+    ] = interopOffsets.map(offset => base + offset);
+}
+
+function initWasm(wasmFactory: any, wasmData: Uint8Array | WebAssembly.Module, initialMemory: number): Promise<any> {
     return new Promise<any>((resolve, reject) => {
         wasmFactory({
             instantiateWasm(importObject: WebAssembly.Imports, receiveInstance: (instance: WebAssembly.Instance, module: WebAssembly.Module) => void) {
-                WebAssembly.instantiate(wasmData, importObject).then((result: any) => {
-                    receiveInstance(result.instance, result.module);
+                instantiate(wasmData, importObject).then(({ instance, module }) => {
+                    fixed64WasmModule = module;
+                    // Before the runtime creates its heap views, so they cover the reserved memory
+                    reserveMemory(instance, importObject, initialMemory);
+                    receiveInstance(instance, module);
                 }).catch(reject);
             }
         }).then(resolve).catch(reject);
     });
 }
+
+function reserveMemory(instance: WebAssembly.Instance, importObject: WebAssembly.Imports, bytes: number): void {
+    if (bytes <= 0) {
+        return;
+    }
+    // Export names are minified in release builds, and pthread builds import their memory instead
+    const isMemory = (value: unknown) => value instanceof WebAssembly.Memory;
+    const memory = (Object.values(instance.exports).find(isMemory) ?? Object.values(importObject.env ?? {}).find(isMemory)) as WebAssembly.Memory;
+    const pages = Math.ceil(bytes / 65536) - memory.buffer.byteLength / 65536;
+    if (pages > 0) {
+        try {
+            memory.grow(pages);
+        } catch (error) {
+            throw new Error(`initialMemory: cannot reserve ${bytes} bytes (${(error as Error).message})`);
+        }
+    }
+}
+
+async function instantiate(wasmData: Uint8Array | WebAssembly.Module, importObject: WebAssembly.Imports): Promise<WebAssembly.WebAssemblyInstantiatedSource> {
+    if (wasmData instanceof WebAssembly.Module) {
+        return { instance: await WebAssembly.instantiate(wasmData, importObject), module: wasmData };
+    }
+    return WebAssembly.instantiate(wasmData, importObject);
+}
+
+function bindEntryPoints(module: any): Fixed64EntryPoints {
+    if (!module._fixed64_export_table || !module.wasmTable) {
+        return bindFixed64Embind(module);
+    }
+    const table = module._fixed64_export_table() >> 2;
+    const indices = module.HEAPU32.slice(table, table + module._fixed64_export_count());
+    return bindFixed64Exports(module, module.wasmTable, indices);
+}